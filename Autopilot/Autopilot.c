@@ -0,0 +1,111 @@
+#include <stdlib.h>
+#include <math.h>
+#include "Autopilot.h"
+#include "../Utils/ErrorHandler/ErrorHandler.h"
+#include "../Utils/Assert/Assert.h"
+
+/**
+ * Creates an autopilot for mazes of the given size.
+ *
+ * @param mapSize the side length of the square map grid
+ * @return the autopilot
+ */
+Autopilot* CreateAutopilot(int mapSize)
+{
+	Autopilot* autopilot = (Autopilot*)calloc(1, sizeof(Autopilot));
+	if (autopilot == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	autopilot->solver = CreateMazeSolver(mapSize);
+	return autopilot;
+}
+
+/**
+ * Frees the memory allocated for the given autopilot.
+ *
+ * @param autopilot the given autopilot
+ */
+void DestroyAutopilot(Autopilot* autopilot)
+{
+	if (autopilot == NULL)
+	{return;}
+	DestroyMazeSolver(autopilot->solver);
+	free(autopilot);
+}
+
+/**
+ * Checks if the path found by the autopilot still leads the player to the goal: the maze has not changed and the
+ * player is in the cell of the current or the previous waypoint.
+ *
+ * @param autopilot  the autopilot
+ * @param map 		 the map the player is in
+ * @param playerCell the index of the cell the player is in
+ * @return 1 if the path can still be followed, 0 otherwise
+ */
+static int IsOnAutopilotPath(const Autopilot* autopilot, const Map* map, int playerCell)
+{
+	const MazeSolver* solver = autopilot->solver;
+	if (autopilot->nextWaypoint == 0 || autopilot->mapSeed != map->seed)
+	{return 0;}
+	return solver->path[autopilot->nextWaypoint] == playerCell || solver->path[autopilot->nextWaypoint - 1] == playerCell;
+}
+
+/**
+ * Gets the input that walks the player one frame further along the shortest path to the goal of the maze.
+ *
+ * @param autopilot the autopilot
+ * @param map 		the map the player is in
+ * @param player 	the player
+ * @return the movements requested for this frame, no movement once the goal is reached
+ */
+PlayerInput SteerAutopilot(Autopilot* autopilot, const Map* map, const Player* player)
+{
+	RCM_ASSERT_NOT_NULL(autopilot);
+	RCM_ASSERT_NOT_NULL(map);
+	RCM_ASSERT_NOT_NULL(player);
+	RCM_ASSERT(map->size == autopilot->solver->mazeSize, INVALID_CONFIGURATION_ERROR);
+	PlayerInput input = {0, 0, 0, 0, 0.0f};
+	const MazeSolver* solver = autopilot->solver;
+	int playerCell = GetPlayerCellIndex(&player->position, map->cellSize, map->size);
+	int goalCell = GetMapGoalCellIndex(map);
+	if (playerCell == goalCell)
+	{return input;}
+	// Finds the path again from the cell the player is in when the player left the path or the maze changed. The goal
+	// distance field of the map gives the path without a search.
+	if (!IsOnAutopilotPath(autopilot, map, playerCell))
+	{
+		int pathLength = map->goalDistances != NULL ? FollowDistanceField(autopilot->solver, map->goalDistances,
+				playerCell) : SolveMaze(autopilot->solver, map->cells, WALL, playerCell, goalCell);
+		if (pathLength < 2)
+		{
+			autopilot->nextWaypoint = 0;
+			return input;
+		}
+		autopilot->mapSeed = map->seed;
+		autopilot->nextWaypoint = 1;
+	}
+	// Targets the next waypoint once the player is close to the center of the current one, the last waypoint is the
+	// goal, which is never reached here
+	int waypoint = solver->path[autopilot->nextWaypoint];
+	float targetX = ((float)(waypoint % map->size) + 0.5f) * map->cellSize;
+	float targetY = ((float)(waypoint / map->size) + 0.5f) * map->cellSize;
+	float dx = targetX - player->position.x;
+	float dy = targetY - player->position.y;
+	float arrivalRadius = AUTOPILOT_ARRIVAL_RADIUS * map->cellSize;
+	if (dx * dx + dy * dy < arrivalRadius * arrivalRadius && autopilot->nextWaypoint + 1 < solver->pathLength)
+	{
+		waypoint = solver->path[++autopilot->nextWaypoint];
+		targetX = ((float)(waypoint % map->size) + 0.5f) * map->cellSize;
+		targetY = ((float)(waypoint / map->size) + 0.5f) * map->cellSize;
+		dx = targetX - player->position.x;
+		dy = targetY - player->position.y;
+	}
+	// Signed angle from the player's direction to the waypoint, positive angles are clockwise on screen
+	float angle = atan2f(player->direction.x * dy - player->direction.y * dx,
+			player->direction.x * dx + player->direction.y * dy);
+	if (angle > 0.5f * PLAYER_TURNING_ANGLE)
+	{input.isTurningClockwise = 1;}
+	else if (angle < -0.5f * PLAYER_TURNING_ANGLE)
+	{input.isTurningCounterClockwise = 1;}
+	input.isMovingForward = fabsf(angle) < AUTOPILOT_MAX_MOVING_ANGLE;
+	return input;
+}
@@ -0,0 +1,50 @@
+#ifndef RAY_CASTING_MAZE_AUTOPILOT_H_
+#define RAY_CASTING_MAZE_AUTOPILOT_H_
+
+#define AUTOPILOT_ARRIVAL_RADIUS 0.2f    // distance to a waypoint, in cells, at which the next waypoint is targeted
+#define AUTOPILOT_MAX_MOVING_ANGLE 0.3f  // largest angle to the waypoint in radians at which the player moves forward
+
+#include <stdint.h>
+#include "../Map/Map.h"
+#include "../Player/Player.h"
+#include "../Utils/MazeSolver/MazeSolver.h"
+
+/**
+ * Struct for a bot walking the player to the goal of the maze. It finds the shortest path through the maze, then
+ * produces the same input a human player would, turning towards the center of the next cell on the path and moving
+ * forward once facing it. The path is found again whenever the player leaves it or the maze changes, so the bot can be
+ * switched on at any point of a game and keeps playing across successive mazes of the same size.
+ */
+typedef struct Autopilot_struct
+{
+	MazeSolver* solver; // path finder, its path holds the cells from the cell the path was found in to the goal
+	uint32_t mapSeed;   // seed of the maze the path was found in
+	int nextWaypoint;   // index of the cell on the path the player is walking to, 0 if no path has been found
+} Autopilot;
+
+/**
+ * Creates an autopilot for mazes of the given size.
+ *
+ * @param mapSize the side length of the square map grid
+ * @return the autopilot
+ */
+Autopilot* CreateAutopilot(int mapSize);
+
+/**
+ * Frees the memory allocated for the given autopilot.
+ *
+ * @param autopilot the given autopilot
+ */
+void DestroyAutopilot(Autopilot* autopilot);
+
+/**
+ * Gets the input that walks the player one frame further along the shortest path to the goal of the maze.
+ *
+ * @param autopilot the autopilot
+ * @param map 		the map the player is in
+ * @param player 	the player
+ * @return the movements requested for this frame, no movement once the goal is reached
+ */
+PlayerInput SteerAutopilot(Autopilot* autopilot, const Map* map, const Player* player);
+
+#endif
@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL.h>
+#include "BatchRender.h"
+#include "../Utils/ImageWriter/ImageWriter.h"
+#include "../Utils/ErrorHandler/ErrorHandler.h"
+#include "../Utils/Assert/Assert.h"
+
+/**
+ * Struct for the images of one batch, written in parallel by WriteBatchImages().
+ */
+typedef struct BatchImages_struct
+{
+	Camera* cameras[BATCH_RENDER_POSES_PER_BATCH]; // cameras holding the rendered frames
+	int firstFrame;                                // index of the pose rendered by the first camera
+	const char* outputDirectory;
+	int format;
+	int isWritten[BATCH_RENDER_POSES_PER_BATCH];   // 1 if the image of each camera was written
+} BatchImages;
+
+/**
+ * Reads a pose file. Each line holds "x y angle", with the position in cells and the angle in degrees. Blank lines and
+ * lines starting with '#' are ignored. A line that can not be parsed stops the program.
+ *
+ * @param path the path of the pose file
+ * @return the poses, or NULL if the file could not be opened
+ */
+PoseList* LoadPoseFile(const char* path)
+{
+	RCM_ASSERT_NOT_NULL(path);
+	FILE* file = fopen(path, "r");
+	if (file == NULL)
+	{return NULL;}
+	PoseList* poseList = (PoseList*)calloc(1, sizeof(PoseList));
+	if (poseList == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	char line[CONFIG_MAX_LINE_LENGTH];
+	int lineNumber = 0;
+	while (fgets(line, sizeof(line), file) != NULL)
+	{
+		++lineNumber;
+		const char* text = line;
+		while (*text == ' ' || *text == '\t')
+		{++text;}
+		if (*text == '#' || *text == '\n' || *text == '\r' || *text == '\0')
+		{continue;}
+		Pose pose;
+		char rest;
+		if (sscanf(text, "%f %f %f %c", &pose.x, &pose.y, &pose.angle, &rest) != 3)
+		{
+			printf("%s:%d: expected \"x y angle\".\n", path, lineNumber);
+			ErrorHandler(INVALID_CONFIGURATION_ERROR);
+		}
+		pose.angle = pose.angle * (float)M_PI / 180.0f;
+		// Grows the pose array by doubling its capacity
+		if (poseList->length == poseList->capacity)
+		{
+			int capacity = poseList->capacity == 0 ? 64 : poseList->capacity * 2;
+			Pose* poses = (Pose*)realloc(poseList->poses, (size_t)capacity * sizeof(Pose));
+			if (poses == NULL)
+			{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+			poseList->poses = poses;
+			poseList->capacity = capacity;
+		}
+		poseList->poses[poseList->length++] = pose;
+	}
+	fclose(file);
+	return poseList;
+}
+
+/**
+ * Frees the memory allocated for the given pose list.
+ *
+ * @param poseList the given pose list
+ */
+void DestroyPoseList(PoseList* poseList)
+{
+	if (poseList == NULL)
+	{return;}
+	free(poseList->poses);
+	free(poseList);
+}
+
+/**
+ * Worker pool task writing the images of the cameras [begin, end) of a batch.
+ *
+ * @param begin 	  the first camera
+ * @param end 		  one past the last camera
+ * @param batchImages the batch
+ */
+static void WriteBatchImages(int begin, int end, void* batchImages)
+{
+	BatchImages* batch = (BatchImages*)batchImages;
+	for (int i = begin; i < end; ++i)
+	{
+		char path[BATCH_RENDER_MAX_PATH_LENGTH];
+		snprintf(path, sizeof(path), "%s/frame_%05d.%s", batch->outputDirectory, batch->firstFrame + i,
+				batch->format == BATCH_RENDER_FORMAT_BMP ? "bmp" : "ppm");
+		if (batch->format == BATCH_RENDER_FORMAT_BMP)
+		{batch->isWritten[i] = WriteFrameBufferBMP(batch->cameras[i]->frameBuffer, path);}
+		else
+		{batch->isWritten[i] = WriteFrameBufferPPM(batch->cameras[i]->frameBuffer, path);}
+	}
+}
+
+/**
+ * Renders the first-person view of each pose from the maze of the engine and writes it to
+ * "<outputDirectory>/frame_<index>.<ppm|bmp>". Poses are rendered in batches of BATCH_RENDER_POSES_PER_BATCH cameras,
+ * whose columns and rows are split between the worker threads together, and the images of a batch are written in
+ * parallel. The player camera is disabled. Prints the throughput in frames per second.
+ *
+ * @param engine 		  the engine, its cameras beyond the player camera are added by this function
+ * @param poseList 		  the poses
+ * @param outputDirectory the existing directory the images are written to
+ * @param format 		  BATCH_RENDER_FORMAT_PPM or BATCH_RENDER_FORMAT_BMP
+ * @return the number of images that could not be written
+ */
+int RenderPoses(Engine* engine, const PoseList* poseList, const char* outputDirectory, int format)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	RCM_ASSERT_NOT_NULL(poseList);
+	RCM_ASSERT_NOT_NULL(outputDirectory);
+	RCM_ASSERT(engine->numCameras == 1, INVALID_CONFIGURATION_ERROR);
+	const Map* map = &engine->map;
+	engine->cameras[ENGINE_PLAYER_CAMERA]->isEnabled = 0;
+	BatchImages batch;
+	batch.outputDirectory = outputDirectory;
+	batch.format = format;
+	Viewport fullWindow = {0.0f, 0.0f, 1.0f, 1.0f};
+	for (int i = 0; i < BATCH_RENDER_POSES_PER_BATCH; ++i)
+	{batch.cameras[i] = AddEngineCamera(engine, fullWindow);}
+
+	int numFailed = 0;
+	Uint64 renderTicks = 0;
+	Uint64 start = SDL_GetPerformanceCounter();
+	for (int first = 0; first < poseList->length; first += BATCH_RENDER_POSES_PER_BATCH)
+	{
+		int batchSize = poseList->length - first < BATCH_RENDER_POSES_PER_BATCH ?
+				poseList->length - first : BATCH_RENDER_POSES_PER_BATCH;
+		for (int i = 0; i < BATCH_RENDER_POSES_PER_BATCH; ++i)
+		{
+			Camera* camera = batch.cameras[i];
+			camera->isEnabled = i < batchSize;
+			if (!camera->isEnabled)
+			{continue;}
+			const Pose* pose = &poseList->poses[first + i];
+			camera->position = V3(pose->x * map->cellSize, pose->y * map->cellSize, 0.0f);
+			camera->direction = V3(cosf(pose->angle), sinf(pose->angle), 0.0f);
+		}
+		Uint64 renderStart = SDL_GetPerformanceCounter();
+		RenderEngineFrame(engine);
+		renderTicks += SDL_GetPerformanceCounter() - renderStart;
+		// Each image is written by one thread
+		batch.firstFrame = first;
+		RunParallelFor(engine->workerPool, batchSize, 1, WriteBatchImages, &batch);
+		for (int i = 0; i < batchSize; ++i)
+		{
+			if (!batch.isWritten[i])
+			{++numFailed;}
+		}
+	}
+	double totalSeconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+	double renderSeconds = (double)renderTicks / (double)SDL_GetPerformanceFrequency();
+
+	const FrameBuffer* frameBuffer = batch.cameras[0]->frameBuffer;
+	printf("Rendered %d frames at %dx%d\n", poseList->length, frameBuffer->width, frameBuffer->height);
+	if (poseList->length > 0)
+	{
+		printf("rendering only:      %10.3f ms %10.1f frames/s\n", renderSeconds * 1000.0,
+				(double)poseList->length / renderSeconds);
+		printf("rendering + writing: %10.3f ms %10.1f frames/s\n", totalSeconds * 1000.0,
+				(double)poseList->length / totalSeconds);
+	}
+	if (numFailed > 0)
+	{printf("%d images could not be written to %s.\n", numFailed, outputDirectory);}
+	return numFailed;
+}
@@ -0,0 +1,61 @@
+#ifndef RAY_CASTING_MAZE_BATCHRENDER_H_
+#define RAY_CASTING_MAZE_BATCHRENDER_H_
+
+#define BATCH_RENDER_POSES_PER_BATCH (ENGINE_MAX_CAMERAS - 1) // poses rendered together, one camera each
+#define BATCH_RENDER_MAX_PATH_LENGTH 1024                   // maximum length of an output image path
+#define BATCH_RENDER_FORMAT_PPM 0                           // write binary PPM images
+#define BATCH_RENDER_FORMAT_BMP 1                           // write 24-bit BMP images
+
+#include "../Engine/Engine.h"
+
+/**
+ * Struct for a camera pose read from a pose file.
+ */
+typedef struct Pose_struct
+{
+	float x;     // x coordinate in cells, 0.5 is the center of the leftmost column of cells
+	float y;     // y coordinate in cells, 0.5 is the center of the top row of cells
+	float angle; // viewing direction in radians, 0 faces right and angles grow clockwise on screen
+} Pose;
+
+/**
+ * Struct for the poses of a pose file, in file order.
+ */
+typedef struct PoseList_struct
+{
+	int length;
+	int capacity;
+	Pose* poses;
+} PoseList;
+
+/**
+ * Reads a pose file. Each line holds "x y angle", with the position in cells and the angle in degrees. Blank lines and
+ * lines starting with '#' are ignored. A line that can not be parsed stops the program.
+ *
+ * @param path the path of the pose file
+ * @return the poses, or NULL if the file could not be opened
+ */
+PoseList* LoadPoseFile(const char* path);
+
+/**
+ * Frees the memory allocated for the given pose list.
+ *
+ * @param poseList the given pose list
+ */
+void DestroyPoseList(PoseList* poseList);
+
+/**
+ * Renders the first-person view of each pose from the maze of the engine and writes it to
+ * "<outputDirectory>/frame_<index>.<ppm|bmp>". Poses are rendered in batches of BATCH_RENDER_POSES_PER_BATCH cameras,
+ * whose columns and rows are split between the worker threads together, and the images of a batch are written in
+ * parallel. The player camera is disabled. Prints the throughput in frames per second.
+ *
+ * @param engine 		  the engine, its cameras beyond the player camera are added by this function
+ * @param poseList 		  the poses
+ * @param outputDirectory the existing directory the images are written to
+ * @param format 		  BATCH_RENDER_FORMAT_PPM or BATCH_RENDER_FORMAT_BMP
+ * @return the number of images that could not be written
+ */
+int RenderPoses(Engine* engine, const PoseList* poseList, const char* outputDirectory, int format);
+
+#endif
@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <string.h>
+#include "BatchRender.h"
+#include "../Utils/ErrorHandler/ErrorHandler.h"
+
+/**
+ * Renders first-person frames from a list of poses without a window and writes them as images.
+ *
+ * Usage: rayCastingMazeRender POSE_FILE OUTPUT_DIRECTORY [ppm|bmp] [configuration options]
+ *
+ * The window size and render scale of the configuration set the image size, the maze size and field of view apply as
+ * in the game. Dynamic resolution is not used.
+ *
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
+ * @return 0 if all images were written, 1 otherwise
+ */
+int main(int argc, char* argv[])
+{
+	const char* const wallTexturePaths[] = {"Assets/Textures/wall0.bmp", "Assets/Textures/wall1.bmp",
+											"Assets/Textures/wall2.bmp", "Assets/Textures/wall3.bmp"};
+	if (argc < 3)
+	{
+		printf("Usage: %s POSE_FILE OUTPUT_DIRECTORY [ppm|bmp] [configuration options]\n", argv[0]);
+		return 1;
+	}
+	const char* poseFilePath = argv[1];
+	const char* outputDirectory = argv[2];
+	int format = BATCH_RENDER_FORMAT_PPM;
+	// The configuration loader treats its first argument as the program name
+	int configArgumentIndex = 2;
+	if (argc > 3 && strncmp(argv[3], "--", 2) != 0)
+	{
+		if (strcmp(argv[3], "bmp") == 0)
+		{format = BATCH_RENDER_FORMAT_BMP;}
+		else if (strcmp(argv[3], "ppm") != 0)
+		{
+			printf("Unknown image format %s, expected ppm or bmp.\n", argv[3]);
+			return 1;
+		}
+		configArgumentIndex = 3;
+	}
+	Config config;
+	LoadConfig(&config, argc - configArgumentIndex, argv + configArgumentIndex);
+	PoseList* poseList = LoadPoseFile(poseFilePath);
+	if (poseList == NULL)
+	{
+		printf("Pose file %s could not be opened.\n", poseFilePath);
+		return 1;
+	}
+
+	WorkerPool* pool = CreateWorkerPool(SDL_GetCPUCount() - 1);
+	TextureAtlas* atlas = LoadTextureAtlas(wallTexturePaths, 4);
+	Engine* engine = CreateEngine(&config, atlas, pool);
+	int numFailed = RenderPoses(engine, poseList, outputDirectory, format);
+
+	DestroyEngine(engine);
+	DestroyTextureAtlas(atlas);
+	DestroyWorkerPool(pool);
+	DestroyPoseList(poseList);
+	return numFailed > 0;
+}
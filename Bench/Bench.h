@@ -0,0 +1,98 @@
+#ifndef RAY_CASTING_MAZE_BENCH_H_
+#define RAY_CASTING_MAZE_BENCH_H_
+
+#define BENCH_MAZE_SEED 1 // maze seed used when none is configured, so that runs are comparable
+
+#include <SDL.h>
+
+/**
+ * Gets the current time from the high resolution counter.
+ *
+ * @return the counter value
+ */
+Uint64 BenchStart(void);
+
+/**
+ * Gets the time elapsed since a counter value.
+ *
+ * @param start the counter value returned by BenchStart()
+ * @return the elapsed time in milliseconds
+ */
+double BenchElapsedMs(Uint64 start);
+
+/**
+ * Prints one benchmark result as the total time and the time per iteration.
+ *
+ * @param name 		 the name of the benchmark
+ * @param elapsedMs  the total elapsed time in milliseconds
+ * @param iterations the number of iterations measured
+ */
+void PrintBenchResult(const char* name, double elapsedMs, long iterations);
+
+/**
+ * Compares the heap-allocated pointer Vec3 API against the inline value API.
+ *
+ * @param iterations the number of iterations of each benchmark
+ */
+void RunVecBench(long iterations);
+
+/**
+ * Compares casting a frame of rays through the allocating CalculateIntersections() against CastRays() writing into a
+ * reused array, and measures the cost of gathering the cells the rays pass through into a visibility set.
+ *
+ * @param argc the number of command line arguments, forwarded to LoadConfig()
+ * @param argv the command line arguments, forwarded to LoadConfig()
+ */
+void RunCastBench(int argc, char* argv[]);
+
+/**
+ * Renders first-person frames headless and reports the time per frame. This is also the training workload for
+ * profile-guided optimization builds.
+ *
+ * @param argc the number of command line arguments, forwarded to LoadConfig()
+ * @param argv the command line arguments, forwarded to LoadConfig()
+ */
+void RunFrameBench(int argc, char* argv[]);
+
+/**
+ * Replays a recorded input log without a window, rendering every tick, and reports the time per frame and the final
+ * game state. The maze seed, maze size, step and field of view are taken from the log, so the session is reproduced
+ * exactly.
+ *
+ * @param argc the number of command line arguments, the first one is the path of the input log, the others are
+ * 			   forwarded to LoadConfig()
+ * @param argv the command line arguments
+ */
+void RunReplayBench(int argc, char* argv[]);
+
+/**
+ * Lets the autopilot play through successive mazes without a window, rendering every tick, and reports the time per
+ * frame of each maze and the frame time percentiles of the whole run.
+ *
+ * @param argc the number of command line arguments, the first one may be the number of mazes, the others are forwarded
+ * 			   to LoadConfig()
+ * @param argv the command line arguments
+ */
+void RunSoakBench(int argc, char* argv[]);
+
+/**
+ * Generates one large maze and reports the time taken by the maze generation and by each distance field, calculated
+ * in full and updated after single cell changes.
+ *
+ * @param argc the number of command line arguments, the first one may be the side length of the maze
+ * @param argv the command line arguments
+ */
+void RunFieldBench(int argc, char* argv[]);
+
+/**
+ * Plays the same frames with the autopilot with rendering and submission run one after the other and overlapped on a
+ * separate render thread, and reports the throughput and the latency from reading the input to the end of the
+ * submission of both modes.
+ *
+ * @param argc the number of command line arguments, the first one may be the submission wait in milliseconds, the
+ * 			   others are forwarded to LoadConfig()
+ * @param argv the command line arguments
+ */
+void RunPipelineBench(int argc, char* argv[]);
+
+#endif
@@ -0,0 +1,67 @@
+#include <string.h>
+#include "Bench.h"
+
+/**
+ * Gets the current time from the high resolution counter.
+ *
+ * @return the counter value
+ */
+Uint64 BenchStart(void)
+{
+	return SDL_GetPerformanceCounter();
+}
+
+/**
+ * Gets the time elapsed since a counter value.
+ *
+ * @param start the counter value returned by BenchStart()
+ * @return the elapsed time in milliseconds
+ */
+double BenchElapsedMs(Uint64 start)
+{
+	return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+/**
+ * Prints one benchmark result as the total time and the time per iteration.
+ *
+ * @param name 		 the name of the benchmark
+ * @param elapsedMs  the total elapsed time in milliseconds
+ * @param iterations the number of iterations measured
+ */
+void PrintBenchResult(const char* name, double elapsedMs, long iterations)
+{
+	printf("%-40s %10.3f ms %10.3f ns/iteration\n", name, elapsedMs, elapsedMs * 1e6 / (double)iterations);
+}
+
+/**
+ * Runs the benchmarks. The first argument selects the benchmark: "vec" for the vector API, "cast" for ray casting,
+ * "frame" for headless frame rendering, or nothing for all of them. Remaining arguments are forwarded to the
+ * configuration loader for "cast" and "frame". "replay" followed by the path of an input log replays a recorded
+ * session, "soak" followed by an optional number of mazes lets the autopilot play through successive mazes and "fields"
+ * followed by an optional maze size times the distance fields of a large maze and "pipeline" followed by an optional
+ * present wait compares sequential and pipelined frames, they are not part of running all benchmarks.
+ *
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
+ * @return 0
+ */
+int main(int argc, char* argv[])
+{
+	const char* benchmark = argc > 1 ? argv[1] : "all";
+	if (strcmp(benchmark, "vec") == 0 || strcmp(benchmark, "all") == 0)
+	{RunVecBench(10000000L);}
+	if (strcmp(benchmark, "cast") == 0 || strcmp(benchmark, "all") == 0)
+	{RunCastBench(argc > 1 ? argc - 1 : argc, argc > 1 ? argv + 1 : argv);}
+	if (strcmp(benchmark, "frame") == 0 || strcmp(benchmark, "all") == 0)
+	{RunFrameBench(argc > 1 ? argc - 1 : argc, argc > 1 ? argv + 1 : argv);}
+	if (strcmp(benchmark, "replay") == 0)
+	{RunReplayBench(argc - 1, argv + 1);}
+	if (strcmp(benchmark, "soak") == 0)
+	{RunSoakBench(argc - 1, argv + 1);}
+	if (strcmp(benchmark, "fields") == 0)
+	{RunFieldBench(argc - 1, argv + 1);}
+	if (strcmp(benchmark, "pipeline") == 0)
+	{RunPipelineBench(argc - 1, argv + 1);}
+	return 0;
+}
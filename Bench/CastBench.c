@@ -0,0 +1,108 @@
+#include <stdlib.h>
+#include "Bench.h"
+#include "../Engine/Engine.h"
+#include "../Utils/RayCaster/RayCaster.h"
+#include "../Utils/VisibilitySet/VisibilitySet.h"
+#include "../Utils/DistanceField/DistanceField.h"
+#include "../Utils/Config/Config.h"
+#include "../Utils/ErrorHandler/ErrorHandler.h"
+
+#define CAST_BENCH_FRAMES 500 // number of frames of rays cast by each benchmark
+
+/**
+ * Compares casting a frame of rays through the allocating CalculateIntersections() against CastRays() writing into a
+ * reused array, stepping one cell at a time and skipping empty space with the wall distance field. The cost of listing
+ * the cells each ray passes through, and of gathering them into a visibility set, is measured on top of CastRays().
+ * The player stands at the center of the top-left cell and turns a little every frame.
+ *
+ * @param argc the number of command line arguments, forwarded to LoadConfig()
+ * @param argv the command line arguments, forwarded to LoadConfig()
+ */
+void RunCastBench(int argc, char* argv[])
+{
+	Config config;
+	LoadConfig(&config, argc, argv);
+	if (config.seed == 0)
+	{config.seed = BENCH_MAZE_SEED;}
+	Map map;
+	CreateMap(&map, config.mazeSize, ENGINE_MAP_CELL_SIZE, (uint32_t)config.seed);
+	// The game does not keep the wall distances, they are calculated here to measure what skipping empty space gains
+	unsigned char* wallDistances = (unsigned char*)calloc((size_t)map.size * map.size, sizeof(unsigned char));
+	if (wallDistances == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	CalculateWallDistances(map.cells, EMPTY, map.size, wallDistances, NULL);
+	int numRays = config.numRays > 0 ? config.numRays : (int)((float)config.windowWidth * config.renderScale);
+	Vec3 position = V3(map.cellSize * 1.5f, map.cellSize * 1.5f, 0.0f);
+	Vec3* rays = (Vec3*)calloc(numRays, sizeof(Vec3));
+	int* crossedCells = (int*)calloc((size_t)numRays * RAY_MAX_CROSSED_CELLS, sizeof(int));
+	int* numCrossedCells = (int*)calloc(numRays, sizeof(int));
+	if (rays == NULL || crossedCells == NULL || numCrossedCells == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	VisibilitySet* visibleCells = CreateVisibilitySet(map.size * map.size);
+
+	printf("Ray casting, %d frames of %d rays, %dx%d maze\n", CAST_BENCH_FRAMES, numRays, map.size, map.size);
+	Vec3 direction = V3(1.0f, 0.0f, 0.0f);
+	Uint64 start = BenchStart();
+	for (int i = 0; i < CAST_BENCH_FRAMES; ++i)
+	{
+		Vec3* intersections = CalculateIntersections(&position, &direction, map.cellSize, map.cells, map.size,
+				config.fieldOfView, numRays, RAY_UNLIMITED_LENGTH);
+		free(intersections);
+		direction = V3Rotate(direction, 0.01f);
+	}
+	PrintBenchResult("frame: CalculateIntersections", BenchElapsedMs(start), CAST_BENCH_FRAMES);
+
+	direction = V3(1.0f, 0.0f, 0.0f);
+	start = BenchStart();
+	for (int i = 0; i < CAST_BENCH_FRAMES; ++i)
+	{
+		CastRays(V3XY(position), V3XY(direction), map.cellSize, map.cells, map.size, NULL, config.fieldOfView,
+				numRays, RAY_UNLIMITED_LENGTH, rays, NULL, NULL);
+		direction = V3Rotate(direction, 0.01f);
+	}
+	PrintBenchResult("frame: CastRays", BenchElapsedMs(start), CAST_BENCH_FRAMES);
+
+	direction = V3(1.0f, 0.0f, 0.0f);
+	start = BenchStart();
+	for (int i = 0; i < CAST_BENCH_FRAMES; ++i)
+	{
+		CastRays(V3XY(position), V3XY(direction), map.cellSize, map.cells, map.size, wallDistances,
+				config.fieldOfView, numRays, RAY_UNLIMITED_LENGTH, rays, NULL, NULL);
+		direction = V3Rotate(direction, 0.01f);
+	}
+	PrintBenchResult("frame: CastRays, wall distance field", BenchElapsedMs(start), CAST_BENCH_FRAMES);
+
+	direction = V3(1.0f, 0.0f, 0.0f);
+	start = BenchStart();
+	for (int i = 0; i < CAST_BENCH_FRAMES; ++i)
+	{
+		CastRays(V3XY(position), V3XY(direction), map.cellSize, map.cells, map.size, NULL, config.fieldOfView,
+				numRays, RAY_UNLIMITED_LENGTH, rays, crossedCells, numCrossedCells);
+		direction = V3Rotate(direction, 0.01f);
+	}
+	PrintBenchResult("frame: CastRays, crossed cells", BenchElapsedMs(start), CAST_BENCH_FRAMES);
+
+	direction = V3(1.0f, 0.0f, 0.0f);
+	start = BenchStart();
+	for (int i = 0; i < CAST_BENCH_FRAMES; ++i)
+	{
+		CastRays(V3XY(position), V3XY(direction), map.cellSize, map.cells, map.size, NULL, config.fieldOfView,
+				numRays, RAY_UNLIMITED_LENGTH, rays, crossedCells, numCrossedCells);
+		ClearVisibilitySet(visibleCells);
+		for (int j = 0; j < numRays; ++j)
+		{
+			for (int k = 0; k < numCrossedCells[j]; ++k)
+			{AddVisibleCell(visibleCells, crossedCells[j * RAY_MAX_CROSSED_CELLS + k]);}
+		}
+		direction = V3Rotate(direction, 0.01f);
+	}
+	PrintBenchResult("frame: CastRays, visibility set", BenchElapsedMs(start), CAST_BENCH_FRAMES);
+	printf("visible cells in the last frame: %d\n", visibleCells->numVisible);
+
+	DestroyVisibilitySet(visibleCells);
+	free(crossedCells);
+	free(numCrossedCells);
+	free(rays);
+	free(wallDistances);
+	DestroyMap(&map);
+}
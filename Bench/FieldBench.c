@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Bench.h"
+#include "../Map/Map.h"
+#include "../Engine/Engine.h"
+#include "../Utils/DistanceField/DistanceField.h"
+#include "../Utils/WorkerPool/WorkerPool.h"
+#include "../Utils/Random/Random.h"
+#include "../Utils/BitSet/BitSet.h"
+#include "../Utils/ErrorHandler/ErrorHandler.h"
+
+#define FIELD_BENCH_DEFAULT_SIZE 4001 // side length of the maze when none is given
+#define FIELD_BENCH_TOGGLED_CELLS 1000 // number of open cells turned into walls and back to measure the updates
+
+/**
+ * Checks the state SetMapCell() keeps up to date against the cells of the map: the open and visited cell counters of
+ * the map and of each region, the wall rectangle of each cell and the goal distances, which are calculated again.
+ *
+ * @param map the map
+ * @return 1 if everything matches, 0 otherwise
+ */
+static int CheckMapCellState(const Map* map)
+{
+	const int size = map->size;
+	const int numCells = size * size;
+	const int numRegions = map->numRegionsPerSide * map->numRegionsPerSide;
+	int* regionOpenCells = (int*)calloc(numRegions, sizeof(int));
+	int* regionVisitedCells = (int*)calloc(numRegions, sizeof(int));
+	int* goalDistances = (int*)calloc(numCells, sizeof(int));
+	if (regionOpenCells == NULL || regionVisitedCells == NULL || goalDistances == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	int numOpenCells = 0;
+	int numVisitedCells = 0;
+	int numWalls = 0;
+	int isConsistent = 1;
+	for (int cell = 0; cell < numCells && isConsistent; ++cell)
+	{
+		int region = (cell / size / MAP_REGION_SIZE) * map->numRegionsPerSide + cell % size / MAP_REGION_SIZE;
+		int index = map->wallRectIndices[cell];
+		if (map->cells[cell] != WALL)
+		{
+			++numOpenCells;
+			++regionOpenCells[region];
+			isConsistent = index < 0;
+		}
+		else
+		{
+			++numWalls;
+			// The rectangle of a wall covers its whole cell
+			isConsistent = index >= 0 && index < map->wallRectsLength &&
+					map->wallRects[index].x == (float)(cell % size) * map->cellSize &&
+					map->wallRects[index].y == (float)(cell / size) * map->cellSize;
+		}
+		if (IsMapCellVisited(map, cell))
+		{
+			++numVisitedCells;
+			++regionVisitedCells[region];
+		}
+	}
+	for (int i = 0; i < numRegions && isConsistent; ++i)
+	{
+		isConsistent = regionOpenCells[i] == map->regionOpenCells[i] &&
+				regionVisitedCells[i] == map->regionVisitedCells[i];
+	}
+	if (isConsistent)
+	{
+		CalculateGoalDistances(map->cells, WALL, size, GetMapGoalCellIndex(map), goalDistances);
+		isConsistent = numOpenCells == map->numOpenCells && numVisitedCells == map->numVisitedCells &&
+				numWalls == map->wallRectsLength &&
+				memcmp(goalDistances, map->goalDistances, (size_t)numCells * sizeof(int)) == 0;
+	}
+	free(regionOpenCells);
+	free(regionVisitedCells);
+	free(goalDistances);
+	return isConsistent;
+}
+
+/**
+ * Raises walls in randomly chosen open cells of a map through SetMapCell(), then opens them again in the same order,
+ * and reports the time per change. On top of the goal distance update, each change keeps the wall rectangles and the
+ * open and visited cell counters up to date. Half of the cells are visited first, so raising a wall also forgets a
+ * visit, and opening the walls in the order they were raised moves the last rectangle into the slot of each removed
+ * one. The state of the map is checked afterwards.
+ *
+ * @param size the side length of the maze
+ */
+static void RunMapCellBench(int size)
+{
+	Map map;
+	CreateMap(&map, size, ENGINE_MAP_CELL_SIZE, BENCH_MAZE_SEED);
+	CreateMapGoalDistances(&map);
+	int goal = GetMapGoalCellIndex(&map);
+	// Small mazes do not have enough open cells to pick from
+	int numToggled = map.numOpenCells / 2 < FIELD_BENCH_TOGGLED_CELLS ? map.numOpenCells / 2 :
+			FIELD_BENCH_TOGGLED_CELLS;
+	int* cells = (int*)calloc(numToggled, sizeof(int));
+	if (cells == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	// A cell is picked once, so every change below turns empty space into a wall or back
+	BitSet* pickedCells = CreateBitSet(size * size);
+	Random random;
+	SeedRandom(&random, BENCH_MAZE_SEED);
+	for (int i = 0; i < numToggled; ++i)
+	{
+		do
+		{cells[i] = (int)NextRandomBelow(&random, (uint32_t)(size * size));}
+		while (map.cells[cells[i]] != EMPTY || cells[i] == goal || !SetBit(pickedCells, cells[i]));
+		if (i % 2 == 0)
+		{MarkMapCellVisited(&map, cells[i]);}
+	}
+	DestroyBitSet(pickedCells);
+
+	Uint64 start = BenchStart();
+	for (int i = 0; i < numToggled; ++i)
+	{
+		SetMapCell(&map, cells[i], WALL);
+		ClearMapChangedCells(&map);
+	}
+	for (int i = 0; i < numToggled; ++i)
+	{
+		SetMapCell(&map, cells[i], EMPTY);
+		ClearMapChangedCells(&map);
+	}
+	PrintBenchResult("fields: map cell changes", BenchElapsedMs(start), 2L * numToggled);
+	if (!CheckMapCellState(&map))
+	{
+		printf("map state after the cell changes does not match the cells\n");
+		ErrorHandler(UNKNOWN_ERROR);
+	}
+	printf("map state after the cell changes matches the cells\n");
+	free(cells);
+	DestroyMap(&map);
+}
+
+/**
+ * Turns randomly chosen open cells of a maze into walls and back, updating both distance fields after each change, and
+ * reports the time per update. This is the work done when a wall moves at runtime, compared with calculating the
+ * fields again.
+ *
+ * @param maze 			the maze, its toggled cells are open again on return
+ * @param size 			the side length of the maze
+ * @param goalDistances the goal distances of the maze
+ * @param wallDistances the wall distances of the maze
+ */
+static void RunFieldUpdateBench(int* maze, int size, int* goalDistances, unsigned char* wallDistances)
+{
+	int goal = size * size - size - 2;
+	int* queue = (int*)calloc((size_t)size * size, sizeof(int));
+	int* cells = (int*)calloc(FIELD_BENCH_TOGGLED_CELLS, sizeof(int));
+	if (queue == NULL || cells == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	Random random;
+	SeedRandom(&random, BENCH_MAZE_SEED);
+	for (int i = 0; i < FIELD_BENCH_TOGGLED_CELLS; ++i)
+	{
+		do
+		{cells[i] = (int)NextRandomBelow(&random, (uint32_t)(size * size));}
+		while (maze[cells[i]] != EMPTY || cells[i] == goal);
+	}
+
+	Uint64 start = BenchStart();
+	for (int i = 0; i < FIELD_BENCH_TOGGLED_CELLS; ++i)
+	{
+		maze[cells[i]] = WALL;
+		UpdateGoalDistances(maze, WALL, size, goal, goalDistances, cells[i], queue);
+		maze[cells[i]] = EMPTY;
+		UpdateGoalDistances(maze, WALL, size, goal, goalDistances, cells[i], queue);
+	}
+	PrintBenchResult("fields: goal distance updates", BenchElapsedMs(start), 2L * FIELD_BENCH_TOGGLED_CELLS);
+
+	start = BenchStart();
+	for (int i = 0; i < FIELD_BENCH_TOGGLED_CELLS; ++i)
+	{
+		maze[cells[i]] = WALL;
+		UpdateWallDistances(maze, EMPTY, size, wallDistances, cells[i]);
+		maze[cells[i]] = EMPTY;
+		UpdateWallDistances(maze, EMPTY, size, wallDistances, cells[i]);
+	}
+	PrintBenchResult("fields: wall distance updates", BenchElapsedMs(start), 2L * FIELD_BENCH_TOGGLED_CELLS);
+	free(queue);
+	free(cells);
+}
+
+/**
+ * Generates one large maze and reports the time taken by the maze generation and by each distance field. The wall
+ * distances are calculated serially and split between worker threads, then both fields are updated after single cell
+ * changes. The goal distances are also updated through SetMapCell() on a map of the same size, which is how the game
+ * keeps them, the wall distances are only used by the ray casting benchmark.
+ *
+ * @param argc the number of command line arguments, the first one may be the side length of the maze
+ * @param argv the command line arguments
+ */
+void RunFieldBench(int argc, char* argv[])
+{
+	int size = argc > 1 ? atoi(argv[1]) : FIELD_BENCH_DEFAULT_SIZE;
+	if (size < 5)
+	{size = FIELD_BENCH_DEFAULT_SIZE;}
+	// The maze generator needs an odd side length
+	size |= 1;
+	int* goalDistances = (int*)calloc((size_t)size * size, sizeof(int));
+	unsigned char* wallDistances = (unsigned char*)calloc((size_t)size * size, sizeof(unsigned char));
+	if (goalDistances == NULL || wallDistances == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	WorkerPool* pool = CreateWorkerPool(SDL_GetCPUCount() - 1);
+
+	printf("Distance fields, %dx%d maze, %d worker threads\n", size, size, pool->numWorkers);
+	Uint64 start = BenchStart();
+	int* maze = CreateMazeMap(size, BENCH_MAZE_SEED);
+	PrintBenchResult("fields: maze generation", BenchElapsedMs(start), (long)size * size);
+
+	start = BenchStart();
+	CalculateGoalDistances(maze, WALL, size, size * size - size - 2, goalDistances);
+	PrintBenchResult("fields: goal distances", BenchElapsedMs(start), (long)size * size);
+
+	start = BenchStart();
+	CalculateWallDistances(maze, EMPTY, size, wallDistances, NULL);
+	PrintBenchResult("fields: wall distances, serial", BenchElapsedMs(start), (long)size * size);
+
+	start = BenchStart();
+	CalculateWallDistances(maze, EMPTY, size, wallDistances, pool);
+	PrintBenchResult("fields: wall distances, worker pool", BenchElapsedMs(start), (long)size * size);
+	printf("shortest path from the start to the goal: %d steps\n", goalDistances[size + 1]);
+
+	RunFieldUpdateBench(maze, size, goalDistances, wallDistances);
+	// The map holds its own copy of the maze and fields, so these are freed first
+	free(maze);
+	free(goalDistances);
+	free(wallDistances);
+	RunMapCellBench(size);
+
+	DestroyWorkerPool(pool);
+}
@@ -0,0 +1,137 @@
+#include <stdlib.h>
+#include "Bench.h"
+#include "../Engine/Engine.h"
+#include "../Utils/Config/Config.h"
+#include "../Utils/Random/Random.h"
+
+#define FRAME_BENCH_FRAMES 600         // number of frames rendered by the benchmark
+#define FRAME_BENCH_FRAMES_PER_CELL 60 // number of frames rendered from each open cell while turning around
+#define FRAME_BENCH_ENTITY_SPREAD 0.6f // part of a cell over which the entities added by the benchmark are scattered
+
+/**
+ * Moves the given pose through the open cells of the maze: after FRAME_BENCH_FRAMES_PER_CELL frames the pose moves on
+ * to the next open cell, within a cell it turns a full circle.
+ *
+ * @param map 		the map
+ * @param frame 	the index of the frame
+ * @param cell 		the index of the current cell, updated when the pose moves on
+ * @param position 	the position to be written
+ * @param direction the direction to be written
+ */
+static void MoveBenchPose(const Map* map, int frame, int* cell, Vec3* position, Vec3* direction)
+{
+	// Moves on to the next open cell after a full turn
+	if (frame % FRAME_BENCH_FRAMES_PER_CELL == 0)
+	{
+		do
+		{*cell = (*cell + 1) % (map->size * map->size);}
+		while (map->cells[*cell] != EMPTY);
+	}
+	float angle = 2.0f * (float)M_PI * (float)(frame % FRAME_BENCH_FRAMES_PER_CELL) / FRAME_BENCH_FRAMES_PER_CELL;
+	*position = V3(((float)(*cell % map->size) + 0.5f) * map->cellSize,
+			((float)(*cell / map->size) + 0.5f) * map->cellSize, 0.0f);
+	*direction = V3(cosf(angle), sinf(angle), 0.0f);
+}
+
+/**
+ * Fills the entity list of an engine to capacity, scattering the added entities over the open cells of the maze so
+ * that every view holds several sprites.
+ *
+ * @param engine the engine
+ */
+static void CrowdBenchEntities(Engine* engine)
+{
+	const Map* map = &engine->map;
+	EntityList* entities = engine->entities;
+	Random random;
+	SeedRandom(&random, BENCH_MAZE_SEED);
+	int cell = 0;
+	while (entities->numEntities < entities->capacity)
+	{
+		do
+		{cell = (cell + 1) % (map->size * map->size);}
+		while (map->cells[cell] != EMPTY);
+		// Offsets in [-FRAME_BENCH_ENTITY_SPREAD / 2, FRAME_BENCH_ENTITY_SPREAD / 2) of a cell around its center
+		float dx = FRAME_BENCH_ENTITY_SPREAD * ((float)NextRandomBelow(&random, 1024u) / 1024.0f - 0.5f);
+		float dy = FRAME_BENCH_ENTITY_SPREAD * ((float)NextRandomBelow(&random, 1024u) / 1024.0f - 0.5f);
+		float x = (float)(cell % map->size) + 0.5f + dx;
+		float y = (float)(cell / map->size) + 0.5f + dy;
+		AddEngineEntity(engine, entities->numEntities % 2 == 0 ? ENTITY_TYPE_ENEMY : ENTITY_TYPE_ITEM,
+				V3(x * map->cellSize, y * map->cellSize, 0.0f));
+	}
+}
+
+/**
+ * Renders first-person frames headless, without a window or renderer, and reports the time per frame. The camera
+ * visits the open cells of the maze in order and turns a full circle in each, so every frame runs ray casting, floor
+ * and ceiling casting, wall drawing and sprite drawing the same way the game does. The same frames are rendered again
+ * with the entity list filled to capacity, which shows the cost of hundreds of sprites per frame, and then as four
+ * split-screen quarter views, which cover the same number of pixels and are scheduled together on the worker pool.
+ * This is also the training workload for profile-guided optimization builds.
+ *
+ * @param argc the number of command line arguments, forwarded to LoadConfig()
+ * @param argv the command line arguments, forwarded to LoadConfig()
+ */
+void RunFrameBench(int argc, char* argv[])
+{
+	const char* const wallTexturePaths[] = {"Assets/Textures/wall0.bmp", "Assets/Textures/wall1.bmp",
+											"Assets/Textures/wall2.bmp", "Assets/Textures/wall3.bmp"};
+	Config config;
+	LoadConfig(&config, argc, argv);
+	if (config.seed == 0)
+	{config.seed = BENCH_MAZE_SEED;}
+	WorkerPool* pool = CreateWorkerPool(SDL_GetCPUCount() - 1);
+	TextureAtlas* atlas = LoadTextureAtlas(wallTexturePaths, 4);
+	Engine* engine = CreateEngine(&config, atlas, pool);
+	const Map* map = &engine->map;
+
+	printf("Frame rendering, %d frames at %dx%d, %d worker threads\n", FRAME_BENCH_FRAMES,
+			engine->cameras[ENGINE_PLAYER_CAMERA]->frameBuffer->width,
+			engine->cameras[ENGINE_PLAYER_CAMERA]->frameBuffer->height, pool->numWorkers);
+	int cell = 0;
+	Uint64 start = BenchStart();
+	for (int i = 0; i < FRAME_BENCH_FRAMES; ++i)
+	{
+		MoveBenchPose(map, i, &cell, &engine->player.position, &engine->player.direction);
+		RenderEngineFrame(engine);
+	}
+	PrintBenchResult("frame: cast + floor + walls + sprites", BenchElapsedMs(start), FRAME_BENCH_FRAMES);
+
+	// The same frames with the maze crowded with entities
+	CrowdBenchEntities(engine);
+	long numSprites = 0;
+	cell = 0;
+	start = BenchStart();
+	for (int i = 0; i < FRAME_BENCH_FRAMES; ++i)
+	{
+		MoveBenchPose(map, i, &cell, &engine->player.position, &engine->player.direction);
+		RenderEngineFrame(engine);
+		numSprites += engine->cameras[ENGINE_PLAYER_CAMERA]->spriteFrame.numSprites;
+	}
+	PrintBenchResult("frame: crowded with entities", BenchElapsedMs(start), FRAME_BENCH_FRAMES);
+	printf("%d entities, %.1f sprites drawn per frame on average\n", engine->entities->numEntities,
+			(double)numSprites / FRAME_BENCH_FRAMES);
+
+	// Replaces the player view by four quarter views, each starting in a different cell
+	engine->cameras[ENGINE_PLAYER_CAMERA]->isEnabled = 0;
+	Camera* quarters[4];
+	int quarterCells[4];
+	for (int q = 0; q < 4; ++q)
+	{
+		Viewport viewport = {0.5f * (float)(q % 2), 0.5f * (float)(q / 2), 0.5f, 0.5f};
+		quarters[q] = AddEngineCamera(engine, viewport);
+		quarterCells[q] = q * map->size * map->size / 4;
+	}
+	start = BenchStart();
+	for (int i = 0; i < FRAME_BENCH_FRAMES; ++i)
+	{
+		for (int q = 0; q < 4; ++q)
+		{MoveBenchPose(map, i, &quarterCells[q], &quarters[q]->position, &quarters[q]->direction);}
+		RenderEngineFrame(engine);
+	}
+	PrintBenchResult("frame: 4 split-screen views", BenchElapsedMs(start), FRAME_BENCH_FRAMES);
+
+	DestroyEngine(engine);
+	DestroyTextureAtlas(atlas);
+	DestroyWorkerPool(pool);
+}
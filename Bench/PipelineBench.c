@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Bench.h"
+#include "../Engine/Engine.h"
+#include "../Autopilot/Autopilot.h"
+#include "../Utils/Config/Config.h"
+#include "../Utils/AsyncTask/AsyncTask.h"
+#include "../Utils/ErrorHandler/ErrorHandler.h"
+
+#define PIPELINE_BENCH_FRAMES 600 // number of frames presented in each mode
+
+/**
+ * Lists the frame buffers holding the views of the last rendered frame, the presented ones if the engine is double
+ * buffered. They are listed before the next frame is started, which rewrites the cameras of the frame.
+ *
+ * @param engine 	   the engine
+ * @param frameBuffers the frame buffers to be written, ENGINE_MAX_CAMERAS entries
+ * @return the number of frame buffers
+ */
+static int ListPresentedFrameBuffers(const Engine* engine, const FrameBuffer* frameBuffers[])
+{
+	for (int i = 0; i < engine->numFrameCameras; ++i)
+	{
+		const Camera* camera = engine->frameCameras[i];
+		frameBuffers[i] = camera->presentedFrameBuffer != NULL ? camera->presentedFrameBuffer : camera->frameBuffer;
+	}
+	return engine->numFrameCameras;
+}
+
+/**
+ * Stands in for the texture upload and presentation of the game's main thread: copies the given frame buffers, then
+ * sleeps for the given time, like a wait for vsync.
+ *
+ * @param frameBuffers 	  the frame buffers of the presented frame
+ * @param numFrameBuffers the number of frame buffers
+ * @param upload 		  the memory the frame buffers are copied to, large enough for the largest one
+ * @param presentMs 	  the time slept after the copy, in milliseconds
+ */
+static void SubmitBenchFrame(const FrameBuffer* const frameBuffers[], int numFrameBuffers, uint32_t* upload,
+		int presentMs)
+{
+	for (int i = 0; i < numFrameBuffers; ++i)
+	{
+		const FrameBuffer* frameBuffer = frameBuffers[i];
+		memcpy(upload, frameBuffer->pixels, (size_t)frameBuffer->width * frameBuffer->height * sizeof(uint32_t));
+	}
+	if (presentMs > 0)
+	{SDL_Delay((Uint32)presentMs);}
+}
+
+/**
+ * Renders the views of the engine on the render thread.
+ *
+ * @param context the engine
+ */
+static void RenderBenchFrame(void* context)
+{
+	RenderEngineFrame((Engine*)context);
+}
+
+/**
+ * Compares two latencies for sorting.
+ *
+ * @param a the first latency
+ * @param b the second latency
+ * @return a negative value, 0 or a positive value if the first latency is smaller, equal or larger
+ */
+static int CompareLatencies(const void* a, const void* b)
+{
+	double x = *(const double*)a;
+	double y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+/**
+ * Lets the autopilot play PIPELINE_BENCH_FRAMES frames of a new game and prints the throughput and the latency from
+ * reading the input of a frame to the end of its submission.
+ *
+ * @param config 	the configuration, the maze seed must be set
+ * @param atlas 	the wall textures
+ * @param pool 		the worker threads
+ * @param presentMs the time the submission of a frame waits, in milliseconds
+ * @param task 		the render thread overlapping rendering and submission, NULL to run them one after the other
+ */
+static void RunPipelineMode(const Config* config, const TextureAtlas* atlas, WorkerPool* pool, int presentMs,
+		AsyncTask* task)
+{
+	Engine* engine = CreateEngine(config, atlas, pool);
+	if (task != NULL)
+	{EnableEngineDoubleBuffering(engine);}
+	Autopilot* autopilot = CreateAutopilot(engine->map.size);
+	const Camera* playerCamera = engine->cameras[ENGINE_PLAYER_CAMERA];
+	uint32_t* upload = (uint32_t*)calloc((size_t)playerCamera->maxRays * playerCamera->frameBuffer->height,
+			sizeof(uint32_t));
+	double* latencies = (double*)calloc(PIPELINE_BENCH_FRAMES, sizeof(double));
+	if (upload == NULL || latencies == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+
+	const FrameBuffer* presented[ENGINE_MAX_CAMERAS];
+	int numPresentedBuffers = 0;
+	int numPresented = 0;
+	Uint64 presentedInputTime = 0;
+	Uint64 start = BenchStart();
+	// The pipelined mode renders one frame more, the last one presented was rendered in the previous iteration
+	while (numPresented < PIPELINE_BENCH_FRAMES)
+	{
+		Uint64 inputTime = BenchStart();
+		PlayerInput input = SteerAutopilot(autopilot, &engine->map, &engine->player);
+		UpdateEngine(engine, &input);
+		if (task != NULL)
+		{
+			StartAsyncTask(task, RenderBenchFrame, engine);
+			if (presentedInputTime != 0)
+			{
+				SubmitBenchFrame(presented, numPresentedBuffers, upload, presentMs);
+				latencies[numPresented++] = BenchElapsedMs(presentedInputTime);
+			}
+			WaitAsyncTask(task);
+			SwapEngineFrameBuffers(engine);
+			numPresentedBuffers = ListPresentedFrameBuffers(engine, presented);
+			presentedInputTime = inputTime;
+		}
+		else
+		{
+			RenderEngineFrame(engine);
+			numPresentedBuffers = ListPresentedFrameBuffers(engine, presented);
+			SubmitBenchFrame(presented, numPresentedBuffers, upload, presentMs);
+			latencies[numPresented++] = BenchElapsedMs(inputTime);
+		}
+	}
+	double elapsedMs = BenchElapsedMs(start);
+
+	double totalLatency = 0.0;
+	for (int i = 0; i < numPresented; ++i)
+	{totalLatency += latencies[i];}
+	qsort(latencies, (size_t)numPresented, sizeof(double), CompareLatencies);
+	printf("%-10s %8.1f frames/s %8.3f ms/frame, input to submit latency mean %8.3f ms, p99 %8.3f ms\n",
+			task != NULL ? "pipelined" : "sequential", (double)numPresented * 1000.0 / elapsedMs,
+			elapsedMs / (double)numPresented, totalLatency / (double)numPresented,
+			latencies[(numPresented * 99) / 100]);
+
+	free(latencies);
+	free(upload);
+	DestroyAutopilot(autopilot);
+	DestroyEngine(engine);
+}
+
+/**
+ * Plays the same frames with the autopilot twice, once rendering and submitting each frame one after the other and once
+ * rendering the next frame on a separate thread while the previous one is submitted, and reports the throughput and
+ * the latency from reading the input to the end of the submission of both modes. Submission copies the frame buffers
+ * like the texture upload of the game and waits for the given time like the wait for vsync, without a window.
+ *
+ * @param argc the number of command line arguments, the first one may be the submission wait in milliseconds, the
+ * 			   others are forwarded to LoadConfig()
+ * @param argv the command line arguments
+ */
+void RunPipelineBench(int argc, char* argv[])
+{
+	const char* const wallTexturePaths[] = {"Assets/Textures/wall0.bmp", "Assets/Textures/wall1.bmp",
+											"Assets/Textures/wall2.bmp", "Assets/Textures/wall3.bmp"};
+	int presentMs = 0;
+	char* end = NULL;
+	long value = argc > 1 ? strtol(argv[1], &end, 10) : -1;
+	if (argc > 1 && *end == '\0' && value >= 0)
+	{
+		// The wait takes the place of the program name for the configuration loader
+		presentMs = (int)value;
+		--argc;
+		++argv;
+	}
+	Config config;
+	LoadConfig(&config, argc, argv);
+	if (config.seed == 0)
+	{config.seed = BENCH_MAZE_SEED;}
+	WorkerPool* pool = CreateWorkerPool(SDL_GetCPUCount() - 1);
+	TextureAtlas* atlas = LoadTextureAtlas(wallTexturePaths, 4);
+	AsyncTask* task = CreateAsyncTask();
+
+	printf("Pipeline of %d frames, %dx%d window, %d ms present wait, %d worker threads\n", PIPELINE_BENCH_FRAMES,
+			config.windowWidth, config.windowHeight, presentMs, pool->numWorkers);
+	RunPipelineMode(&config, atlas, pool, presentMs, NULL);
+	RunPipelineMode(&config, atlas, pool, presentMs, task);
+
+	DestroyAsyncTask(task);
+	DestroyTextureAtlas(atlas);
+	DestroyWorkerPool(pool);
+}
@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include "Bench.h"
+#include "../Engine/Engine.h"
+#include "../InputLog/InputLog.h"
+#include "../Utils/Config/Config.h"
+#include "../Utils/ErrorHandler/ErrorHandler.h"
+
+/**
+ * Replays a recorded input log without a window, rendering every tick, and reports the time per frame and the final
+ * game state. The maze seed, maze size, step and field of view are taken from the log, so the session is reproduced
+ * exactly. The slowest frame is reported with its tick, so a stutter seen while playing can be found again.
+ *
+ * @param argc the number of command line arguments, the first one is the path of the input log, the others are
+ * 			   forwarded to LoadConfig()
+ * @param argv the command line arguments
+ */
+void RunReplayBench(int argc, char* argv[])
+{
+	const char* const wallTexturePaths[] = {"Assets/Textures/wall0.bmp", "Assets/Textures/wall1.bmp",
+											"Assets/Textures/wall2.bmp", "Assets/Textures/wall3.bmp"};
+	if (argc < 2)
+	{
+		printf("Usage: rayCastingMazeBench replay INPUT_LOG [configuration options]\n");
+		return;
+	}
+	InputLog* inputLog = LoadInputLog(argv[1]);
+	if (inputLog == NULL)
+	{
+		printf("%s is not a readable input log.\n", argv[1]);
+		ErrorHandler(INVALID_CONFIGURATION_ERROR);
+	}
+	// The log path takes the place of the program name for the configuration loader
+	Config config;
+	LoadConfig(&config, argc - 1, argv + 1);
+	config.seed = (int)inputLog->seed;
+	config.mazeSize = inputLog->mazeSize;
+	config.stepScalar = inputLog->stepScalar;
+	config.fieldOfView = inputLog->fieldOfView;
+	config.doorInterval = inputLog->doorInterval;
+	if (!ValidateConfig(&config))
+	{ErrorHandler(INVALID_CONFIGURATION_ERROR);}
+	WorkerPool* pool = CreateWorkerPool(SDL_GetCPUCount() - 1);
+	TextureAtlas* atlas = LoadTextureAtlas(wallTexturePaths, 4);
+	Engine* engine = CreateEngine(&config, atlas, pool);
+
+	printf("Replay of %s, %d ticks, seed %u, %dx%d maze, %d worker threads\n", argv[1], inputLog->numTicks,
+			inputLog->seed, engine->map.size, engine->map.size, pool->numWorkers);
+	double slowestMs = 0.0;
+	int slowestTick = 0;
+	Uint64 start = BenchStart();
+	for (int tick = 0; tick < inputLog->numTicks; ++tick)
+	{
+		Uint64 frameStart = BenchStart();
+		PlayerInput input = GetLoggedInput(inputLog, tick);
+		UpdateEngine(engine, &input);
+		RenderEngineFrame(engine);
+		double frameMs = BenchElapsedMs(frameStart);
+		if (frameMs > slowestMs)
+		{
+			slowestMs = frameMs;
+			slowestTick = tick;
+		}
+	}
+	if (inputLog->numTicks > 0)
+	{
+		PrintBenchResult("replay: update + render", BenchElapsedMs(start), inputLog->numTicks);
+		printf("slowest frame: %.3f ms at tick %d\n", slowestMs, slowestTick);
+	}
+	// The final state identifies the run, two replays of the same log must print the same values. The visited cells
+	// are counted from the bits rather than taken from the map's counter, so a counter out of step shows up here.
+	int numVisited = CountBitSet(engine->map.visitedCells);
+	const Player* player = &engine->player;
+	printf("final state: position (%.4f, %.4f), direction (%.4f, %.4f), %d cells visited (%.1f%% explored), "
+			"%d items collected, %s\n", player->position.x, player->position.y, player->direction.x,
+			player->direction.y, numVisited, 100.0f * GetMapCoverage(&engine->map), engine->numItemsCollected,
+			engine->hasWon ? "won" : "not won");
+
+	DestroyEngine(engine);
+	DestroyTextureAtlas(atlas);
+	DestroyWorkerPool(pool);
+	DestroyInputLog(inputLog);
+}
@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "Bench.h"
+#include "../Engine/Engine.h"
+#include "../Autopilot/Autopilot.h"
+#include "../Utils/Config/Config.h"
+#include "../Utils/ErrorHandler/ErrorHandler.h"
+
+#define SOAK_DEFAULT_MAZES 10           // number of mazes solved when none is given
+#define SOAK_MAX_TICKS_PER_CELL 400     // ticks allowed per maze cell before a maze is given up
+#define SOAK_HISTOGRAM_BUCKET_MS 0.05   // width of a frame time histogram bucket
+#define SOAK_HISTOGRAM_BUCKETS 4000     // number of histogram buckets, slower frames fall into the last one
+
+/**
+ * Gets the frame time below which the given fraction of the frames of a histogram fall.
+ *
+ * @param histogram the number of frames in each bucket
+ * @param numFrames the number of frames in the histogram
+ * @param fraction 	the fraction of the frames
+ * @return the upper edge of the bucket holding the frame, in milliseconds
+ */
+static double GetHistogramPercentile(const long histogram[], long numFrames, double fraction)
+{
+	long count = 0;
+	for (int i = 0; i < SOAK_HISTOGRAM_BUCKETS; ++i)
+	{
+		count += histogram[i];
+		if ((double)count >= fraction * (double)numFrames)
+		{return (double)(i + 1) * SOAK_HISTOGRAM_BUCKET_MS;}
+	}
+	return (double)SOAK_HISTOGRAM_BUCKETS * SOAK_HISTOGRAM_BUCKET_MS;
+}
+
+/**
+ * Lets the autopilot play through successive mazes without a window, rendering every tick, and reports the time per
+ * frame of each maze and the frame time percentiles of the whole run. The run can be made as long as needed to find
+ * slowdowns and leaks that only show up after hours of play. The mazes are generated from consecutive seeds starting
+ * at the configured one, so a run can be repeated.
+ *
+ * @param argc the number of command line arguments, the first one may be the number of mazes, the others are forwarded
+ * 			   to LoadConfig()
+ * @param argv the command line arguments
+ */
+void RunSoakBench(int argc, char* argv[])
+{
+	const char* const wallTexturePaths[] = {"Assets/Textures/wall0.bmp", "Assets/Textures/wall1.bmp",
+											"Assets/Textures/wall2.bmp", "Assets/Textures/wall3.bmp"};
+	int numMazes = SOAK_DEFAULT_MAZES;
+	char* end = NULL;
+	long value = argc > 1 ? strtol(argv[1], &end, 10) : 0;
+	if (argc > 1 && *end == '\0' && value > 0)
+	{
+		// The number of mazes takes the place of the program name for the configuration loader
+		numMazes = (int)value;
+		--argc;
+		++argv;
+	}
+	Config config;
+	LoadConfig(&config, argc, argv);
+	if (config.seed == 0)
+	{config.seed = BENCH_MAZE_SEED;}
+	WorkerPool* pool = CreateWorkerPool(SDL_GetCPUCount() - 1);
+	TextureAtlas* atlas = LoadTextureAtlas(wallTexturePaths, 4);
+	Engine* engine = CreateEngine(&config, atlas, pool);
+	Autopilot* autopilot = CreateAutopilot(engine->map.size);
+	long* histogram = (long*)calloc(SOAK_HISTOGRAM_BUCKETS, sizeof(long));
+	if (histogram == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+
+	printf("Soak run of %d mazes, %dx%d, seeds from %d, %d worker threads\n", numMazes, engine->map.size,
+			engine->map.size, config.seed, pool->numWorkers);
+	const long maxTicks = (long)SOAK_MAX_TICKS_PER_CELL * engine->map.size * engine->map.size;
+	long numFrames = 0;
+	int numSolved = 0;
+	double slowestMs = 0.0;
+	Uint64 start = BenchStart();
+	for (int maze = 0; maze < numMazes; ++maze)
+	{
+		if (maze > 0)
+		{ResetEngine(engine, (uint32_t)config.seed + (uint32_t)maze);}
+		double mazeMs = 0.0;
+		double mazeSlowestMs = 0.0;
+		long ticks = 0;
+		while (!engine->hasWon && ticks < maxTicks)
+		{
+			Uint64 frameStart = BenchStart();
+			PlayerInput input = SteerAutopilot(autopilot, &engine->map, &engine->player);
+			UpdateEngine(engine, &input);
+			RenderEngineFrame(engine);
+			double frameMs = BenchElapsedMs(frameStart);
+			int bucket = (int)(frameMs / SOAK_HISTOGRAM_BUCKET_MS);
+			++histogram[bucket < SOAK_HISTOGRAM_BUCKETS ? bucket : SOAK_HISTOGRAM_BUCKETS - 1];
+			mazeMs += frameMs;
+			if (frameMs > mazeSlowestMs)
+			{mazeSlowestMs = frameMs;}
+			++ticks;
+		}
+		numFrames += ticks;
+		numSolved += engine->hasWon;
+		if (mazeSlowestMs > slowestMs)
+		{slowestMs = mazeSlowestMs;}
+		printf("maze %4d seed %10u: %s after %7ld ticks, %5.1f%% explored, %8.3f ms/frame, slowest %8.3f ms\n", maze,
+				engine->map.seed, engine->hasWon ? "solved" : "GAVE UP", ticks, 100.0f * GetMapCoverage(&engine->map),
+				ticks > 0 ? mazeMs / (double)ticks : 0.0, mazeSlowestMs);
+	}
+	if (numFrames > 0)
+	{
+		PrintBenchResult("soak: autopilot + update + render", BenchElapsedMs(start), numFrames);
+		printf("%d of %d mazes solved, %ld frames, p50 %.2f ms, p99 %.2f ms, p99.9 %.2f ms, slowest %.3f ms\n",
+				numSolved, numMazes, numFrames, GetHistogramPercentile(histogram, numFrames, 0.5),
+				GetHistogramPercentile(histogram, numFrames, 0.99), GetHistogramPercentile(histogram, numFrames, 0.999),
+				slowestMs);
+	}
+
+	free(histogram);
+	DestroyAutopilot(autopilot);
+	DestroyEngine(engine);
+	DestroyTextureAtlas(atlas);
+	DestroyWorkerPool(pool);
+}
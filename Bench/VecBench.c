@@ -0,0 +1,161 @@
+#include <stdlib.h>
+#include "Bench.h"
+#include "../Utils/Vec3/Vec3.h"
+#include "../Utils/ErrorHandler/ErrorHandler.h"
+
+#define VEC_BENCH_COUNT 1024 // number of vectors processed per iteration batch
+
+volatile float VEC_BENCH_SINK = 0.0f; // consumes benchmark results so they are not optimized away
+
+/**
+ * Benchmarks the pattern used by the player movement before the value API: allocating the step vector with Vec3D(),
+ * scaling it and translating the position by it.
+ *
+ * @param positions  the position of each vector in the batch
+ * @param direction  the direction of movement
+ * @param iterations the total number of vectors to move
+ * @return the elapsed time in milliseconds
+ */
+static double BenchPointerStep(Vec3 positions[], const Vec3* direction, long iterations)
+{
+	Uint64 start = BenchStart();
+	for (long i = 0; i < iterations; ++i)
+	{
+		Vec3* step = Vec3D(direction->x, direction->y, direction->z);
+		Scale3D(step, 2.0f);
+		Translate3D(&positions[i % VEC_BENCH_COUNT], step);
+		free(step);
+	}
+	return BenchElapsedMs(start);
+}
+
+/**
+ * Benchmarks the player movement pattern using the value API.
+ *
+ * @param positions  the position of each vector in the batch
+ * @param direction  the direction of movement
+ * @param iterations the total number of vectors to move
+ * @return the elapsed time in milliseconds
+ */
+static double BenchValueStep(Vec3 positions[], Vec3 direction, long iterations)
+{
+	Uint64 start = BenchStart();
+	for (long i = 0; i < iterations; i += VEC_BENCH_COUNT)
+	{
+		for (int j = 0; j < VEC_BENCH_COUNT; ++j)
+		{positions[j] = V3Add(positions[j], V3Scale(direction, 2.0f));}
+	}
+	return BenchElapsedMs(start);
+}
+
+/**
+ * Benchmarks the perpendicular distance calculation with the pointer API.
+ *
+ * @param points 	 the points
+ * @param origin 	 the origin of the distances
+ * @param direction  the unit direction the distances are measured along
+ * @param iterations the total number of distances
+ * @return the elapsed time in milliseconds
+ */
+static double BenchPointerDot(const Vec3 points[], const Vec3* origin, const Vec3* direction, long iterations)
+{
+	Vec3 invertedOrigin = *origin;
+	Invert3D(&invertedOrigin);
+	float sum = 0.0f;
+	Uint64 start = BenchStart();
+	for (long i = 0; i < iterations; ++i)
+	{
+		Vec3 ray = points[i % VEC_BENCH_COUNT];
+		Translate3D(&ray, &invertedOrigin);
+		sum += Dot3D(&ray, direction);
+	}
+	double elapsedMs = BenchElapsedMs(start);
+	VEC_BENCH_SINK = sum;
+	return elapsedMs;
+}
+
+/**
+ * Benchmarks the perpendicular distance calculation with the value API.
+ *
+ * @param points 	 the points
+ * @param origin 	 the origin of the distances
+ * @param direction  the unit direction the distances are measured along
+ * @param iterations the total number of distances
+ * @return the elapsed time in milliseconds
+ */
+static double BenchValueDot(const Vec3 points[], Vec3 origin, Vec3 direction, long iterations)
+{
+	float sum = 0.0f;
+	Uint64 start = BenchStart();
+	for (long i = 0; i < iterations; i += VEC_BENCH_COUNT)
+	{
+		for (int j = 0; j < VEC_BENCH_COUNT; ++j)
+		{sum += V3Dot(V3Sub(points[j], origin), direction);}
+	}
+	double elapsedMs = BenchElapsedMs(start);
+	VEC_BENCH_SINK = sum;
+	return elapsedMs;
+}
+
+/**
+ * Benchmarks rotating a vector by a fixed angle with the pointer API, as done for each ray.
+ *
+ * @param iterations the number of rotations
+ * @return the elapsed time in milliseconds
+ */
+static double BenchPointerRotate(long iterations)
+{
+	Vec3 direction = {1.0f, 0.0f, 0.0f};
+	Uint64 start = BenchStart();
+	for (long i = 0; i < iterations; ++i)
+	{Rotate3D(&direction, 0.001f);}
+	double elapsedMs = BenchElapsedMs(start);
+	VEC_BENCH_SINK = direction.x;
+	return elapsedMs;
+}
+
+/**
+ * Benchmarks rotating a vector by a fixed angle with the value API, with the cosine and sine evaluated once.
+ *
+ * @param iterations the number of rotations
+ * @return the elapsed time in milliseconds
+ */
+static double BenchValueRotate(long iterations)
+{
+	Vec2 direction = V2(1.0f, 0.0f);
+	float cosAngle = cosf(0.001f);
+	float sinAngle = sinf(0.001f);
+	Uint64 start = BenchStart();
+	for (long i = 0; i < iterations; ++i)
+	{direction = V2RotateCosSin(direction, cosAngle, sinAngle);}
+	double elapsedMs = BenchElapsedMs(start);
+	VEC_BENCH_SINK = direction.x;
+	return elapsedMs;
+}
+
+/**
+ * Compares the heap-allocated pointer Vec3 API against the inline value API.
+ *
+ * @param iterations the number of iterations of each benchmark
+ */
+void RunVecBench(long iterations)
+{
+	Vec3* positions = (Vec3*)calloc(VEC_BENCH_COUNT, sizeof(Vec3));
+	if (positions == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	for (int i = 0; i < VEC_BENCH_COUNT; ++i)
+	{positions[i] = V3((float)i, (float)(VEC_BENCH_COUNT - i), 0.0f);}
+	Vec3 origin = V3(3.0f, 5.0f, 0.0f);
+	Vec3 direction = V3(0.6f, 0.8f, 0.0f);
+
+	printf("Vector API, %ld iterations\n", iterations);
+	PrintBenchResult("step: Vec3D + Scale3D + Translate3D", BenchPointerStep(positions, &direction, iterations),
+			iterations);
+	PrintBenchResult("step: V3Add + V3Scale", BenchValueStep(positions, direction, iterations), iterations);
+	PrintBenchResult("distance: Translate3D + Dot3D", BenchPointerDot(positions, &origin, &direction, iterations),
+			iterations);
+	PrintBenchResult("distance: V3Sub + V3Dot", BenchValueDot(positions, origin, direction, iterations), iterations);
+	PrintBenchResult("rotate: Rotate3D", BenchPointerRotate(iterations), iterations);
+	PrintBenchResult("rotate: V2RotateCosSin", BenchValueRotate(iterations), iterations);
+	free(positions);
+}
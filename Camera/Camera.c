@@ -0,0 +1,123 @@
+#include <stdlib.h>
+#include "Camera.h"
+#include "../Utils/ErrorHandler/ErrorHandler.h"
+#include "../Utils/Assert/Assert.h"
+
+/**
+ * Creates a camera. The render resolution is the given full-window internal resolution scaled by the viewport size.
+ *
+ * @param viewport 	   the part of the window the camera is shown in
+ * @param fieldOfView  the field of view in radians
+ * @param windowWidth  the maximum internal render width of a camera covering the whole window
+ * @param windowHeight the internal render height of a camera covering the whole window
+ * @param mapCellSize  the size of each cell in the map grid, one floor texture tile covers one cell
+ * @param shadingTable the lighting and fog lookup tables, not owned by the camera
+ * @return the camera
+ */
+Camera* CreateCamera(Viewport viewport, float fieldOfView, int windowWidth, int windowHeight, float mapCellSize,
+		const ShadingTable* shadingTable)
+{
+	RCM_ASSERT_NOT_NULL(shadingTable);
+	RCM_ASSERT(viewport.w > 0.0f && viewport.h > 0.0f, INVALID_CONFIGURATION_ERROR);
+	Camera* camera = (Camera*)calloc(1, sizeof(Camera));
+	if (camera == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	camera->direction = V3(1.0f, 0.0f, 0.0f);
+	camera->fieldOfView = fieldOfView;
+	camera->viewport = viewport;
+	camera->isEnabled = 1;
+	// The viewport keeps the pixel density of the whole window, so a half-width view casts half the rays
+	camera->maxRays = (int)((float)windowWidth * viewport.w);
+	int height = (int)((float)windowHeight * viewport.h);
+	if (camera->maxRays < 1)
+	{camera->maxRays = 1;}
+	if (height < 1)
+	{height = 1;}
+	// Allocates the intersection, height and perpendicular distance of each ray for the maximum number of rays,
+	// reused every frame
+	camera->rays = (Vec3*)calloc(camera->maxRays, sizeof(Vec3));
+	camera->rayHeights = (float*)calloc(camera->maxRays, sizeof(float));
+	camera->rayDistances = (float*)calloc(camera->maxRays, sizeof(float));
+	camera->raySpans = (RaySpan*)calloc((size_t)camera->maxRays * RAY_MAX_SPANS, sizeof(RaySpan));
+	camera->rayNumSpans = (int*)calloc(camera->maxRays, sizeof(int));
+	if (camera->rays == NULL || camera->rayHeights == NULL || camera->rayDistances == NULL ||
+			camera->raySpans == NULL || camera->rayNumSpans == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	camera->frameBuffer = CreateFrameBuffer(camera->maxRays, height);
+	camera->floorCaster = CreateFloorCaster(height, mapCellSize, shadingTable);
+	camera->numRays = camera->maxRays;
+	return camera;
+}
+
+/**
+ * Frees the memory allocated for the given camera.
+ *
+ * @param camera the given camera
+ */
+void DestroyCamera(Camera* camera)
+{
+	if (camera == NULL)
+	{return;}
+	free(camera->rays);
+	free(camera->rayHeights);
+	free(camera->rayDistances);
+	free(camera->raySpans);
+	free(camera->rayNumSpans);
+	ReleaseSprites(&camera->spriteFrame);
+	DestroyFloorCaster(camera->floorCaster);
+	DestroyFrameBuffer(camera->frameBuffer);
+	if (camera->presentedFrameBuffer != NULL)
+	{DestroyFrameBuffer(camera->presentedFrameBuffer);}
+	free(camera);
+}
+
+/**
+ * Sets the render width of the camera from the internal render width of the whole window, scaled by the viewport
+ * width. One ray is cast per column of the frame buffer.
+ *
+ * @param camera 	  the camera
+ * @param windowWidth the internal render width of the whole window
+ */
+void SetCameraRenderWidth(Camera* camera, int windowWidth)
+{
+	RCM_ASSERT_NOT_NULL(camera);
+	int width = (int)((float)windowWidth * camera->viewport.w);
+	if (width < 1)
+	{width = 1;}
+	if (width > camera->maxRays)
+	{width = camera->maxRays;}
+	ResizeFrameBuffer(camera->frameBuffer, width, camera->frameBuffer->height);
+	camera->numRays = width;
+}
+
+/**
+ * Gives the camera a second frame buffer, so the previous view can be presented while the next one is rendered into
+ * the first. Does nothing if the camera is already double buffered.
+ *
+ * @param camera the camera
+ */
+void EnableCameraDoubleBuffering(Camera* camera)
+{
+	RCM_ASSERT_NOT_NULL(camera);
+	if (camera->presentedFrameBuffer != NULL)
+	{return;}
+	// Allocated at the maximum width like the first one, so neither is reallocated when the render width changes
+	camera->presentedFrameBuffer = CreateFrameBuffer(camera->maxRays, camera->frameBuffer->height);
+	ResizeFrameBuffer(camera->presentedFrameBuffer, camera->numRays, camera->frameBuffer->height);
+}
+
+/**
+ * Swaps the frame buffer just rendered into with the presented one, which is resized to the current render width and
+ * rendered into next. The render width may have changed since the presented frame buffer was rendered into.
+ *
+ * @param camera the camera, it must be double buffered
+ */
+void SwapCameraFrameBuffers(Camera* camera)
+{
+	RCM_ASSERT_NOT_NULL(camera);
+	RCM_ASSERT_NOT_NULL(camera->presentedFrameBuffer);
+	FrameBuffer* rendered = camera->frameBuffer;
+	camera->frameBuffer = camera->presentedFrameBuffer;
+	camera->presentedFrameBuffer = rendered;
+	ResizeFrameBuffer(camera->frameBuffer, camera->numRays, camera->frameBuffer->height);
+}
@@ -0,0 +1,95 @@
+#ifndef RAY_CASTING_MAZE_CAMERA_H_
+#define RAY_CASTING_MAZE_CAMERA_H_
+
+#include "../Utils/Vec3/Vec3.h"
+#include "../Utils/FrameBuffer/FrameBuffer.h"
+#include "../Utils/FloorCaster/FloorCaster.h"
+#include "../Utils/WallRenderer/WallRenderer.h"
+#include "../Utils/SpriteRenderer/SpriteRenderer.h"
+
+/**
+ * Struct for the part of the window a camera is shown in, given as fractions of the window size so that it does not
+ * depend on the window or the internal resolution. {0, 0, 1, 1} covers the whole window.
+ */
+typedef struct Viewport_struct
+{
+	float x; // left edge relative to the window width
+	float y; // top edge relative to the window height
+	float w; // width relative to the window width
+	float h; // height relative to the window height
+} Viewport;
+
+/**
+ * Struct for one first-person view of the maze: a pose, the part of the window it is shown in and the per-view
+ * rendering state. Cameras only read the map, so any number of them can be rendered from the same maze.
+ */
+typedef struct Camera_struct
+{
+	Vec3 position;            // camera position vector
+	Vec3 direction;           // camera direction vector, this is always a unit vector
+	float fieldOfView;        // field of view in radians
+	Viewport viewport;        // part of the window the camera is shown in
+	int isEnabled;            // 1 if the camera is rendered, 0 otherwise
+	int followsPlayer;        // 1 if the pose is copied from the player before each frame
+	int maxRays;              // capacity of the ray arrays, which is also the maximum render width of this camera
+	int numRays;              // the number of rays cast within the field of view, one per frame buffer column
+	Vec3* rays;               // the intersections between the rays cast by the camera and walls
+	float* rayHeights;        // the height of the wall column of each ray in this view
+	float* rayDistances;      // the perpendicular distance of each ray
+	RaySpan* raySpans;        // RAY_MAX_SPANS surfaces per ray seen over the low wall or through the window it hit
+	int* rayNumSpans;         // the number of spans of each ray, 0 if the ray did not hit a low wall or a window
+	FrameBuffer* frameBuffer; // software frame buffer holding this view
+	FrameBuffer* presentedFrameBuffer; // frame buffer holding the previous view while the next one is rendered, NULL
+									   // unless double buffered
+	FloorCaster* floorCaster; // floor and ceiling caster writing into the frame buffer
+	WallRenderFrame wallFrame; // wall drawing parameters of the current frame
+	SpriteRenderFrame spriteFrame; // sprites projected into the current frame and their drawing parameters
+} Camera;
+
+/**
+ * Creates a camera. The render resolution is the given full-window internal resolution scaled by the viewport size.
+ *
+ * @param viewport 	   the part of the window the camera is shown in
+ * @param fieldOfView  the field of view in radians
+ * @param windowWidth  the maximum internal render width of a camera covering the whole window
+ * @param windowHeight the internal render height of a camera covering the whole window
+ * @param mapCellSize  the size of each cell in the map grid, one floor texture tile covers one cell
+ * @param shadingTable the lighting and fog lookup tables, not owned by the camera
+ * @return the camera
+ */
+Camera* CreateCamera(Viewport viewport, float fieldOfView, int windowWidth, int windowHeight, float mapCellSize,
+		const ShadingTable* shadingTable);
+
+/**
+ * Frees the memory allocated for the given camera.
+ *
+ * @param camera the given camera
+ */
+void DestroyCamera(Camera* camera);
+
+/**
+ * Sets the render width of the camera from the internal render width of the whole window, scaled by the viewport
+ * width. One ray is cast per column of the frame buffer.
+ *
+ * @param camera 	  the camera
+ * @param windowWidth the internal render width of the whole window
+ */
+void SetCameraRenderWidth(Camera* camera, int windowWidth);
+
+/**
+ * Gives the camera a second frame buffer, so the previous view can be presented while the next one is rendered into
+ * the first. Does nothing if the camera is already double buffered.
+ *
+ * @param camera the camera
+ */
+void EnableCameraDoubleBuffering(Camera* camera);
+
+/**
+ * Swaps the frame buffer just rendered into with the presented one, which is resized to the current render width and
+ * rendered into next.
+ *
+ * @param camera the camera, it must be double buffered
+ */
+void SwapCameraFrameBuffers(Camera* camera);
+
+#endif
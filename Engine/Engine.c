@@ -0,0 +1,666 @@
+#include <stdlib.h>
+#include <time.h>
+#include "Engine.h"
+#include "../Utils/RayCaster/RayCaster.h"
+#include "../Utils/WallRenderer/WallRenderer.h"
+#include "../Utils/SpriteRenderer/SpriteRenderer.h"
+#include "../Utils/Collision/Collision.h"
+#include "../Utils/ErrorHandler/ErrorHandler.h"
+#include "../Utils/Assert/Assert.h"
+
+/**
+ * Places the player at the top-left cell of the maze facing right.
+ *
+ * @param engine the engine
+ */
+static void PlacePlayerAtStart(Engine* engine)
+{
+	// Direction vector is always a unit vector
+	engine->player.position = V3(engine->map.cellSize + 1.0f, engine->map.cellSize + 1.0f, 0.0f);
+	engine->player.direction = V3(1.0f, 0.0f, 0.0f);
+}
+
+/**
+ * Inserts the active entities into the entity grid, which must be empty.
+ *
+ * @param engine the engine
+ */
+static void IndexEntities(Engine* engine)
+{
+	for (int i = 0; i < engine->entities->numEntities; ++i)
+	{
+		if (engine->entities->entities[i].isActive)
+		{InsertSpatialHashItem(engine->entityGrid, i, V3XY(engine->entities->entities[i].position));}
+	}
+}
+
+/**
+ * Creates a game instance. The maze size and seed, door, low wall and window intervals, field of view, step size and
+ * internal resolution are taken from the configuration. The player starts at the top-left cell of the maze facing right.
+ *
+ * @param config 	 the runtime configuration
+ * @param atlas 	 the wall textures, shared and not owned by the engine
+ * @param workerPool the worker threads used for rendering, not owned by the engine, may be NULL
+ * @return the engine
+ */
+Engine* CreateEngine(const Config* config, const TextureAtlas* atlas, WorkerPool* workerPool)
+{
+	RCM_ASSERT_NOT_NULL(config);
+	RCM_ASSERT_NOT_NULL(atlas);
+	Engine* engine = (Engine*)calloc(1, sizeof(Engine));
+	if (engine == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	engine->atlas = atlas;
+	engine->workerPool = workerPool;
+	// Initializes map and the rectangles representing walls. A seed of 0 picks a new maze each run, the seed used is
+	// kept in the map so the session can be reproduced with --seed.
+	uint32_t seed = config->seed != 0 ? (uint32_t)config->seed : (uint32_t)(time(NULL) % INT32_MAX) + 1u;
+	CreateMap(&engine->map, config->mazeSize, ENGINE_MAP_CELL_SIZE, seed);
+	// Doors are placed from the maze seed as well, before the goal distances that count them as open cells
+	engine->doorInterval = config->doorInterval;
+	if (engine->doorInterval > 0)
+	{PlaceMapDoors(&engine->map, engine->doorInterval, seed);}
+	engine->lowWallInterval = config->lowWallInterval;
+	if (engine->lowWallInterval > 0)
+	{PlaceMapLowWalls(&engine->map, engine->lowWallInterval, seed);}
+	engine->windowInterval = config->windowInterval;
+	if (engine->windowInterval > 0)
+	{PlaceMapWindows(&engine->map, engine->windowInterval, seed);}
+	CreateMapGoalDistances(&engine->map);
+	PlacePlayerAtStart(engine);
+	engine->player.fieldOfView = config->fieldOfView;
+	engine->player.stepScalar = config->stepScalar;
+	// One ray is cast per frame buffer column, so the ray count is the maximum internal width
+	engine->maxRenderWidth = config->numRays > 0 ? config->numRays :
+			(int)((float)config->windowWidth * config->renderScale);
+	engine->renderHeight = (int)((float)config->windowHeight * config->renderScale);
+	// Creates the lighting and fog lookup tables
+	engine->shadingTable = CreateShadingTable(ENGINE_FOG_START_CELLS * engine->map.cellSize,
+			ENGINE_FOG_END_CELLS * engine->map.cellSize, ENGINE_FOG_GRAY);
+	// The player camera covers the whole window
+	Viewport fullWindow = {0.0f, 0.0f, 1.0f, 1.0f};
+	Camera* playerCamera = AddEngineCamera(engine, fullWindow);
+	playerCamera->followsPlayer = 1;
+	SetEngineRenderWidth(engine, engine->maxRenderWidth);
+	// The rays of the player camera list the cells they pass through, which are gathered into the visible cells
+	engine->visibleCells = CreateVisibilitySet(engine->map.size * engine->map.size);
+	engine->rayCrossedCells = (int*)calloc((size_t)playerCamera->maxRays * RAY_MAX_CROSSED_CELLS, sizeof(int));
+	engine->rayNumCrossedCells = (int*)calloc(playerCamera->maxRays, sizeof(int));
+	if (engine->rayCrossedCells == NULL || engine->rayNumCrossedCells == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	// Entities are placed from the maze seed, so a session reproduced with --seed has the same entities
+	engine->entities = CreateEntityList(ENGINE_MAX_ENTITIES);
+	engine->spriteAtlas = CreateSpriteAtlas();
+	SpawnMazeEntities(engine->entities, &engine->map, seed);
+	engine->entityGrid = CreateSpatialHash(engine->map.size, engine->map.cellSize, ENGINE_MAX_ENTITIES);
+	IndexEntities(engine);
+	return engine;
+}
+
+/**
+ * Frees the memory allocated for the given engine. The texture atlas and the worker pool are not freed.
+ *
+ * @param engine the given engine
+ */
+void DestroyEngine(Engine* engine)
+{
+	if (engine == NULL)
+	{return;}
+	DestroyMap(&engine->map);
+	for (int i = 0; i < engine->numCameras; ++i)
+	{DestroyCamera(engine->cameras[i]);}
+	DestroyShadingTable(engine->shadingTable);
+	DestroyVisibilitySet(engine->visibleCells);
+	free(engine->rayCrossedCells);
+	free(engine->rayNumCrossedCells);
+	DestroyEntityList(engine->entities);
+	DestroySpatialHash(engine->entityGrid);
+	DestroyTextureAtlas(engine->spriteAtlas);
+	free(engine);
+}
+
+/**
+ * Starts a new game in the engine: generates a new maze of the same size, door, low wall and window intervals from the
+ * given seed, places the player back at the start and spawns new entities. The cameras, the render resolution and the
+ * shading tables are kept.
+ *
+ * @param engine the engine
+ * @param seed 	 the seed of the new maze, must not be 0
+ */
+void ResetEngine(Engine* engine, uint32_t seed)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	RCM_ASSERT(seed != 0, INVALID_CONFIGURATION_ERROR);
+	int size = engine->map.size;
+	float cellSize = engine->map.cellSize;
+	DestroyMap(&engine->map);
+	CreateMap(&engine->map, size, cellSize, seed);
+	if (engine->doorInterval > 0)
+	{PlaceMapDoors(&engine->map, engine->doorInterval, seed);}
+	if (engine->lowWallInterval > 0)
+	{PlaceMapLowWalls(&engine->map, engine->lowWallInterval, seed);}
+	if (engine->windowInterval > 0)
+	{PlaceMapWindows(&engine->map, engine->windowInterval, seed);}
+	CreateMapGoalDistances(&engine->map);
+	PlacePlayerAtStart(engine);
+	engine->hasWon = 0;
+	engine->numMovingDoors = 0;
+	// The new maze has the same size, so the visible cell set is kept and only emptied
+	ClearVisibilitySet(engine->visibleCells);
+	ClearEntityList(engine->entities);
+	SpawnMazeEntities(engine->entities, &engine->map, seed);
+	ClearSpatialHash(engine->entityGrid);
+	IndexEntities(engine);
+	engine->numItemsCollected = 0;
+}
+
+/**
+ * Sets the internal render width of a view covering the whole window, each camera renders the part covered by its
+ * viewport. One ray is cast per column of a camera's frame buffer.
+ *
+ * @param engine the engine
+ * @param width  the internal render width, at most maxRenderWidth
+ */
+void SetEngineRenderWidth(Engine* engine, int width)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	RCM_ASSERT(width > 0 && width <= engine->maxRenderWidth, INVALID_CONFIGURATION_ERROR);
+	engine->renderWidth = width;
+	for (int i = 0; i < engine->numCameras; ++i)
+	{SetCameraRenderWidth(engine->cameras[i], width);}
+}
+
+/**
+ * Adds a camera viewing the maze of the engine. The camera starts at the player's pose with the player's field of view
+ * and does not follow the player, its pose is set by the caller.
+ *
+ * @param engine   the engine
+ * @param viewport the part of the window the camera is shown in
+ * @return the camera, owned by the engine
+ */
+Camera* AddEngineCamera(Engine* engine, Viewport viewport)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	RCM_ASSERT(engine->numCameras < ENGINE_MAX_CAMERAS, INVALID_CONFIGURATION_ERROR);
+	Camera* camera = CreateCamera(viewport, engine->player.fieldOfView, engine->maxRenderWidth, engine->renderHeight,
+			engine->map.cellSize, engine->shadingTable);
+	camera->position = engine->player.position;
+	camera->direction = engine->player.direction;
+	if (engine->renderWidth > 0)
+	{SetCameraRenderWidth(camera, engine->renderWidth);}
+	if (engine->isDoubleBuffered)
+	{EnableCameraDoubleBuffering(camera);}
+	engine->cameras[engine->numCameras++] = camera;
+	return camera;
+}
+
+/**
+ * Gives every camera of the engine, including the ones added later, a second frame buffer. The views of a frame can
+ * then be presented from the second frame buffers after SwapEngineFrameBuffers() while the next frame is rendered.
+ *
+ * @param engine the engine
+ */
+void EnableEngineDoubleBuffering(Engine* engine)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	engine->isDoubleBuffered = 1;
+	for (int i = 0; i < engine->numCameras; ++i)
+	{EnableCameraDoubleBuffering(engine->cameras[i]);}
+}
+
+/**
+ * Swaps the frame buffers of the cameras rendered in the last RenderEngineFrame() call, so their views are in the
+ * presented frame buffers and the next frame is rendered into the other ones. The frame buffers of the other cameras
+ * are left as they are, their presented frame buffers hold an older view.
+ *
+ * @param engine the engine, it must be double buffered
+ */
+void SwapEngineFrameBuffers(Engine* engine)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	RCM_ASSERT(engine->isDoubleBuffered, INVALID_CONFIGURATION_ERROR);
+	for (int i = 0; i < engine->numFrameCameras; ++i)
+	{SwapCameraFrameBuffers(engine->frameCameras[i]);}
+}
+
+/**
+ * Adds an entity to the maze of the engine.
+ *
+ * @param engine   the engine, its entity list must not be full
+ * @param type 	   ENTITY_TYPE_ITEM or ENTITY_TYPE_ENEMY
+ * @param position the position of the entity
+ * @return the entity, owned by the engine
+ */
+Entity* AddEngineEntity(Engine* engine, int type, Vec3 position)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	Entity* entity = AddEntity(engine->entities, type, position);
+	InsertSpatialHashItem(engine->entityGrid, (int)(entity - engine->entities->entities), V3XY(position));
+	return entity;
+}
+
+/**
+ * Picks up the items the player's bounding box overlaps. Only the entities of the cells around the player are tested,
+ * found through the entity grid. Enemies do not block the player.
+ *
+ * @param engine the engine
+ */
+static void CollectTouchedItems(Engine* engine)
+{
+	const Player* player = &engine->player;
+	// An entity footprint is smaller than a cell, so entities touching the player are in the cells overlapped by the
+	// player's box grown by one cell
+	int nearEntities[ENGINE_MAX_TOUCHED_ENTITIES];
+	int numNear = QuerySpatialHash(engine->entityGrid, V3XY(player->position), PLAYER_RECT_SIZE + engine->map.cellSize,
+			nearEntities, ENGINE_MAX_TOUCHED_ENTITIES);
+	Rect playerBox = {player->position.x - PLAYER_RECT_SIZE / 2, player->position.y - PLAYER_RECT_SIZE / 2,
+			PLAYER_RECT_SIZE, PLAYER_RECT_SIZE};
+	for (int i = 0; i < numNear; ++i)
+	{
+		Entity* entity = &engine->entities->entities[nearEntities[i]];
+		if (entity->type != ENTITY_TYPE_ITEM)
+		{continue;}
+		float size = entity->scale * engine->map.cellSize * ENTITY_FOOTPRINT_SCALE;
+		Rect entityBox = {entity->position.x - size / 2, entity->position.y - size / 2, size, size};
+		if (AABBCollisionTest(&playerBox, &entityBox))
+		{
+			entity->isActive = 0;
+			RemoveSpatialHashItem(engine->entityGrid, nearEntities[i]);
+			++engine->numItemsCollected;
+		}
+	}
+}
+
+/**
+ * Opens the doors in the cell of the player and the cells around it, and closes the other doors, by
+ * ENGINE_DOOR_OPENING_STEP each tick. A door opens well before the player reaches its panel and never closes on the
+ * player. Only the doors around the player and the doors not closed yet are visited, they are kept in a short list.
+ *
+ * @param engine the engine
+ */
+static void UpdateEngineDoors(Engine* engine)
+{
+	Map* map = &engine->map;
+	if (map->numDoors == 0)
+	{return;}
+	int playerCell = GetPlayerCellIndex(&engine->player.position, map->cellSize, map->size);
+	int playerX = playerCell % map->size;
+	int playerY = playerCell / map->size;
+	for (int y = playerY - 1; y <= playerY + 1; ++y)
+	{
+		for (int x = playerX - 1; x <= playerX + 1; ++x)
+		{
+			int cell = y * map->size + x;
+			if (x < 0 || x >= map->size || y < 0 || y >= map->size || !IsDoor(map->cells[cell]))
+			{continue;}
+			int isListed = 0;
+			for (int i = 0; i < engine->numMovingDoors && !isListed; ++i)
+			{isListed = engine->movingDoors[i] == cell;}
+			if (!isListed && engine->numMovingDoors < ENGINE_MAX_MOVING_DOORS)
+			{engine->movingDoors[engine->numMovingDoors++] = cell;}
+		}
+	}
+	for (int i = 0; i < engine->numMovingDoors;)
+	{
+		int cell = engine->movingDoors[i];
+		int isNear = abs(cell % map->size - playerX) <= 1 && abs(cell / map->size - playerY) <= 1;
+		int opening = GetDoorOpening(map->cells[cell]) + (isNear ? ENGINE_DOOR_OPENING_STEP : -ENGINE_DOOR_OPENING_STEP);
+		opening = opening < 0 ? 0 : opening > DOOR_OPENING_MAX ? DOOR_OPENING_MAX : opening;
+		SetMapDoorOpening(map, cell, opening);
+		// A closed door away from the player leaves the list, the last door takes its place
+		if (!isNear && opening == 0)
+		{engine->movingDoors[i] = engine->movingDoors[--engine->numMovingDoors];}
+		else
+		{++i;}
+	}
+}
+
+/**
+ * Advances the game by one frame. The doors around the player open and the others close, the player turns and moves
+ * as requested by the input, the items the player walks into are picked up, the cell the player is in is marked as
+ * visited and the winning condition is checked. Once the game is won, the input is ignored and the player turns
+ * slowly.
+ *
+ * @param engine the engine
+ * @param input  the movements requested for this frame
+ */
+void UpdateEngine(Engine* engine, const PlayerInput* input)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	RCM_ASSERT_NOT_NULL(input);
+	Map* map = &engine->map;
+	Player* player = &engine->player;
+	if (engine->hasWon)
+	{
+		player->direction = V3Rotate(player->direction, ENGINE_END_STATE_TURNING_ANGLE);
+		return;
+	}
+	UpdateEngineDoors(engine);
+	UpdatePlayerPosition(input, &player->position, &player->direction, player->stepScalar, PLAYER_RECT_SIZE,
+			PLAYER_TURNING_ANGLE, map->wallRects, map->wallRectsLength);
+	CollectTouchedItems(engine);
+	// Marks the cell where the player is currently located as visited, only the first visit writes to the map
+	int playerCellIndex = GetPlayerCellIndex(&player->position, map->cellSize, map->size);
+	MarkMapCellVisited(map, playerCellIndex);
+	// The game is won if player reaches the bottom-right cell of the maze
+	if (playerCellIndex == GetMapGoalCellIndex(map))
+	{engine->hasWon = 1;}
+}
+
+/**
+ * Copies the player's pose to the cameras following the player.
+ *
+ * @param engine the engine
+ */
+static void SyncPlayerCameras(Engine* engine)
+{
+	for (int i = 0; i < engine->numCameras; ++i)
+	{
+		Camera* camera = engine->cameras[i];
+		if (camera->followsPlayer)
+		{
+			camera->position = engine->player.position;
+			camera->direction = engine->player.direction;
+			camera->fieldOfView = engine->player.fieldOfView;
+		}
+	}
+}
+
+/**
+ * Gathers the cells listed by the rays of the player camera into the visible cell set. The rays were cast in parallel,
+ * each into its own part of the crossed cell arrays, and are merged here on one thread. Neighboring rays pass through
+ * mostly the same cells, the set keeps one copy of each.
+ *
+ * @param engine the engine
+ */
+static void GatherVisibleCells(Engine* engine)
+{
+	VisibilitySet* visibleCells = engine->visibleCells;
+	const Camera* camera = engine->cameras[ENGINE_PLAYER_CAMERA];
+	ClearVisibilitySet(visibleCells);
+	for (int i = 0; i < camera->numRays; ++i)
+	{
+		const int* cells = engine->rayCrossedCells + i * RAY_MAX_CROSSED_CELLS;
+		for (int j = 0; j < engine->rayNumCrossedCells[i]; ++j)
+		{AddVisibleCell(visibleCells, cells[j]);}
+	}
+}
+
+/**
+ * Casts the rays within the player's field of view into the ray array of the player camera and gathers the cells
+ * they pass through into the visible cells.
+ *
+ * @param engine 	   the engine
+ * @param maxRayLength the length after which the traversal stops, RAY_UNLIMITED_LENGTH to only stop at walls
+ */
+void CastEngineRays(Engine* engine, float maxRayLength)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	SyncPlayerCameras(engine);
+	Camera* camera = engine->cameras[ENGINE_PLAYER_CAMERA];
+	CastRays(V3XY(camera->position), V3XY(camera->direction), engine->map.cellSize, engine->map.cells,
+			engine->map.size, NULL, camera->fieldOfView, camera->numRays, maxRayLength, camera->rays,
+			engine->rayCrossedCells, engine->rayNumCrossedCells);
+	GatherVisibleCells(engine);
+}
+
+/**
+ * Work done on the range [begin, end) of the columns or rows of one camera.
+ */
+typedef void (*CameraRangeTask)(const Engine* engine, Camera* camera, int begin, int end);
+
+/**
+ * Splits the range [begin, end) of the combined columns or rows of all cameras of the current frame at the camera
+ * boundaries and runs the task on each part with camera-local indices.
+ *
+ * @param engine  the engine
+ * @param offsets the first combined index of each camera of the current frame, followed by the total count
+ * @param begin   the first combined index
+ * @param end 	  one past the last combined index
+ * @param task 	  the work done on each part
+ */
+static void RunOnFrameCameras(const Engine* engine, const int offsets[], int begin, int end, CameraRangeTask task)
+{
+	int camera = 0;
+	while (begin >= offsets[camera + 1])
+	{++camera;}
+	while (begin < end)
+	{
+		int cameraEnd = end < offsets[camera + 1] ? end : offsets[camera + 1];
+		task(engine, engine->frameCameras[camera], begin - offsets[camera], cameraEnd - offsets[camera]);
+		begin = cameraEnd;
+		++camera;
+	}
+}
+
+/**
+ * Casts the rays [begin, end) of a camera up to the fog distance and calculates their heights and distances. Rays that
+ * hit a low wall or a window are followed further to list the surfaces seen over or through it.
+ */
+static void CastCameraRays(const Engine* engine, Camera* camera, int begin, int end)
+{
+	Vec2 position = V3XY(camera->position);
+	Vec2 direction = V3XY(camera->direction);
+	// Only the rays of the player camera list the cells they pass through
+	int isPlayerCamera = camera == engine->cameras[ENGINE_PLAYER_CAMERA];
+	// In a maze every open cell touches a wall, so there is no empty space to skip and rays step one cell at a time
+	CastRaysInRange(position, direction, engine->map.cellSize, engine->map.cells, engine->map.size, NULL,
+			camera->fieldOfView, camera->numRays, begin, end, engine->shadingTable->fogDistance, camera->rays,
+			isPlayerCamera ? engine->rayCrossedCells : NULL, isPlayerCamera ? engine->rayNumCrossedCells : NULL);
+	CalculateRayHeights(camera->rays + begin, position, direction, end - begin, (float)camera->frameBuffer->height,
+			camera->rayHeights + begin, camera->rayDistances + begin);
+	if (!CanSeePastMapWalls(&engine->map))
+	{return;}
+	for (int i = begin; i < end; ++i)
+	{
+		camera->rayNumSpans[i] = TraceRaySpans(position, direction, camera->rays[i], camera->rayDistances[i],
+				engine->map.cellSize, &engine->map, engine->shadingTable->fogDistance,
+				camera->raySpans + (size_t)i * RAY_MAX_SPANS,
+				isPlayerCamera ? engine->rayCrossedCells + i * RAY_MAX_CROSSED_CELLS : NULL,
+				isPlayerCamera ? &engine->rayNumCrossedCells[i] : NULL);
+	}
+}
+
+/**
+ * Draws the columns [begin, end) of a camera: the walls with the floor and the ceiling around them, then the sprites
+ * over them while the band is still in the cache.
+ */
+static void DrawCameraColumns(const Engine* engine, Camera* camera, int begin, int end)
+{
+	(void)engine;
+	DrawWallColumns(begin, end, &camera->wallFrame);
+	DrawSpriteColumns(begin, end, &camera->spriteFrame);
+}
+
+/**
+ * Worker pool task casting the rays of the combined columns [begin, end).
+ */
+static void CastFrameRays(int begin, int end, void* engine)
+{
+	const Engine* e = (const Engine*)engine;
+	RunOnFrameCameras(e, e->columnOffsets, begin, end, CastCameraRays);
+}
+
+/**
+ * Worker pool task drawing the walls, floor, ceiling and sprites of the combined columns [begin, end).
+ */
+static void DrawFrameColumns(int begin, int end, void* engine)
+{
+	const Engine* e = (const Engine*)engine;
+	RunOnFrameCameras(e, e->columnOffsets, begin, end, DrawCameraColumns);
+}
+
+/**
+ * Projects the active entities into the sprite frame of a camera and sorts them from the farthest to the nearest. The
+ * player camera only visits the entities of the cells its rays passed through, taken from the entity grid: an entity
+ * stands inside its cell, so a ray reaching the entity before a wall crosses the cell, and the cost follows the visible
+ * part of the maze rather than the number of entities.
+ *
+ * @param engine the engine
+ * @param camera the camera, its rays are already cast
+ */
+static void ProjectCameraSprites(const Engine* engine, Camera* camera)
+{
+	SpriteRenderFrame* frame = &camera->spriteFrame;
+	frame->target = camera->frameBuffer;
+	frame->distances = camera->rayDistances;
+	frame->spans = camera->raySpans;
+	frame->numSpans = CanSeePastMapWalls(&engine->map) ? camera->rayNumSpans : NULL;
+	frame->numRays = camera->numRays;
+	frame->fieldOfView = camera->fieldOfView;
+	frame->mapCellSize = engine->map.cellSize;
+	frame->atlas = engine->spriteAtlas;
+	frame->shadingTable = engine->shadingTable;
+	ReserveSprites(frame, engine->entities->numEntities);
+	int isPlayerCamera = camera == engine->cameras[ENGINE_PLAYER_CAMERA];
+	Vec2 position = V3XY(camera->position);
+	Vec2 direction = V3XY(camera->direction);
+	if (isPlayerCamera)
+	{
+		const VisibilitySet* visibleCells = engine->visibleCells;
+		for (int i = 0; i < visibleCells->numVisible; ++i)
+		{
+			int item = GetFirstSpatialHashItem(engine->entityGrid, visibleCells->cells[i]);
+			for (; item != SPATIAL_HASH_NONE; item = GetNextSpatialHashItem(engine->entityGrid, item))
+			{
+				const Entity* entity = &engine->entities->entities[item];
+				ProjectSprite(frame, position, direction, V3XY(entity->position), entity->texture, entity->scale);
+			}
+		}
+	}
+	else
+	{
+		for (int i = 0; i < engine->entities->numEntities; ++i)
+		{
+			const Entity* entity = &engine->entities->entities[i];
+			if (entity->isActive)
+			{ProjectSprite(frame, position, direction, V3XY(entity->position), entity->texture, entity->scale);}
+		}
+	}
+	SortSprites(frame);
+}
+
+/**
+ * Renders the views of all enabled cameras into their frame buffers: casts the rays up to the fog distance, then draws
+ * each column from top to bottom in one pass, the walls with the floor and the ceiling in the rows they leave open, and
+ * the entity sprites over them. Each pixel of the floor, ceiling and walls is written once. Both steps are one parallel
+ * loop over the columns of all views combined, so a small view does not leave worker threads idle while a large one is
+ * still being drawn.
+ *
+ * @param engine the engine
+ */
+void RenderEngineFrame(Engine* engine)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	SyncPlayerCameras(engine);
+	// Lists the enabled cameras and where their columns start in the combined range
+	engine->numFrameCameras = 0;
+	engine->columnOffsets[0] = 0;
+	for (int i = 0; i < engine->numCameras; ++i)
+	{
+		Camera* camera = engine->cameras[i];
+		if (!camera->isEnabled)
+		{continue;}
+		// Floor row setup depends only on the pose, so it is done once per camera before the parallel loops
+		PrepareFloorCasterFrame(camera->floorCaster, camera->frameBuffer, &camera->position, &camera->direction,
+				camera->fieldOfView);
+		WallRenderFrame* frame = &camera->wallFrame;
+		frame->target = camera->frameBuffer;
+		frame->intersections = camera->rays;
+		frame->distances = camera->rayDistances;
+		frame->spans = camera->raySpans;
+		frame->numSpans = CanSeePastMapWalls(&engine->map) ? camera->rayNumSpans : NULL;
+		frame->numRays = camera->numRays;
+		frame->mapCellSize = engine->map.cellSize;
+		frame->mapSize = engine->map.size;
+		frame->cells = engine->map.cells;
+		frame->atlas = engine->atlas;
+		frame->doorAtlas = engine->spriteAtlas;
+		frame->shadingTable = engine->shadingTable;
+		frame->floorCaster = camera->floorCaster;
+		int n = engine->numFrameCameras++;
+		engine->frameCameras[n] = camera;
+		engine->columnOffsets[n + 1] = engine->columnOffsets[n] + camera->numRays;
+	}
+	int numColumns = engine->columnOffsets[engine->numFrameCameras];
+	// Walls beyond the fog distance are invisible, so the fog distance bounds the ray traversal
+	RunParallelFor(engine->workerPool, numColumns, ENGINE_RAY_BAND_SIZE, CastFrameRays, engine);
+	if (engine->cameras[ENGINE_PLAYER_CAMERA]->isEnabled)
+	{GatherVisibleCells(engine);}
+	else
+	{ClearVisibilitySet(engine->visibleCells);}
+	// Sprites are projected once the rays are cast, then depth tested against the wall distance of each column
+	for (int i = 0; i < engine->numFrameCameras; ++i)
+	{ProjectCameraSprites(engine, engine->frameCameras[i]);}
+	// Walls, floor and ceiling are drawn in column bands, and the sprites over each band right after
+	RunParallelFor(engine->workerPool, numColumns, ENGINE_WALL_COLUMN_BAND_SIZE, DrawFrameColumns, engine);
+}
+
+/**
+ * Reports the cells whose value changed since the last call, such as the doors that moved, and forgets them, so a view
+ * of the maze can be updated with work proportional to what changed.
+ *
+ * @param engine 	the engine
+ * @param onChanged the function called for each changed cell, may be NULL
+ * @param context 	the context passed to the callback
+ */
+void ConsumeEngineCellChanges(Engine* engine, CellChangedCallback onChanged, void* context)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	Map* map = &engine->map;
+	for (int i = 0; i < map->numChangedCells && onChanged != NULL; ++i)
+	{onChanged(map->changedCells[i], context);}
+	ClearMapChangedCells(map);
+}
+
+/**
+ * Gets the index of the cell whose wall is pointed by the player's crosshair.
+ *
+ * @param engine the engine
+ * @return the index of the pointed cell
+ */
+int GetEnginePointedCellIndex(const Engine* engine)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	const Player* player = &engine->player;
+	Vec3 intersection = CastRay(V3XY(player->position), V3XY(player->direction), engine->map.cellSize,
+			engine->map.cells, engine->map.size, NULL, RAY_UNLIMITED_LENGTH, NULL, NULL);
+	return GetPointedNonWallCellIndex(&intersection, &player->direction, engine->map.cellSize, engine->map.size);
+}
+
+/**
+ * Checks if a cell was in the player's view in the last CastEngineRays() or RenderEngineFrame() call: the cell the
+ * player is in, the open cells the rays of the player camera passed through and the walls they hit.
+ *
+ * @param engine the engine
+ * @param cell 	 the index of the cell
+ * @return 1 if the cell is visible, 0 otherwise
+ */
+int IsEngineCellVisible(const Engine* engine, int cell)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	RCM_ASSERT(cell >= 0 && cell < engine->map.size * engine->map.size, UNKNOWN_ERROR);
+	return IsCellVisible(engine->visibleCells, cell);
+}
+
+/**
+ * Marks the cells in the player's view as seen: the cell the player is in, the walls hit by the rays of the player
+ * camera and the open cells the rays cross. The visible cells of the last CastEngineRays() or RenderEngineFrame() call
+ * are used. The callback is only called for cells seen for the first time, so a view of the explored part of the maze
+ * can be updated with work proportional to what was discovered.
+ *
+ * @param engine 	 the engine
+ * @param onRevealed the function called for each newly seen cell, may be NULL
+ * @param context 	 the context passed to the callback
+ */
+void RevealEngineView(Engine* engine, CellRevealedCallback onRevealed, void* context)
+{
+	RCM_ASSERT_NOT_NULL(engine);
+	Map* map = &engine->map;
+	const VisibilitySet* visibleCells = engine->visibleCells;
+	for (int i = 0; i < visibleCells->numVisible; ++i)
+	{
+		if (MarkMapCellSeen(map, visibleCells->cells[i]) && onRevealed != NULL)
+		{onRevealed(visibleCells->cells[i], context);}
+	}
+}
@@ -0,0 +1,221 @@
+#ifndef RAY_CASTING_MAZE_ENGINE_H_
+#define RAY_CASTING_MAZE_ENGINE_H_
+
+#define ENGINE_MAP_CELL_SIZE 32.0f           // cell size in map grid
+#define ENGINE_FOG_START_CELLS 3.0f          // distance in cells at which the fog starts
+#define ENGINE_FOG_END_CELLS 10.0f           // distance in cells at which surfaces are fully fogged
+#define ENGINE_FOG_GRAY 16                   // gray value of the fog
+#define ENGINE_WALL_COLUMN_BAND_SIZE 16      // number of frame buffer columns claimed at a time by a worker thread
+#define ENGINE_RAY_BAND_SIZE 32              // number of rays claimed at a time by a worker thread
+#define ENGINE_END_STATE_TURNING_ANGLE 0.01f // angle the player turns by each frame after the game is won
+#define ENGINE_MAX_CAMERAS 8                 // maximum number of cameras rendered by one engine
+#define ENGINE_PLAYER_CAMERA 0               // index of the camera that follows the player
+#define ENGINE_MAX_ENTITIES 1024             // maximum number of entities in one game instance
+#define ENGINE_MAX_TOUCHED_ENTITIES 64       // maximum number of entities near the player tested for contact each tick
+#define ENGINE_DOOR_OPENING_STEP 8           // change in the opening of a moving door per tick
+#define ENGINE_MAX_MOVING_DOORS 64           // maximum number of doors that are not closed or are near the player
+
+#include "../Map/Map.h"
+#include "../Player/Player.h"
+#include "../Camera/Camera.h"
+#include "../Entity/Entity.h"
+#include "../Utils/Config/Config.h"
+#include "../Utils/Shading/Shading.h"
+#include "../Utils/TextureAtlas/TextureAtlas.h"
+#include "../Utils/WorkerPool/WorkerPool.h"
+#include "../Utils/VisibilitySet/VisibilitySet.h"
+#include "../Utils/SpatialHash/SpatialHash.h"
+
+/**
+ * Function called for each cell that enters the player's view for the first time.
+ */
+typedef void (*CellRevealedCallback)(int cell, void* context);
+
+/**
+ * Function called for each cell whose value changed, such as a door that moved.
+ */
+typedef void (*CellChangedCallback)(int cell, void* context);
+
+/**
+ * Struct for one game instance: the map, the player and the cameras viewing the maze. All state lives in the engine,
+ * so several engines can run in one process, each driven by its own thread. The first camera follows the player,
+ * further cameras (split-screen, spectator or monitor views) are added with AddEngineCamera() and rendered from the same
+ * map in the same frame. The wall texture atlas and the worker pool are not owned by the engine. The atlas is read-only
+ * and can be shared by all engines, a worker pool must only be used by one thread at a time.
+ */
+typedef struct Engine_struct
+{
+	Map map;
+	Player player;
+	int hasWon;                 // 1 once the player reached the bottom-right cell of the maze
+	int maxRenderWidth;         // maximum internal render width of a view covering the whole window
+	int renderWidth;            // current internal render width of a view covering the whole window
+	int renderHeight;           // internal render height of a view covering the whole window
+	int isDoubleBuffered;       // 1 if every camera has a second frame buffer, see EnableEngineDoubleBuffering()
+	int numCameras;             // number of cameras, at most ENGINE_MAX_CAMERAS
+	Camera* cameras[ENGINE_MAX_CAMERAS]; // the cameras, cameras[ENGINE_PLAYER_CAMERA] follows the player
+	int numFrameCameras;        // number of cameras rendered in the current frame
+	Camera* frameCameras[ENGINE_MAX_CAMERAS];   // enabled cameras of the current frame
+	int columnOffsets[ENGINE_MAX_CAMERAS + 1];  // first column of each enabled camera when all columns are combined
+	ShadingTable* shadingTable; // distance attenuation and fog lookup tables
+	const TextureAtlas* atlas;  // wall textures, not owned
+	WorkerPool* workerPool;     // worker threads used to split per-frame work, not owned, NULL to render serially
+	VisibilitySet* visibleCells; // cells the rays of the player camera passed through in the last cast
+	int* rayCrossedCells;       // RAY_MAX_CROSSED_CELLS cells per ray of the player camera, listed by the ray casts
+	int* rayNumCrossedCells;    // number of cells listed for each ray of the player camera
+	EntityList* entities;       // items and enemies in the maze, drawn as sprites
+	SpatialHash* entityGrid;    // the active entities bucketed by map cell
+	TextureAtlas* spriteAtlas;  // sprite textures of the entities
+	int numItemsCollected;      // number of items the player picked up
+	int doorInterval;           // average number of corridor cells per door, 0 for no doors
+	int lowWallInterval;        // average number of inner walls per low wall, 0 for full walls only
+	int windowInterval;         // average number of walls between two corridors per window, 0 for no windows
+	int numMovingDoors;         // number of doors in movingDoors
+	int movingDoors[ENGINE_MAX_MOVING_DOORS]; // cells of the doors that are open or near the player, the others are
+											  // closed and stay closed
+} Engine;
+
+/**
+ * Creates a game instance. The maze size and seed, door, low wall and window intervals, field of view, step size and
+ * internal resolution are taken from the configuration. The player starts at the top-left cell of the maze facing right.
+ *
+ * @param config 	 the runtime configuration
+ * @param atlas 	 the wall textures, shared and not owned by the engine
+ * @param workerPool the worker threads used for rendering, not owned by the engine, may be NULL
+ * @return the engine
+ */
+Engine* CreateEngine(const Config* config, const TextureAtlas* atlas, WorkerPool* workerPool);
+
+/**
+ * Frees the memory allocated for the given engine. The texture atlas and the worker pool are not freed.
+ *
+ * @param engine the given engine
+ */
+void DestroyEngine(Engine* engine);
+
+/**
+ * Starts a new game in the engine: generates a new maze of the same size, door, low wall and window intervals from the
+ * given seed, places the player back at the start and spawns new entities. The cameras, the render resolution and the
+ * shading tables are kept.
+ *
+ * @param engine the engine
+ * @param seed 	 the seed of the new maze, must not be 0
+ */
+void ResetEngine(Engine* engine, uint32_t seed);
+
+/**
+ * Sets the internal render width of a view covering the whole window, each camera renders the part covered by its
+ * viewport. One ray is cast per column of a camera's frame buffer.
+ *
+ * @param engine the engine
+ * @param width  the internal render width, at most maxRenderWidth
+ */
+void SetEngineRenderWidth(Engine* engine, int width);
+
+/**
+ * Adds a camera viewing the maze of the engine. The camera starts at the player's pose with the player's field of view
+ * and does not follow the player, its pose is set by the caller.
+ *
+ * @param engine   the engine
+ * @param viewport the part of the window the camera is shown in
+ * @return the camera, owned by the engine
+ */
+Camera* AddEngineCamera(Engine* engine, Viewport viewport);
+
+/**
+ * Gives every camera of the engine, including the ones added later, a second frame buffer. The views of a frame can
+ * then be presented from the second frame buffers after SwapEngineFrameBuffers() while the next frame is rendered.
+ *
+ * @param engine the engine
+ */
+void EnableEngineDoubleBuffering(Engine* engine);
+
+/**
+ * Swaps the frame buffers of the cameras rendered in the last RenderEngineFrame() call, so their views are in the
+ * presented frame buffers and the next frame is rendered into the other ones.
+ *
+ * @param engine the engine, it must be double buffered
+ */
+void SwapEngineFrameBuffers(Engine* engine);
+
+/**
+ * Adds an entity to the maze of the engine.
+ *
+ * @param engine   the engine, its entity list must not be full
+ * @param type 	   ENTITY_TYPE_ITEM or ENTITY_TYPE_ENEMY
+ * @param position the position of the entity
+ * @return the entity, owned by the engine
+ */
+Entity* AddEngineEntity(Engine* engine, int type, Vec3 position);
+
+/**
+ * Advances the game by one frame. The doors around the player open and the others close, the player turns and moves
+ * as requested by the input, the items the player walks into are picked up, the cell the player is in is marked as
+ * visited and the winning condition is checked. Once the game is won, the input is ignored and the player turns
+ * slowly.
+ *
+ * @param engine the engine
+ * @param input  the movements requested for this frame
+ */
+void UpdateEngine(Engine* engine, const PlayerInput* input);
+
+/**
+ * Casts the rays within the player's field of view into the ray array of the player camera.
+ *
+ * @param engine 	   the engine
+ * @param maxRayLength the length after which the traversal stops, RAY_UNLIMITED_LENGTH to only stop at walls
+ */
+void CastEngineRays(Engine* engine, float maxRayLength);
+
+/**
+ * Renders the views of all enabled cameras into their frame buffers: casts the rays up to the fog distance, then draws
+ * each column from top to bottom in one pass, the walls with the floor and the ceiling in the rows they leave open, and
+ * the entity sprites over them. Each pixel of the floor, ceiling and walls is written once. Both steps are one parallel
+ * loop over the columns of all views combined, so a small view does not leave worker threads idle while a large one is
+ * still being drawn.
+ *
+ * @param engine the engine
+ */
+void RenderEngineFrame(Engine* engine);
+
+/**
+ * Checks if a cell was in the player's view in the last CastEngineRays() or RenderEngineFrame() call: the cell the
+ * player is in, the open cells the rays of the player camera passed through and the walls they hit.
+ *
+ * @param engine the engine
+ * @param cell 	 the index of the cell
+ * @return 1 if the cell is visible, 0 otherwise
+ */
+int IsEngineCellVisible(const Engine* engine, int cell);
+
+/**
+ * Marks the cells in the player's view as seen: the cell the player is in, the walls hit by the rays of the player
+ * camera and the open cells the rays cross. The visible cells of the last CastEngineRays() or RenderEngineFrame() call
+ * are used. The callback is only called for cells seen for the first time, so a view of the explored part of the maze
+ * can be updated with work proportional to what was discovered.
+ *
+ * @param engine 	 the engine
+ * @param onRevealed the function called for each newly seen cell, may be NULL
+ * @param context 	 the context passed to the callback
+ */
+void RevealEngineView(Engine* engine, CellRevealedCallback onRevealed, void* context);
+
+/**
+ * Reports the cells whose value changed since the last call, such as the doors that moved, and forgets them, so a view
+ * of the maze can be updated with work proportional to what changed.
+ *
+ * @param engine 	the engine
+ * @param onChanged the function called for each changed cell, may be NULL
+ * @param context 	the context passed to the callback
+ */
+void ConsumeEngineCellChanges(Engine* engine, CellChangedCallback onChanged, void* context);
+
+/**
+ * Gets the index of the cell whose wall is pointed by the player's crosshair.
+ *
+ * @param engine the engine
+ * @return the index of the pointed cell
+ */
+int GetEnginePointedCellIndex(const Engine* engine);
+
+#endif
@@ -0,0 +1,100 @@
+#include <stdlib.h>
+#include "Entity.h"
+#include "../Utils/TextureAtlas/TextureAtlas.h"
+#include "../Utils/Random/Random.h"
+#include "../Utils/ErrorHandler/ErrorHandler.h"
+#include "../Utils/Assert/Assert.h"
+
+/**
+ * Creates an empty entity list.
+ *
+ * @param capacity the maximum number of entities
+ * @return the entity list
+ */
+EntityList* CreateEntityList(int capacity)
+{
+	RCM_ASSERT(capacity > 0, INVALID_CONFIGURATION_ERROR);
+	EntityList* entityList = (EntityList*)calloc(1, sizeof(EntityList));
+	if (entityList == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	entityList->entities = (Entity*)calloc(capacity, sizeof(Entity));
+	if (entityList->entities == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	entityList->capacity = capacity;
+	entityList->numEntities = 0;
+	return entityList;
+}
+
+/**
+ * Frees the memory allocated for the given entity list.
+ *
+ * @param entityList the given entity list
+ */
+void DestroyEntityList(EntityList* entityList)
+{
+	if (entityList == NULL)
+	{return;}
+	free(entityList->entities);
+	free(entityList);
+}
+
+/**
+ * Removes all entities of an entity list.
+ *
+ * @param entityList the entity list
+ */
+void ClearEntityList(EntityList* entityList)
+{
+	RCM_ASSERT_NOT_NULL(entityList);
+	entityList->numEntities = 0;
+}
+
+/**
+ * Adds an entity with the sprite texture and size of its type.
+ *
+ * @param entityList the entity list, must not be full
+ * @param type 		 ENTITY_TYPE_ITEM or ENTITY_TYPE_ENEMY
+ * @param position 	 the position of the entity
+ * @return the entity, owned by the list
+ */
+Entity* AddEntity(EntityList* entityList, int type, Vec3 position)
+{
+	RCM_ASSERT_NOT_NULL(entityList);
+	RCM_ASSERT(entityList->numEntities < entityList->capacity, INVALID_CONFIGURATION_ERROR);
+	Entity* entity = &entityList->entities[entityList->numEntities++];
+	entity->position = position;
+	entity->type = type;
+	entity->texture = type == ENTITY_TYPE_ENEMY ? SPRITE_TEXTURE_GHOST : SPRITE_TEXTURE_GEM;
+	entity->scale = type == ENTITY_TYPE_ENEMY ? ENTITY_ENEMY_SCALE : ENTITY_ITEM_SCALE;
+	entity->isActive = 1;
+	return entity;
+}
+
+/**
+ * Places entities at the centers of randomly chosen open cells of a maze, one per ENTITY_OPEN_CELLS_PER_ENTITY open
+ * cells as long as the list has room. The start and goal cells are kept free. The same seed places the same entities.
+ *
+ * @param entityList the entity list
+ * @param map 		 the map
+ * @param seed 		 the seed of the placement
+ */
+void SpawnMazeEntities(EntityList* entityList, const Map* map, uint32_t seed)
+{
+	RCM_ASSERT_NOT_NULL(entityList);
+	RCM_ASSERT_NOT_NULL(map);
+	Random random;
+	SeedRandom(&random, seed);
+	const int numCells = map->size * map->size;
+	int numEntities = map->numOpenCells / ENTITY_OPEN_CELLS_PER_ENTITY;
+	for (int i = 0; i < numEntities && entityList->numEntities < entityList->capacity; ++i)
+	{
+		// Open cells make up about half of a maze, so a few draws find one
+		int cell;
+		do
+		{cell = (int)NextRandomBelow(&random, (uint32_t)numCells);}
+		while (map->cells[cell] != EMPTY || cell == GetMapStartCellIndex(map) || cell == GetMapGoalCellIndex(map));
+		Vec3 position = V3(((float)(cell % map->size) + 0.5f) * map->cellSize,
+				((float)(cell / map->size) + 0.5f) * map->cellSize, 0.0f);
+		AddEntity(entityList, (i + 1) % ENTITY_ENEMY_INTERVAL == 0 ? ENTITY_TYPE_ENEMY : ENTITY_TYPE_ITEM, position);
+	}
+}
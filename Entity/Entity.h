@@ -0,0 +1,82 @@
+#ifndef RAY_CASTING_MAZE_ENTITY_H_
+#define RAY_CASTING_MAZE_ENTITY_H_
+
+#include <stdint.h>
+#include "../Utils/Vec3/Vec3.h"
+#include "../Map/Map.h"
+
+#define ENTITY_TYPE_ITEM 0              // entity picked up by the player
+#define ENTITY_TYPE_ENEMY 1             // entity haunting the maze
+#define ENTITY_ITEM_SCALE 0.5f          // size of an item relative to a wall face at the same distance
+#define ENTITY_ENEMY_SCALE 0.8f         // size of an enemy relative to a wall face at the same distance
+#define ENTITY_OPEN_CELLS_PER_ENTITY 8  // number of open cells per entity spawned in a maze
+#define ENTITY_ENEMY_INTERVAL 4         // every ENTITY_ENEMY_INTERVAL-th entity spawned in a maze is an enemy
+#define ENTITY_FOOTPRINT_SCALE 0.5f     // side length of the square an entity occupies on the floor, relative to the
+										// width of its sprite
+
+/**
+ * Struct for an object standing in the maze, drawn as a billboard sprite that always faces the camera.
+ */
+typedef struct Entity_struct
+{
+	Vec3 position; // position on the floor, the z component is 0
+	int type;      // ENTITY_TYPE_ITEM or ENTITY_TYPE_ENEMY
+	int texture;   // index of the sprite texture
+	float scale;   // size of the sprite relative to a wall face at the same distance
+	int isActive;  // 1 if the entity is in the maze, 0 once it was removed
+} Entity;
+
+/**
+ * Struct for the entities of one game instance, stored in one array allocated up front so that adding entities never
+ * allocates.
+ */
+typedef struct EntityList_struct
+{
+	int capacity;      // maximum number of entities
+	int numEntities;   // number of entities added, including removed ones
+	Entity* entities;  // the entities
+} EntityList;
+
+/**
+ * Creates an empty entity list.
+ *
+ * @param capacity the maximum number of entities
+ * @return the entity list
+ */
+EntityList* CreateEntityList(int capacity);
+
+/**
+ * Frees the memory allocated for the given entity list.
+ *
+ * @param entityList the given entity list
+ */
+void DestroyEntityList(EntityList* entityList);
+
+/**
+ * Removes all entities of an entity list.
+ *
+ * @param entityList the entity list
+ */
+void ClearEntityList(EntityList* entityList);
+
+/**
+ * Adds an entity with the sprite texture and size of its type.
+ *
+ * @param entityList the entity list, must not be full
+ * @param type 		 ENTITY_TYPE_ITEM or ENTITY_TYPE_ENEMY
+ * @param position 	 the position of the entity
+ * @return the entity, owned by the list
+ */
+Entity* AddEntity(EntityList* entityList, int type, Vec3 position);
+
+/**
+ * Places entities at the centers of randomly chosen open cells of a maze, one per ENTITY_OPEN_CELLS_PER_ENTITY open
+ * cells as long as the list has room. The start and goal cells are kept free. The same seed places the same entities.
+ *
+ * @param entityList the entity list
+ * @param map 		 the map
+ * @param seed 		 the seed of the placement
+ */
+void SpawnMazeEntities(EntityList* entityList, const Map* map, uint32_t seed);
+
+#endif
@@ -0,0 +1,326 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "InputLog.h"
+#include "../Utils/Config/Config.h"
+#include "../Utils/ErrorHandler/ErrorHandler.h"
+#include "../Utils/Assert/Assert.h"
+
+#define INPUT_LOG_HEADER_SIZE 36    // size of the file header in bytes
+#define INPUT_LOG_V1_HEADER_SIZE 32 // size of the file header of version 1, which has no door interval
+#define INPUT_LOG_RUN_SIZE 3     // size of one run in bytes
+#define INPUT_LOG_V2_BITS 15     // tick bits of version 1 and 2, which have no mouse look
+
+/**
+ * Stores a 32-bit value in little-endian byte order.
+ *
+ * @param value the value
+ * @param bytes the 4 bytes to be written
+ */
+static void PutLittleEndian32(uint32_t value, unsigned char* bytes)
+{
+	bytes[0] = (unsigned char)value;
+	bytes[1] = (unsigned char)(value >> 8);
+	bytes[2] = (unsigned char)(value >> 16);
+	bytes[3] = (unsigned char)(value >> 24);
+}
+
+/**
+ * Loads a 32-bit value stored in little-endian byte order.
+ *
+ * @param bytes the 4 bytes
+ * @return the value
+ */
+static uint32_t GetLittleEndian32(const unsigned char* bytes)
+{
+	return (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+/**
+ * Reinterprets the bits of a float as an unsigned integer, so it can be stored byte by byte.
+ *
+ * @param value the float
+ * @return the bits of the float
+ */
+static uint32_t FloatBits(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+/**
+ * Reinterprets an unsigned integer as the bits of a float.
+ *
+ * @param bits the bits of the float
+ * @return the float
+ */
+static float BitsFloat(uint32_t bits)
+{
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+/**
+ * Grows the tick and turn angle arrays, doubling their capacity, until they hold at least the given number of ticks.
+ *
+ * @param inputLog the input log
+ * @param numTicks the number of ticks to hold
+ */
+static void ReserveTicks(InputLog* inputLog, int numTicks)
+{
+	if (numTicks <= inputLog->capacity)
+	{return;}
+	int capacity = inputLog->capacity == 0 ? 1024 : inputLog->capacity;
+	while (capacity < numTicks)
+	{capacity *= 2;}
+	uint8_t* ticks = (uint8_t*)realloc(inputLog->ticks, (size_t)capacity);
+	if (ticks == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	inputLog->ticks = ticks;
+	float* turnAngles = (float*)realloc(inputLog->turnAngles, (size_t)capacity * sizeof(float));
+	if (turnAngles == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	inputLog->turnAngles = turnAngles;
+	inputLog->capacity = capacity;
+}
+
+/**
+ * Gets the length of the run of identical ticks starting at the given tick, at most INPUT_LOG_MAX_RUN.
+ *
+ * @param inputLog the input log
+ * @param tick 	   the first tick of the run
+ * @return the number of ticks in the run
+ */
+static int GetRunLength(const InputLog* inputLog, int tick)
+{
+	int runLength = 1;
+	while (tick + runLength < inputLog->numTicks && runLength < INPUT_LOG_MAX_RUN &&
+			inputLog->ticks[tick + runLength] == inputLog->ticks[tick])
+	{++runLength;}
+	return runLength;
+}
+
+/**
+ * Creates an empty input log for a session.
+ *
+ * @param seed 		   the seed of the maze
+ * @param mazeSize 	   the side length of the maze in cells
+ * @param stepScalar   the scale coefficient for change in player's position
+ * @param fieldOfView  the field of view in radians
+ * @param doorInterval the average number of corridor cells per door, 0 for no doors
+ * @return the input log
+ */
+InputLog* CreateInputLog(uint32_t seed, int mazeSize, float stepScalar, float fieldOfView, int doorInterval)
+{
+	InputLog* inputLog = (InputLog*)calloc(1, sizeof(InputLog));
+	if (inputLog == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	inputLog->seed = seed;
+	inputLog->mazeSize = mazeSize;
+	inputLog->stepScalar = stepScalar;
+	inputLog->fieldOfView = fieldOfView;
+	inputLog->doorInterval = doorInterval;
+	return inputLog;
+}
+
+/**
+ * Frees the memory allocated for the given input log.
+ *
+ * @param inputLog the given input log
+ */
+void DestroyInputLog(InputLog* inputLog)
+{
+	if (inputLog == NULL)
+	{return;}
+	free(inputLog->ticks);
+	free(inputLog->turnAngles);
+	free(inputLog);
+}
+
+/**
+ * Appends the input of one tick.
+ *
+ * @param inputLog the input log
+ * @param input    the movements requested in this tick
+ */
+void RecordInput(InputLog* inputLog, const PlayerInput* input)
+{
+	RCM_ASSERT_NOT_NULL(inputLog);
+	RCM_ASSERT_NOT_NULL(input);
+	ReserveTicks(inputLog, inputLog->numTicks + 1);
+	uint8_t bits = 0;
+	if (input->isMovingForward)
+	{bits |= INPUT_LOG_FORWARD;}
+	if (input->isMovingBackward)
+	{bits |= INPUT_LOG_BACKWARD;}
+	if (input->isTurningClockwise)
+	{bits |= INPUT_LOG_CLOCKWISE;}
+	if (input->isTurningCounterClockwise)
+	{bits |= INPUT_LOG_COUNTER_CLOCKWISE;}
+	if (input->turnAngle != 0.0f)
+	{bits |= INPUT_LOG_MOUSE_TURN;}
+	inputLog->turnAngles[inputLog->numTicks] = input->turnAngle;
+	inputLog->ticks[inputLog->numTicks++] = bits;
+}
+
+/**
+ * Gets the input of one tick.
+ *
+ * @param inputLog the input log
+ * @param tick 	   the index of the tick, less than numTicks
+ * @return the movements requested in this tick
+ */
+PlayerInput GetLoggedInput(const InputLog* inputLog, int tick)
+{
+	RCM_ASSERT_NOT_NULL(inputLog);
+	RCM_ASSERT(tick >= 0 && tick < inputLog->numTicks, UNKNOWN_ERROR);
+	uint8_t bits = inputLog->ticks[tick];
+	PlayerInput input;
+	input.isMovingForward = (bits & INPUT_LOG_FORWARD) != 0;
+	input.isMovingBackward = (bits & INPUT_LOG_BACKWARD) != 0;
+	input.isTurningClockwise = (bits & INPUT_LOG_CLOCKWISE) != 0;
+	input.isTurningCounterClockwise = (bits & INPUT_LOG_COUNTER_CLOCKWISE) != 0;
+	input.turnAngle = inputLog->turnAngles[tick];
+	return input;
+}
+
+/**
+ * Writes the input log to a file.
+ *
+ * @param inputLog the input log
+ * @param path 	   the path of the file, overwritten if it exists
+ * @return 1 if the file was written, 0 otherwise
+ */
+int SaveInputLog(const InputLog* inputLog, const char* path)
+{
+	RCM_ASSERT_NOT_NULL(inputLog);
+	RCM_ASSERT_NOT_NULL(path);
+	FILE* file = fopen(path, "wb");
+	if (file == NULL)
+	{return 0;}
+	// Counts the runs first, the header holds their number
+	uint32_t numRuns = 0;
+	for (int tick = 0; tick < inputLog->numTicks; tick += GetRunLength(inputLog, tick))
+	{++numRuns;}
+	unsigned char header[INPUT_LOG_HEADER_SIZE];
+	memcpy(header, INPUT_LOG_MAGIC, 4);
+	PutLittleEndian32(INPUT_LOG_VERSION, header + 4);
+	PutLittleEndian32(inputLog->seed, header + 8);
+	PutLittleEndian32((uint32_t)inputLog->mazeSize, header + 12);
+	PutLittleEndian32(FloatBits(inputLog->stepScalar), header + 16);
+	PutLittleEndian32(FloatBits(inputLog->fieldOfView), header + 20);
+	PutLittleEndian32((uint32_t)inputLog->numTicks, header + 24);
+	PutLittleEndian32(numRuns, header + 28);
+	PutLittleEndian32((uint32_t)inputLog->doorInterval, header + 32);
+	int isWritten = fwrite(header, sizeof(header), 1, file) == 1;
+	for (int tick = 0; tick < inputLog->numTicks && isWritten;)
+	{
+		int runLength = GetRunLength(inputLog, tick);
+		unsigned char run[INPUT_LOG_RUN_SIZE] = {inputLog->ticks[tick], (unsigned char)runLength,
+												 (unsigned char)(runLength >> 8)};
+		isWritten = fwrite(run, sizeof(run), 1, file) == 1;
+		tick += runLength;
+	}
+	for (int tick = 0; tick < inputLog->numTicks && isWritten; ++tick)
+	{
+		if (inputLog->ticks[tick] & INPUT_LOG_MOUSE_TURN)
+		{
+			unsigned char angle[4];
+			PutLittleEndian32(FloatBits(inputLog->turnAngles[tick]), angle);
+			isWritten = fwrite(angle, sizeof(angle), 1, file) == 1;
+		}
+	}
+	return fclose(file) == 0 && isWritten;
+}
+
+/**
+ * Checks that the game settings of an input log header are ones the game accepts, the same ranges LoadConfig()
+ * enforces, so a damaged or hand-made log cannot create an engine from values the configuration would reject.
+ *
+ * @param inputLog the input log
+ * @return 1 if the settings are valid, 0 otherwise
+ */
+static int AreInputLogSettingsValid(const InputLog* inputLog)
+{
+	return inputLog->seed != 0 && inputLog->seed <= INT32_MAX && inputLog->mazeSize >= 5 &&
+			inputLog->mazeSize <= CONFIG_MAX_MAZE_SIZE && inputLog->mazeSize % 2 == 1 &&
+			isfinite(inputLog->stepScalar) && inputLog->stepScalar > 0.0f && isfinite(inputLog->fieldOfView) &&
+			inputLog->fieldOfView > 0.0f && inputLog->fieldOfView < (float)M_PI && inputLog->doorInterval >= 0;
+}
+
+/**
+ * Reads an input log from a file. The game settings of the header are checked like the configuration, and the mouse
+ * look angles must be finite.
+ *
+ * @param path the path of the file
+ * @return the input log, or NULL if the file could not be opened or is not a valid input log
+ */
+InputLog* LoadInputLog(const char* path)
+{
+	RCM_ASSERT_NOT_NULL(path);
+	FILE* file = fopen(path, "rb");
+	if (file == NULL)
+	{return NULL;}
+	unsigned char header[INPUT_LOG_HEADER_SIZE];
+	int isHeaderValid = fread(header, INPUT_LOG_V1_HEADER_SIZE, 1, file) == 1 &&
+			memcmp(header, INPUT_LOG_MAGIC, 4) == 0 && GetLittleEndian32(header + 24) <= INT32_MAX;
+	uint32_t version = isHeaderValid ? GetLittleEndian32(header + 4) : 0;
+	// Version 1 sessions were played before doors existed
+	int doorInterval = 0;
+	if (version == 2 || version == INPUT_LOG_VERSION)
+	{
+		isHeaderValid = fread(header + INPUT_LOG_V1_HEADER_SIZE, INPUT_LOG_HEADER_SIZE - INPUT_LOG_V1_HEADER_SIZE, 1,
+				file) == 1 && GetLittleEndian32(header + 32) <= INT32_MAX;
+		doorInterval = (int)GetLittleEndian32(header + 32);
+	}
+	else if (version != 1)
+	{isHeaderValid = 0;}
+	if (!isHeaderValid)
+	{
+		fclose(file);
+		return NULL;
+	}
+	InputLog* inputLog = CreateInputLog(GetLittleEndian32(header + 8), (int)GetLittleEndian32(header + 12),
+			BitsFloat(GetLittleEndian32(header + 16)), BitsFloat(GetLittleEndian32(header + 20)), doorInterval);
+	int numTicks = (int)GetLittleEndian32(header + 24);
+	uint32_t numRuns = GetLittleEndian32(header + 28);
+	uint8_t knownBits = version == INPUT_LOG_VERSION ? INPUT_LOG_ALL_BITS : INPUT_LOG_V2_BITS;
+	int isValid = AreInputLogSettingsValid(inputLog);
+	for (uint32_t i = 0; i < numRuns && isValid; ++i)
+	{
+		unsigned char run[INPUT_LOG_RUN_SIZE];
+		int runLength = 0;
+		if (fread(run, sizeof(run), 1, file) == 1)
+		{runLength = run[1] | run[2] << 8;}
+		// Runs must be non-empty, hold known input bits and not exceed the tick count of the header
+		isValid = runLength > 0 && (run[0] & ~knownBits) == 0 && runLength <= numTicks - inputLog->numTicks;
+		if (isValid)
+		{
+			ReserveTicks(inputLog, inputLog->numTicks + runLength);
+			memset(inputLog->ticks + inputLog->numTicks, run[0], (size_t)runLength);
+			memset(inputLog->turnAngles + inputLog->numTicks, 0, (size_t)runLength * sizeof(float));
+			inputLog->numTicks += runLength;
+		}
+	}
+	// The mouse look angles follow the runs
+	for (int tick = 0; tick < inputLog->numTicks && isValid; ++tick)
+	{
+		if (inputLog->ticks[tick] & INPUT_LOG_MOUSE_TURN)
+		{
+			unsigned char angle[4];
+			isValid = fread(angle, sizeof(angle), 1, file) == 1;
+			inputLog->turnAngles[tick] = isValid ? BitsFloat(GetLittleEndian32(angle)) : 0.0f;
+			isValid = isValid && isfinite(inputLog->turnAngles[tick]);
+		}
+	}
+	fclose(file);
+	if (!isValid || inputLog->numTicks != numTicks)
+	{
+		DestroyInputLog(inputLog);
+		return NULL;
+	}
+	return inputLog;
+}
@@ -0,0 +1,95 @@
+#ifndef RAY_CASTING_MAZE_INPUTLOG_H_
+#define RAY_CASTING_MAZE_INPUTLOG_H_
+
+#define INPUT_LOG_MAGIC "RCMI"        // first four bytes of an input log file
+#define INPUT_LOG_VERSION 3           // version of the input log file format, version 1 and 2 logs are still read
+#define INPUT_LOG_FORWARD 1           // tick bit set when the player moves forward
+#define INPUT_LOG_BACKWARD 2          // tick bit set when the player moves backward
+#define INPUT_LOG_CLOCKWISE 4         // tick bit set when the player turns clockwise
+#define INPUT_LOG_COUNTER_CLOCKWISE 8 // tick bit set when the player turns counter clockwise
+#define INPUT_LOG_MOUSE_TURN 16       // tick bit set when the player turns by a mouse look angle
+#define INPUT_LOG_ALL_BITS 31         // all tick bits
+#define INPUT_LOG_MAX_RUN 65535       // longest run of identical ticks stored as one run in a file
+
+#include <stdint.h>
+#include "../Player/Player.h"
+
+/**
+ * Struct for the input of a play session, one entry per game tick, together with everything else the game state
+ * depends on. Replaying the ticks on a new engine created with the same seed, maze size, door interval and step
+ * reproduces the session exactly, since the game advances by a fixed step per tick.
+ *
+ * In a file, all values are little-endian: the magic, the version, the seed, the maze size, the step and field of
+ * view as IEEE 754 floats, the number of ticks, the number of runs and the door interval, followed by the ticks
+ * run-length encoded as (1-byte input bits, 2-byte run length) pairs, followed by the mouse look angle of each tick
+ * with INPUT_LOG_MOUSE_TURN as a float, in tick order. Version 1 files have no door interval and were recorded without
+ * doors, version 1 and 2 files were recorded without mouse look.
+ */
+typedef struct InputLog_struct
+{
+	uint32_t seed;     // seed of the maze
+	int mazeSize;      // side length of the maze in cells
+	float stepScalar;  // scale coefficient for change in player's position
+	float fieldOfView; // field of view in radians
+	int doorInterval;  // average number of corridor cells per door, 0 for no doors
+	int numTicks;      // number of ticks recorded
+	int capacity;      // number of ticks allocated
+	uint8_t* ticks;    // INPUT_LOG_* bits of each tick
+	float* turnAngles; // mouse look angle of each tick, 0 for the ticks without INPUT_LOG_MOUSE_TURN
+} InputLog;
+
+/**
+ * Creates an empty input log for a session.
+ *
+ * @param seed 		   the seed of the maze
+ * @param mazeSize 	   the side length of the maze in cells
+ * @param stepScalar   the scale coefficient for change in player's position
+ * @param fieldOfView  the field of view in radians
+ * @param doorInterval the average number of corridor cells per door, 0 for no doors
+ * @return the input log
+ */
+InputLog* CreateInputLog(uint32_t seed, int mazeSize, float stepScalar, float fieldOfView, int doorInterval);
+
+/**
+ * Frees the memory allocated for the given input log.
+ *
+ * @param inputLog the given input log
+ */
+void DestroyInputLog(InputLog* inputLog);
+
+/**
+ * Appends the input of one tick.
+ *
+ * @param inputLog the input log
+ * @param input    the movements requested in this tick
+ */
+void RecordInput(InputLog* inputLog, const PlayerInput* input);
+
+/**
+ * Gets the input of one tick.
+ *
+ * @param inputLog the input log
+ * @param tick 	   the index of the tick, less than numTicks
+ * @return the movements requested in this tick
+ */
+PlayerInput GetLoggedInput(const InputLog* inputLog, int tick);
+
+/**
+ * Writes the input log to a file.
+ *
+ * @param inputLog the input log
+ * @param path 	   the path of the file, overwritten if it exists
+ * @return 1 if the file was written, 0 otherwise
+ */
+int SaveInputLog(const InputLog* inputLog, const char* path);
+
+/**
+ * Reads an input log from a file. The game settings of the header are checked like the configuration, and the mouse
+ * look angles must be finite.
+ *
+ * @param path the path of the file
+ * @return the input log, or NULL if the file could not be opened or is not a valid input log
+ */
+InputLog* LoadInputLog(const char* path);
+
+#endif
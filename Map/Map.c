@@ -1,81 +1,75 @@
+#include <stdlib.h>
 #include "Map.h"
+#include "../Utils/DistanceField/DistanceField.h"
+#include "../Utils/Random/Random.h"
 #include "../Utils/ErrorHandler/ErrorHandler.h"
-
-// -------------------------------------- GLOBALS -----------------------------------------
-int M_SIZE;                     // map width
-float M_CELL_SIZE;              // cell size in map grid
-int* MAP = NULL;                // 1D array representing the world, where 1 represents a wall and 0 represents empty
-								// space
-int* MAP_STATUS = NULL;         // 1D array representing the cell status in the map, all cells are initialized as
-								// unvisited, the status of each cell is changed in runtime
-SDL_FRect* M_WALL_RECTS = NULL; // array of walls drawn in map, walls are represented and drawn using SDL rectangles
-int M_WALL_RECTS_LENGTH = 0;    // length of the array of wall rectangles drawn in map, initialized to 0
-
+#include "../Utils/Assert/Assert.h"
 
 // -------------------------------------- FUNCTIONS -----------------------------------------
 /**
- * Initializes the array of map status. Map status array is identical to map array when initialized. The status of each
- * cell in map status array will be modified in runtime. An unvisited cell's status will be changed to visited when the
- * player moves inside of the cell. In-place modification is made to mapStatus.
- *
- * @param mapStatus the map status array
- * @param map 		the map array
- * @param mapSize 	the map size
- */
-void InitializeMapStatus(int** mapStatus, const int map[], int mapSize)
-{
-	if (*mapStatus != NULL)
-	{free(mapStatus);}
-	*mapStatus = (int*)calloc(mapSize * mapSize, sizeof(int));
-	if (*mapStatus == NULL)
-	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
-	for (int i = 0; i < mapSize; ++i)
-	{
-		for (int j = 0; j < mapSize; ++j)
-		{
-			int index = i * mapSize + j;
-			(*mapStatus)[index] = map[index]; // need parentheses, otherwise access then dereference, causing bad access
-		}
-	}
-}
-
-/**
- * Initializes map array and the map status array. Initializes the square map side length, the cell size in map grid,
- * the map array and the map status array. In-place modification is made to mapStatus, map, mapSize and mapCellSize.
+ * Initializes map array. Initializes the square map side length, the cell size in map grid and the map array.
+ * In-place modification is made to map, mapSize and mapCellSize.
  *
- * @param mapStatus   the global variable representing the map status array
- * @param map 		  the global variable representing the map array
- * @param mapSize 	  the global variable representing the square map's side length
+ * @param map 		  the variable representing the map array
+ * @param mapSize 	  the variable representing the square map's side length
  * @param size 		  the value assigned to the map's side length
- * @param mapCellSize the global variable representing the size of the cell in the map grid
+ * @param mapCellSize the variable representing the size of the cell in the map grid
  * @param cellSize    the value assigned to the cell's size
+ * @param seed 		  the seed of the maze
  */
-void InitializeMap(int** mapStatus, int** map, int* mapSize, int size, float* mapCellSize, float cellSize)
+void InitializeMap(int** map, int* mapSize, int size, float* mapCellSize, float cellSize, uint32_t seed)
 {
-	if (*mapStatus != NULL)
-	{free(*mapStatus);}
 	if (*map != NULL)
 	{free(*map);}
 	*mapSize = size;
 	*mapCellSize = cellSize;
-	*map = CreateMazeMap(*mapSize);
-	InitializeMapStatus(mapStatus, *map, size);
+	*map = CreateMazeMap(*mapSize, seed);
+}
+
+/**
+ * Creates the visited and seen cell bit sets and the region counters of a map, counting the open cells of each region.
+ *
+ * @param map the map, its cells must be initialized
+ */
+static void CreateMapVisits(Map* map)
+{
+	map->visitedCells = CreateBitSet(map->size * map->size);
+	map->seenCells = CreateBitSet(map->size * map->size);
+	map->numVisitedCells = 0;
+	map->numSeenCells = 0;
+	map->numOpenCells = 0;
+	map->numRegionsPerSide = (map->size + MAP_REGION_SIZE - 1) / MAP_REGION_SIZE;
+	int numRegions = map->numRegionsPerSide * map->numRegionsPerSide;
+	map->regionVisitedCells = (int*)calloc(numRegions, sizeof(int));
+	map->regionOpenCells = (int*)calloc(numRegions, sizeof(int));
+	if (map->regionVisitedCells == NULL || map->regionOpenCells == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	for (int y = 0; y < map->size; ++y)
+	{
+		for (int x = 0; x < map->size; ++x)
+		{
+			if (map->cells[y * map->size + x] == WALL)
+			{continue;}
+			++map->numOpenCells;
+			++map->regionOpenCells[(y / MAP_REGION_SIZE) * map->numRegionsPerSide + x / MAP_REGION_SIZE];
+		}
+	}
 }
 
 
 /**
- * Creates the array of rectangles representing walls in map. Assign number of rectangles drawn to the global variable
+ * Creates the array of rectangles representing walls in map. Assign number of rectangles drawn to the variable
  * rectArrayLength as side effect. In-place modification is made to rectArrayLength and map array.
  *
- * @param rectArrayLength the global variable storing the length of the array of rectangle
+ * @param rectArrayLength the variable storing the length of the array of rectangle
  * @param cellSize 		  the value assigned to the cell's size
- * @param map    		  the global variable representing the map array
- * @param mapSize		  the global variable representing the square map's side length
- * @return the array of SDL rectangle objects representing walls in the map
+ * @param map    		  the map array
+ * @param mapSize		  the square map's side length
+ * @return the array of rectangles representing walls in the map
  */
-SDL_FRect* CreateMapWallRects(int* rectArrayLength, float cellSize, const int map[], int mapSize)
+Rect* CreateMapWallRects(int* rectArrayLength, float cellSize, const int map[], int mapSize)
 {
-	SDL_FRect* mapWallRectArray = (SDL_FRect*)calloc(mapSize * mapSize, sizeof(SDL_FRect));
+	Rect* mapWallRectArray = (Rect*)calloc(mapSize * mapSize, sizeof(Rect));
 	if (mapWallRectArray == NULL)
 	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
 	int mapRectsIndex = 0;
@@ -83,7 +77,7 @@ SDL_FRect* CreateMapWallRects(int* rectArrayLength, float cellSize, const int ma
 	{
 		for (int x = 0; x < mapSize; ++x)
 		{
-			SDL_FRect rect;
+			Rect rect;
 			rect.x = (float)x * cellSize;
 			rect.y = (float)y * cellSize;
 			rect.w = cellSize;
@@ -97,4 +91,531 @@ SDL_FRect* CreateMapWallRects(int* rectArrayLength, float cellSize, const int ma
 	}
 	*rectArrayLength = mapRectsIndex;
 	return mapWallRectArray;
-}
\ No newline at end of file
+}
+
+/**
+ * Creates the index from each cell to its wall rectangle and the changed cell tracking of a map, no cell is changed.
+ *
+ * @param map the map, its wall rectangles must be created
+ */
+static void CreateMapCellIndex(Map* map)
+{
+	const int numCells = map->size * map->size;
+	map->wallRectIndices = (int*)calloc(numCells, sizeof(int));
+	map->changedCells = (int*)calloc(numCells, sizeof(int));
+	if (map->wallRectIndices == NULL || map->changedCells == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	for (int i = 0; i < numCells; ++i)
+	{map->wallRectIndices[i] = -1;}
+	for (int i = 0; i < map->wallRectsLength; ++i)
+	{
+		const Rect* rect = &map->wallRects[i];
+		map->wallRectIndices[(int)(rect->y / map->cellSize) * map->size + (int)(rect->x / map->cellSize)] = i;
+	}
+	map->changedCellSet = CreateBitSet(numCells);
+	map->numChangedCells = 0;
+	map->numDoors = 0;
+}
+
+/**
+ * Creates a map: generates the maze, creates the wall rectangles, the visited and seen cell tracking and the changed
+ * cell tracking, no cell is visited, seen or changed.
+ *
+ * @param map 	   the map to be initialized, its arrays must not be allocated yet
+ * @param size 	   the side length of the square map grid, in cells
+ * @param cellSize the size of each cell in the map grid
+ * @param seed 	   the seed of the maze, the same seed and size always give the same maze
+ */
+void CreateMap(Map* map, int size, float cellSize, uint32_t seed)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	map->cells = NULL;
+	map->goalDistances = NULL;
+	map->distanceQueue = NULL;
+	map->wallHeights = NULL;
+	map->windowCells = NULL;
+	map->seed = seed;
+	InitializeMap(&map->cells, &map->size, size, &map->cellSize, cellSize, seed);
+	map->wallRects = CreateMapWallRects(&map->wallRectsLength, map->cellSize, map->cells, map->size);
+	CreateMapVisits(map);
+	CreateMapCellIndex(map);
+}
+
+/**
+ * Calculates the goal distances of a map once after it is created: the number of steps from each open cell to the
+ * goal, which gives the direction to the goal in constant time. The distance from each cell to the nearest wall is not
+ * kept: every open cell of a maze touches a wall, so rays could not skip any empty space with it.
+ *
+ * @param map the map
+ */
+void CreateMapGoalDistances(Map* map)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	RCM_ASSERT(map->goalDistances == NULL, UNKNOWN_ERROR);
+	map->goalDistances = (int*)calloc(map->size * map->size, sizeof(int));
+	map->distanceQueue = (int*)calloc(map->size * map->size, sizeof(int));
+	if (map->goalDistances == NULL || map->distanceQueue == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	// Doors can be walked through, so only walls block the searches
+	CalculateGoalDistances(map->cells, WALL, map->size, GetMapGoalCellIndex(map), map->goalDistances);
+}
+
+/**
+ * Lists a cell as changed, unless it already is.
+ *
+ * @param map  the map
+ * @param cell the index of the cell
+ */
+static void MarkMapCellChanged(Map* map, int cell)
+{
+	if (SetBit(map->changedCellSet, cell))
+	{map->changedCells[map->numChangedCells++] = cell;}
+}
+
+/**
+ * Sets or removes the wall rectangle of a cell. A removed rectangle is replaced by the last one of the array, whose
+ * cell is found from its center.
+ *
+ * @param map  the map
+ * @param cell the index of the cell
+ * @param rect the new rectangle of the cell, NULL to remove it
+ */
+static void SetMapCellRect(Map* map, int cell, const Rect* rect)
+{
+	int index = map->wallRectIndices[cell];
+	if (rect != NULL)
+	{
+		// The array holds one rectangle per cell at most, so it never runs out of room
+		if (index < 0)
+		{
+			index = map->wallRectsLength++;
+			map->wallRectIndices[cell] = index;
+		}
+		map->wallRects[index] = *rect;
+		return;
+	}
+	if (index < 0)
+	{return;}
+	const Rect* last = &map->wallRects[--map->wallRectsLength];
+	int lastCell = (int)((last->y + last->h / 2.0f) / map->cellSize) * map->size +
+			(int)((last->x + last->w / 2.0f) / map->cellSize);
+	map->wallRects[index] = *last;
+	map->wallRectIndices[lastCell] = index;
+	map->wallRectIndices[cell] = -1;
+}
+
+/**
+ * Updates the collision rectangle of a door to cover the closed part of its panel, which slides towards the top or
+ * the left side of the cell as the door opens.
+ *
+ * @param map  the map
+ * @param cell the index of the door cell
+ */
+static void UpdateMapDoorRect(Map* map, int cell)
+{
+	int value = map->cells[cell];
+	if (GetDoorOpening(value) == DOOR_OPENING_MAX)
+	{
+		SetMapCellRect(map, cell, NULL);
+		return;
+	}
+	const float cellSize = map->cellSize;
+	const float thickness = MAP_DOOR_THICKNESS * cellSize;
+	float opening = (float)GetDoorOpening(value) / (float)DOOR_OPENING_MAX * cellSize;
+	float x = (float)(cell % map->size) * cellSize;
+	float y = (float)(cell / map->size) * cellSize;
+	Rect rect;
+	if (value & DOOR_VERTICAL)
+	{
+		rect.x = x + (cellSize - thickness) / 2.0f;
+		rect.y = y + opening;
+		rect.w = thickness;
+		rect.h = cellSize - opening;
+	}
+	else
+	{
+		rect.x = x + opening;
+		rect.y = y + (cellSize - thickness) / 2.0f;
+		rect.w = cellSize - opening;
+		rect.h = thickness;
+	}
+	SetMapCellRect(map, cell, &rect);
+}
+
+/**
+ * Turns some corridor cells of a map into closed doors: open cells between two walls on opposite sides and two open
+ * cells on the other sides, other than the start and the goal. Each such cell gets a door with a chance of one in the
+ * interval. The panel of a door stands across the corridor in the middle of the cell and slides along it. Doors count
+ * as open cells for the goal distances, and they must be placed before CreateMapGoalDistances() is called.
+ *
+ * @param map 	   the map
+ * @param interval the number of corridor cells per door on average
+ * @param seed 	   the seed of the door placement
+ * @return the number of doors placed
+ */
+int PlaceMapDoors(Map* map, int interval, uint32_t seed)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	RCM_ASSERT(interval > 0, INVALID_CONFIGURATION_ERROR);
+	RCM_ASSERT(map->goalDistances == NULL, UNKNOWN_ERROR);
+	Random random;
+	SeedRandom(&random, seed);
+	const int size = map->size;
+	const int* cells = map->cells;
+	int numPlaced = 0;
+	for (int y = 1; y < size - 1; ++y)
+	{
+		for (int x = 1; x < size - 1; ++x)
+		{
+			int cell = y * size + x;
+			if (cells[cell] != EMPTY || cell == GetMapStartCellIndex(map) || cell == GetMapGoalCellIndex(map))
+			{continue;}
+			// A door next to another door is not a corridor cell, so doors never touch
+			int isCorridorAlongX = cells[cell - 1] == EMPTY && cells[cell + 1] == EMPTY &&
+					cells[cell - size] == WALL && cells[cell + size] == WALL;
+			int isCorridorAlongY = cells[cell - size] == EMPTY && cells[cell + size] == EMPTY &&
+					cells[cell - 1] == WALL && cells[cell + 1] == WALL;
+			if ((!isCorridorAlongX && !isCorridorAlongY) || NextRandomBelow(&random, (uint32_t)interval) != 0)
+			{continue;}
+			map->cells[cell] = DOOR | (isCorridorAlongX ? DOOR_VERTICAL : 0);
+			UpdateMapDoorRect(map, cell);
+			++numPlaced;
+		}
+	}
+	map->numDoors += numPlaced;
+	return numPlaced;
+}
+
+/**
+ * Lowers some inner walls of a map, the walls on the border keep reaching the ceiling. Each inner wall is lowered with
+ * a chance of one in the interval, to a height between MAP_LOW_WALL_HEIGHT_MIN and MAP_LOW_WALL_HEIGHT_MAX. Low walls
+ * still block the player, they only let the view pass over them.
+ *
+ * @param map 	   the map
+ * @param interval the number of inner walls per low wall on average
+ * @param seed 	   the seed of the wall heights
+ * @return the number of walls lowered
+ */
+int PlaceMapLowWalls(Map* map, int interval, uint32_t seed)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	RCM_ASSERT(interval > 0, INVALID_CONFIGURATION_ERROR);
+	const int size = map->size;
+	if (map->wallHeights == NULL)
+	{
+		map->wallHeights = (unsigned char*)calloc((size_t)size * size, sizeof(unsigned char));
+		if (map->wallHeights == NULL)
+		{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	}
+	Random random;
+	// A different stream than the door placement, which is seeded from the same maze seed
+	SeedRandom(&random, ~seed);
+	int numLowered = 0;
+	for (int y = 0; y < size; ++y)
+	{
+		for (int x = 0; x < size; ++x)
+		{
+			int cell = y * size + x;
+			map->wallHeights[cell] = map->cells[cell] == WALL ? MAP_WALL_HEIGHT_FULL : 0;
+			int isInner = x > 0 && x < size - 1 && y > 0 && y < size - 1;
+			if (map->cells[cell] != WALL || !isInner || NextRandomBelow(&random, (uint32_t)interval) != 0)
+			{continue;}
+			map->wallHeights[cell] = (unsigned char)(MAP_LOW_WALL_HEIGHT_MIN +
+					NextRandomBelow(&random, MAP_LOW_WALL_HEIGHT_MAX - MAP_LOW_WALL_HEIGHT_MIN + 1));
+			++numLowered;
+		}
+	}
+	return numLowered;
+}
+
+/**
+ * Turns some inner walls of a map into windows, which rays see through into the cells behind. Only full walls between
+ * two open cells on opposite sides can become windows, each one with a chance of one in the interval. Windows still
+ * block the player, so they must be placed after the low walls, which they are never taken from.
+ *
+ * @param map 	   the map
+ * @param interval the number of such walls per window on average
+ * @param seed 	   the seed of the window placement
+ * @return the number of windows placed
+ */
+int PlaceMapWindows(Map* map, int interval, uint32_t seed)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	RCM_ASSERT(interval > 0, INVALID_CONFIGURATION_ERROR);
+	const int size = map->size;
+	const int* cells = map->cells;
+	if (map->windowCells == NULL)
+	{map->windowCells = CreateBitSet(size * size);}
+	Random random;
+	// A different stream than the doors and the low walls, which are seeded from the same maze seed
+	SeedRandom(&random, seed ^ 0x5A5A5A5Au);
+	int numPlaced = 0;
+	for (int y = 1; y < size - 1; ++y)
+	{
+		for (int x = 1; x < size - 1; ++x)
+		{
+			int cell = y * size + x;
+			if (cells[cell] != WALL || GetMapWallHeight(map, cell) < MAP_WALL_HEIGHT_FULL)
+			{continue;}
+			// A window is only worth placing where there is something to see on both sides
+			int isBetweenAlongX = cells[cell - 1] != WALL && cells[cell + 1] != WALL;
+			int isBetweenAlongY = cells[cell - size] != WALL && cells[cell + size] != WALL;
+			if ((!isBetweenAlongX && !isBetweenAlongY) || NextRandomBelow(&random, (uint32_t)interval) != 0)
+			{continue;}
+			if (SetBit(map->windowCells, cell))
+			{++numPlaced;}
+		}
+	}
+	return numPlaced;
+}
+
+/**
+ * Sets how far a door is open. The collision rectangle of the door covers the closed part of its panel and is removed
+ * once the door is fully open, and the cell is listed as changed.
+ *
+ * @param map 	  the map
+ * @param cell 	  the index of the door cell
+ * @param opening the opening, from 0 for a closed door to DOOR_OPENING_MAX
+ */
+void SetMapDoorOpening(Map* map, int cell, int opening)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	RCM_ASSERT(cell >= 0 && cell < map->size * map->size && IsDoor(map->cells[cell]), UNKNOWN_ERROR);
+	RCM_ASSERT(opening >= 0 && opening <= DOOR_OPENING_MAX, UNKNOWN_ERROR);
+	int value = (map->cells[cell] & ~DOOR_OPENING_MASK) | opening;
+	if (value == map->cells[cell])
+	{return;}
+	map->cells[cell] = value;
+	UpdateMapDoorRect(map, cell);
+	MarkMapCellChanged(map, cell);
+}
+
+/**
+ * Turns a cell into a wall or into empty space at runtime. Only the derived data around the cell is updated: the wall
+ * rectangle, the wall height and the window of the cell, the open cell counters, the visit of a cell that became a wall
+ * and, once they are created, the goal distances. A new wall is full height and opaque. The cell is listed as
+ * changed.
+ *
+ * @param map 	the map
+ * @param cell 	the index of the cell, not on the border of the map and not a door
+ * @param value WALL or EMPTY
+ */
+void SetMapCell(Map* map, int cell, int value)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	RCM_ASSERT(value == WALL || value == EMPTY, INVALID_CONFIGURATION_ERROR);
+	const int size = map->size;
+	const int x = cell % size;
+	const int y = cell / size;
+	// The border walls keep the searches of the goal distances inside the grid
+	RCM_ASSERT(cell >= 0 && x > 0 && x < size - 1 && y > 0 && y < size - 1, UNKNOWN_ERROR);
+	RCM_ASSERT(!IsDoor(map->cells[cell]), UNKNOWN_ERROR);
+	if (map->cells[cell] == value)
+	{return;}
+	map->cells[cell] = value;
+	// A wall raised at runtime reaches the ceiling
+	if (map->wallHeights != NULL)
+	{map->wallHeights[cell] = value == WALL ? MAP_WALL_HEIGHT_FULL : 0;}
+	if (map->windowCells != NULL)
+	{ClearBit(map->windowCells, cell);}
+	int region = (y / MAP_REGION_SIZE) * map->numRegionsPerSide + x / MAP_REGION_SIZE;
+	if (value == WALL)
+	{
+		Rect rect = {(float)x * map->cellSize, (float)y * map->cellSize, map->cellSize, map->cellSize};
+		SetMapCellRect(map, cell, &rect);
+		--map->numOpenCells;
+		--map->regionOpenCells[region];
+		if (ClearBit(map->visitedCells, cell))
+		{
+			--map->numVisitedCells;
+			--map->regionVisitedCells[region];
+		}
+	}
+	else
+	{
+		SetMapCellRect(map, cell, NULL);
+		++map->numOpenCells;
+		++map->regionOpenCells[region];
+	}
+	if (map->goalDistances != NULL)
+	{
+		UpdateGoalDistances(map->cells, WALL, size, GetMapGoalCellIndex(map), map->goalDistances, cell,
+				map->distanceQueue);
+	}
+	MarkMapCellChanged(map, cell);
+}
+
+/**
+ * Empties the list of changed cells, once whatever depends on them was updated.
+ *
+ * @param map the map
+ */
+void ClearMapChangedCells(Map* map)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	for (int i = 0; i < map->numChangedCells; ++i)
+	{ClearBit(map->changedCellSet, map->changedCells[i]);}
+	map->numChangedCells = 0;
+}
+
+/**
+ * Frees the arrays of a map. The map struct itself is not freed.
+ *
+ * @param map the map
+ */
+void DestroyMap(Map* map)
+{
+	if (map == NULL)
+	{return;}
+	free(map->cells);
+	DestroyBitSet(map->visitedCells);
+	DestroyBitSet(map->seenCells);
+	free(map->regionVisitedCells);
+	free(map->regionOpenCells);
+	free(map->wallRects);
+	free(map->goalDistances);
+	free(map->distanceQueue);
+	free(map->wallHeights);
+	free(map->wallRectIndices);
+	free(map->changedCells);
+	DestroyBitSet(map->changedCellSet);
+	DestroyBitSet(map->windowCells);
+	map->cells = NULL;
+	map->visitedCells = NULL;
+	map->seenCells = NULL;
+	map->regionVisitedCells = NULL;
+	map->regionOpenCells = NULL;
+	map->wallRects = NULL;
+	map->goalDistances = NULL;
+	map->distanceQueue = NULL;
+	map->wallHeights = NULL;
+	map->wallRectIndices = NULL;
+	map->changedCells = NULL;
+	map->changedCellSet = NULL;
+	map->windowCells = NULL;
+	map->wallRectsLength = 0;
+	map->numChangedCells = 0;
+	map->numDoors = 0;
+}
+
+/**
+ * Marks a cell as visited. Nothing is written if the cell was visited before, so marking the player's cell every frame
+ * is cheap.
+ *
+ * @param map  the map
+ * @param cell the index of the cell
+ * @return 1 if the cell was not visited before, 0 otherwise
+ */
+int MarkMapCellVisited(Map* map, int cell)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	RCM_ASSERT(cell >= 0 && cell < map->size * map->size, UNKNOWN_ERROR);
+	if (!SetBit(map->visitedCells, cell))
+	{return 0;}
+	// Keeps the counters up to date, so coverage queries do not have to count the bits
+	++map->numVisitedCells;
+	int x = cell % map->size;
+	int y = cell / map->size;
+	++map->regionVisitedCells[(y / MAP_REGION_SIZE) * map->numRegionsPerSide + x / MAP_REGION_SIZE];
+	return 1;
+}
+
+/**
+ * Checks if the player has been in a cell.
+ *
+ * @param map  the map
+ * @param cell the index of the cell
+ * @return 1 if the cell was visited, 0 otherwise
+ */
+int IsMapCellVisited(const Map* map, int cell)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	RCM_ASSERT(cell >= 0 && cell < map->size * map->size, UNKNOWN_ERROR);
+	return TestBit(map->visitedCells, cell);
+}
+
+/**
+ * Marks a cell as seen by the player. Nothing is written if the cell was seen before.
+ *
+ * @param map  the map
+ * @param cell the index of the cell
+ * @return 1 if the cell was not seen before, 0 otherwise
+ */
+int MarkMapCellSeen(Map* map, int cell)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	RCM_ASSERT(cell >= 0 && cell < map->size * map->size, UNKNOWN_ERROR);
+	if (!SetBit(map->seenCells, cell))
+	{return 0;}
+	++map->numSeenCells;
+	return 1;
+}
+
+/**
+ * Checks if a cell has been in the player's view.
+ *
+ * @param map  the map
+ * @param cell the index of the cell
+ * @return 1 if the cell was seen, 0 otherwise
+ */
+int IsMapCellSeen(const Map* map, int cell)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	RCM_ASSERT(cell >= 0 && cell < map->size * map->size, UNKNOWN_ERROR);
+	return TestBit(map->seenCells, cell);
+}
+
+/**
+ * Gets the fraction of the open cells of the map that were visited.
+ *
+ * @param map the map
+ * @return the explored fraction, between 0 and 1
+ */
+float GetMapCoverage(const Map* map)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	return map->numOpenCells > 0 ? (float)map->numVisitedCells / (float)map->numOpenCells : 0.0f;
+}
+
+/**
+ * Gets the fraction of the open cells of a region of the map that were visited. Region (x, y) holds the cells of
+ * columns [x * MAP_REGION_SIZE, (x + 1) * MAP_REGION_SIZE) and rows [y * MAP_REGION_SIZE, (y + 1) * MAP_REGION_SIZE).
+ *
+ * @param map 	  the map
+ * @param regionX the column of the region
+ * @param regionY the row of the region
+ * @return the explored fraction of the region, between 0 and 1, 0 for regions without open cells
+ */
+float GetMapRegionCoverage(const Map* map, int regionX, int regionY)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	RCM_ASSERT(regionX >= 0 && regionX < map->numRegionsPerSide && regionY >= 0 && regionY < map->numRegionsPerSide,
+			UNKNOWN_ERROR);
+	int region = regionY * map->numRegionsPerSide + regionX;
+	return map->regionOpenCells[region] > 0 ?
+			(float)map->regionVisitedCells[region] / (float)map->regionOpenCells[region] : 0.0f;
+}
+
+/**
+ * Gets the index of the cell the player starts in, the top-left open cell of the maze.
+ *
+ * @param map the map
+ * @return the index of the start cell
+ */
+int GetMapStartCellIndex(const Map* map)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	return map->size + 1;
+}
+
+/**
+ * Gets the index of the cell the player has to reach to win, the bottom-right open cell of the maze.
+ *
+ * @param map the map
+ * @return the index of the goal cell
+ */
+int GetMapGoalCellIndex(const Map* map)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	return map->size * map->size - map->size - 2;
+}
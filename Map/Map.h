@@ -1,45 +1,314 @@
 #ifndef RAY_CASTING_MAZE_MAP_H_
 #define RAY_CASTING_MAZE_MAP_H_
 
+#define EMPTY 0
 #define WALL 1
+#define DOOR 0x100                 // flag of door cells, the low byte of the cell holds how far the door is open
+#define DOOR_VERTICAL 0x200        // flag of doors whose panel lies in a vertical wall plane, across a corridor along x
+#define DOOR_OPENING_MASK 0xFF     // bits of a door cell holding its opening
+#define DOOR_OPENING_MAX 255       // opening of a door slid all the way into the wall
+#define MAP_DOOR_THICKNESS 0.0625f // thickness of the collision rectangle of a door panel, relative to the cell size
+#define MAP_REGION_SIZE 16 // side length in cells of the square regions visits are counted in
+#define MAP_WALL_HEIGHT_FULL 8     // height of a full wall, reaching the ceiling, in the units of the wall heights
+#define MAP_LOW_WALL_HEIGHT_MIN 2  // height of the lowest low wall, in the units of the wall heights
+#define MAP_LOW_WALL_HEIGHT_MAX 6  // height of the highest low wall, in the units of the wall heights
 
-#include <SDL.h>
 #include "../Utils/MazeGenerator/MazeGenerator.h"
+#include "../Utils/Collision/Collision.h"
+#include "../Utils/BitSet/BitSet.h"
 
-// ------------------------------------------- GLOBALS -------------------------------------------
-extern int M_SIZE; 				// map width
-extern float M_CELL_SIZE; 		// cell size in map grid
-extern int* MAP; 				// 1D array representing the world, where 1 represents a wall and 0 represents empty
-								// space
-extern int* MAP_STATUS; 		// 1D array representing the cell status in the map, all cells are initialized as
-								// unvisited, the status of each cell is changed in runtime
-extern SDL_FRect *M_WALL_RECTS; // array of walls drawn in map, walls are represented and drawn using SDL rectangles
-extern int M_WALL_RECTS_LENGTH; // length of the array of wall rectangles drawn in map, initialized to 0
+/**
+ * Struct for the map of one game instance.
+ */
+typedef struct Map_struct
+{
+	int size;             // map width
+	uint32_t seed;        // seed the maze was generated from
+	float cellSize;       // cell size in map grid
+	int* cells;           // 1D array representing the world: WALL, EMPTY, or DOOR combined with DOOR_VERTICAL and the
+						  // opening of the door
+	BitSet* visitedCells; // one bit per cell, set once the player has been in the cell
+	int numVisitedCells;  // number of bits set in visitedCells
+	int numOpenCells;     // number of cells that are not walls
+	int numRegionsPerSide; // number of regions along each side of the map, the last ones may be cut off by the border
+	int* regionVisitedCells; // number of visited cells in each region, row by row
+	int* regionOpenCells;    // number of open cells in each region, row by row
+	BitSet* seenCells;    // one bit per cell, set once the cell has been in the player's view
+	int numSeenCells;     // number of bits set in seenCells
+	Rect* wallRects;      // array of rectangles representing walls, used for collision detection and the top-down map
+	int wallRectsLength;  // length of the array of wall rectangles
+	int* wallRectIndices; // index in wallRects of the rectangle of each cell, -1 for cells without one
+	int numDoors;         // number of door cells
+	int* changedCells;    // cells whose value changed since ClearMapChangedCells() was last called, each listed once
+	int numChangedCells;  // number of cells listed in changedCells
+	BitSet* changedCellSet; // one bit per cell, set for the cells listed in changedCells
+	int* goalDistances;   // steps from each open cell to the goal cell, NULL until CreateMapGoalDistances() is called
+	int* distanceQueue;   // scratch queue of one entry per cell used to update the goal distances, NULL until
+						  // CreateMapGoalDistances() is called
+	unsigned char* wallHeights; // height of each wall in units of MAP_WALL_HEIGHT_FULL per full wall, 0 for the other
+								// cells, NULL while every wall is full height
+	BitSet* windowCells;  // one bit per cell, set for the walls rays see through, NULL while no wall is a window
+} Map;
+
+/**
+ * Checks if a cell value is a door.
+ *
+ * @param value the value of the cell
+ * @return 1 if the cell is a door, 0 otherwise
+ */
+static inline int IsDoor(int value)
+{
+	return (value & DOOR) != 0;
+}
+
+/**
+ * Gets how far the door of a cell value is open.
+ *
+ * @param value the value of the door cell
+ * @return the opening, from 0 for a closed door to DOOR_OPENING_MAX
+ */
+static inline int GetDoorOpening(int value)
+{
+	return value & DOOR_OPENING_MASK;
+}
+
+/**
+ * Checks if a cell of a map is a wall lower than a full wall, which rays see over.
+ *
+ * @param map  the map
+ * @param cell the index of the cell
+ * @return 1 if the cell is a low wall, 0 otherwise
+ */
+static inline int IsMapLowWall(const Map* map, int cell)
+{
+	return map->wallHeights != NULL && map->cells[cell] == WALL && map->wallHeights[cell] < MAP_WALL_HEIGHT_FULL;
+}
+
+/**
+ * Checks if a cell of a map is a window, a full wall that rays see through.
+ *
+ * @param map  the map
+ * @param cell the index of the cell
+ * @return 1 if the cell is a window, 0 otherwise
+ */
+static inline int IsMapWindow(const Map* map, int cell)
+{
+	return map->windowCells != NULL && TestBit(map->windowCells, cell);
+}
+
+/**
+ * Checks if rays may have to be followed past the wall they hit, because some walls are low or are windows.
+ *
+ * @param map the map
+ * @return 1 if some walls let the view pass, 0 if every wall is full and opaque
+ */
+static inline int CanSeePastMapWalls(const Map* map)
+{
+	return map->wallHeights != NULL || map->windowCells != NULL;
+}
+
+/**
+ * Gets the height of a cell of a map.
+ *
+ * @param map  the map
+ * @param cell the index of the cell
+ * @return the height of the wall in units of MAP_WALL_HEIGHT_FULL per full wall, 0 for the other cells
+ */
+static inline int GetMapWallHeight(const Map* map, int cell)
+{
+	if (map->wallHeights != NULL)
+	{return map->wallHeights[cell];}
+	return map->cells[cell] == WALL ? MAP_WALL_HEIGHT_FULL : 0;
+}
 
 // ------------------------------------------- FUNCTIONS -------------------------------------------
 /**
- * Initializes map array and the map status array. Initializes the square map side length, the cell size in map grid,
- * the map array and the map status array.
+ * Initializes map array. Initializes the square map side length, the cell size in map grid and the map array.
  *
- * @param mapStatus   the global variable representing the map status array
- * @param map 		  the global variable representing the map array
- * @param mapSize     the global variable representing the square map's side length
+ * @param map 		  the variable representing the map array
+ * @param mapSize     the variable representing the square map's side length
  * @param size 		  the value assigned to the map's side length
- * @param mapCellSize the global variable representing the size of the cell in the map grid
+ * @param mapCellSize the variable representing the size of the cell in the map grid
  * @param cellSize    the value assigned to the cell's size
+ * @param seed 		  the seed of the maze
  */
-void InitializeMap(int** mapStatus, int** map, int* mapSize, int size, float* mapCellSize, float cellSize);
+void InitializeMap(int** map, int* mapSize, int size, float* mapCellSize, float cellSize, uint32_t seed);
 
 /**
- * Creates the array of rectangles representing walls in map. Assign number of rectangles drawn to the global variable
+ * Creates the array of rectangles representing walls in map. Assign number of rectangles drawn to the variable
  * rectArrayLength as side effect.
  *
- * @param rectArrayLength the global variable storing the length of the array of rectangle
+ * @param rectArrayLength the variable storing the length of the array of rectangle
  * @param cellSize 		  the value assigned to the cell's size
- * @param map 			  the global variable representing the map array
- * @param mapSize 		  the global variable representing the square map's side length
- * @return the array of SDL rectangle objects representing walls in the map
+ * @param map 			  the map array
+ * @param mapSize 		  the square map's side length
+ * @return the array of rectangles representing walls in the map
+ */
+Rect* CreateMapWallRects(int* rectArrayLength, float cellSize, const int map[], int mapSize);
+
+/**
+ * Creates a map: generates the maze, creates the wall rectangles and the visited and seen cell tracking, no cell is
+ * visited or seen.
+ *
+ * @param map 	   the map to be initialized, its arrays must not be allocated yet
+ * @param size 	   the side length of the square map grid, in cells
+ * @param cellSize the size of each cell in the map grid
+ * @param seed 	   the seed of the maze, the same seed and size always give the same maze
+ */
+void CreateMap(Map* map, int size, float cellSize, uint32_t seed);
+
+/**
+ * Calculates the goal distances of a map once after it is created: the number of steps from each open cell to the
+ * goal, which gives the direction to the goal in constant time. The distance from each cell to the nearest wall is not
+ * kept: every open cell of a maze touches a wall, so rays could not skip any empty space with it.
+ *
+ * @param map the map
+ */
+void CreateMapGoalDistances(Map* map);
+
+/**
+ * Turns some corridor cells of a map into closed doors: open cells between two walls on opposite sides and two open
+ * cells on the other sides, other than the start and the goal. Each such cell gets a door with a chance of one in the
+ * interval. The panel of a door stands across the corridor in the middle of the cell and slides along it. Doors count
+ * as open cells for the goal distances, and they must be placed before CreateMapGoalDistances() is called.
+ *
+ * @param map 	   the map
+ * @param interval the number of corridor cells per door on average
+ * @param seed 	   the seed of the door placement
+ * @return the number of doors placed
+ */
+int PlaceMapDoors(Map* map, int interval, uint32_t seed);
+
+/**
+ * Lowers some inner walls of a map, the walls on the border keep reaching the ceiling. Each inner wall is lowered with
+ * a chance of one in the interval, to a height between MAP_LOW_WALL_HEIGHT_MIN and MAP_LOW_WALL_HEIGHT_MAX. Low walls
+ * still block the player, they only let the view pass over them.
+ *
+ * @param map 	   the map
+ * @param interval the number of inner walls per low wall on average
+ * @param seed 	   the seed of the wall heights
+ * @return the number of walls lowered
+ */
+int PlaceMapLowWalls(Map* map, int interval, uint32_t seed);
+
+/**
+ * Turns some inner walls of a map into windows, which rays see through into the cells behind. Only full walls between
+ * two open cells on opposite sides can become windows, each one with a chance of one in the interval. Windows still
+ * block the player, so they must be placed after the low walls, which they are never taken from.
+ *
+ * @param map 	   the map
+ * @param interval the number of such walls per window on average
+ * @param seed 	   the seed of the window placement
+ * @return the number of windows placed
+ */
+int PlaceMapWindows(Map* map, int interval, uint32_t seed);
+
+/**
+ * Sets how far a door is open. The collision rectangle of the door covers the closed part of its panel and is removed
+ * once the door is fully open, and the cell is listed as changed.
+ *
+ * @param map 	  the map
+ * @param cell 	  the index of the door cell
+ * @param opening the opening, from 0 for a closed door to DOOR_OPENING_MAX
+ */
+void SetMapDoorOpening(Map* map, int cell, int opening);
+
+/**
+ * Turns a cell into a wall or into empty space at runtime. Only the derived data around the cell is updated: the wall
+ * rectangle, the wall height and the window of the cell, the open cell counters, the visit of a cell that became a wall
+ * and, once they are created, the goal distances. A new wall is full height and opaque. The cell is listed as
+ * changed.
+ *
+ * @param map 	the map
+ * @param cell 	the index of the cell, not on the border of the map and not a door
+ * @param value WALL or EMPTY
+ */
+void SetMapCell(Map* map, int cell, int value);
+
+/**
+ * Empties the list of changed cells, once whatever depends on them was updated.
+ *
+ * @param map the map
+ */
+void ClearMapChangedCells(Map* map);
+
+/**
+ * Frees the arrays of a map. The map struct itself is not freed.
+ *
+ * @param map the map
+ */
+void DestroyMap(Map* map);
+
+/**
+ * Marks a cell as visited. Nothing is written if the cell was visited before, so marking the player's cell every frame
+ * is cheap.
+ *
+ * @param map  the map
+ * @param cell the index of the cell
+ * @return 1 if the cell was not visited before, 0 otherwise
+ */
+int MarkMapCellVisited(Map* map, int cell);
+
+/**
+ * Checks if the player has been in a cell.
+ *
+ * @param map  the map
+ * @param cell the index of the cell
+ * @return 1 if the cell was visited, 0 otherwise
+ */
+int IsMapCellVisited(const Map* map, int cell);
+
+/**
+ * Marks a cell as seen by the player. Nothing is written if the cell was seen before.
+ *
+ * @param map  the map
+ * @param cell the index of the cell
+ * @return 1 if the cell was not seen before, 0 otherwise
+ */
+int MarkMapCellSeen(Map* map, int cell);
+
+/**
+ * Checks if a cell has been in the player's view.
+ *
+ * @param map  the map
+ * @param cell the index of the cell
+ * @return 1 if the cell was seen, 0 otherwise
+ */
+int IsMapCellSeen(const Map* map, int cell);
+
+/**
+ * Gets the fraction of the open cells of the map that were visited.
+ *
+ * @param map the map
+ * @return the explored fraction, between 0 and 1
+ */
+float GetMapCoverage(const Map* map);
+
+/**
+ * Gets the fraction of the open cells of a region of the map that were visited. Region (x, y) holds the cells of
+ * columns [x * MAP_REGION_SIZE, (x + 1) * MAP_REGION_SIZE) and rows [y * MAP_REGION_SIZE, (y + 1) * MAP_REGION_SIZE).
+ *
+ * @param map 	  the map
+ * @param regionX the column of the region
+ * @param regionY the row of the region
+ * @return the explored fraction of the region, between 0 and 1, 0 for regions without open cells
+ */
+float GetMapRegionCoverage(const Map* map, int regionX, int regionY);
+
+/**
+ * Gets the index of the cell the player starts in, the top-left open cell of the maze.
+ *
+ * @param map the map
+ * @return the index of the start cell
+ */
+int GetMapStartCellIndex(const Map* map);
+
+/**
+ * Gets the index of the cell the player has to reach to win, the bottom-right open cell of the maze.
+ *
+ * @param map the map
+ * @return the index of the goal cell
  */
-SDL_FRect* CreateMapWallRects(int* rectArrayLength, float cellSize, const int map[], int mapSize);
+int GetMapGoalCellIndex(const Map* map);
 
 #endif
@@ -1,24 +1,35 @@
 #ifndef RAY_CASTING_MAZE_PLAYER_H_
 #define RAY_CASTING_MAZE_PLAYER_H_
 
-#include <SDL.h>
 #include "../Utils/Vec3/Vec3.h"
+#include "../Utils/Collision/Collision.h"
 
-// -------------------------------------- GLOBALS -----------------------------------------
-extern const float P_ABS_TURNING_ANGLE;  // absolute unit turning angle in radians
-extern const float P_STEP_SCALAR;        // scale coefficient for change in player's position
-extern const float P_RECT_SIZE;          // the size of the square bounding box for the player
-extern const float P_FOV;                // player's field of view
-extern const int P_NUM_RAYS;             // the number of rays cast by player within the field of view
-extern int P_TURN_CW;                    // flag variable representing if the right arrow key is pressed
-extern int P_TURN_CCW;                   // flag variable representing if the left arrow key is pressed
-extern int P_MOVE_FORWARD;               // flag variable representing if the up arrow key is pressed
-extern int P_MOVE_BACKWARD;              // flag variable representing if the down arrow key is pressed
-extern float* P_RAY_HEIGHTS;             // the converted height information for the rays cast by player
-extern Vec3* P_POS;                      // player position vector
-extern Vec3* P_DIR;                      // player direction vector, this is always a unit vector
-extern Vec3* P_RAYS;                     // array of vectors representing the intersections points between rays cast by
-										 // player and walls, within the field of view
+#define PLAYER_TURNING_ANGLE 0.05f // absolute unit turning angle in radians
+#define PLAYER_RECT_SIZE 0.5f      // the size of the square bounding box for the player
+
+/**
+ * Struct for the movements requested by the frontend for one frame, each flag is 1 if requested and 0 otherwise. The
+ * turn angle of mouse look is added to the turns requested by the flags.
+ */
+typedef struct PlayerInput_struct
+{
+	int isMovingForward;
+	int isMovingBackward;
+	int isTurningClockwise;
+	int isTurningCounterClockwise;
+	float turnAngle; // clockwise turn in radians requested by mouse look, 0 for none
+} PlayerInput;
+
+/**
+ * Struct for the player of one game instance.
+ */
+typedef struct Player_struct
+{
+	Vec3 position;     // player position vector
+	Vec3 direction;    // player direction vector, this is always a unit vector
+	float fieldOfView; // player's field of view in radians
+	float stepScalar;  // scale coefficient for change in player's position
+} Player;
 
 // ------------------------------------------- FUNCTIONS -------------------------------------------
 /**
@@ -51,17 +62,13 @@ void TurnPlayer(int isTurningClockwise, int isTurningCounterClockwise, Vec3* pla
  * @param mapRectArraySize		the length of the rectangle array
  */
 void MovePlayer(int isMovingForward, int isMovingBackWard, Vec3* playerPosition, Vec3* playerDirection,
-		float playerStepSizeScalar, float playerSize, SDL_FRect* mapRectArray, int mapRectArraySize);
+		float playerStepSizeScalar, float playerSize, const Rect* mapRectArray, int mapRectArraySize);
 
 /**
- * Updates player's position. This function checks if the keys controlling player movement are pressed and calls
- * corresponding functions to update player's position. In-place modification is made to the player position vector.
+ * Updates player's position. This function checks which movements are requested by the input and calls corresponding
+ * functions to update player's position. In-place modification is made to the player position vector.
  *
- * @param keyboardState  				keeps track of key board state using scan codes
- * @param isMovingForward				flag variable representing if up arrow key is pressed
- * @param isMovingBackWard				flag variable representing if down arrow key is pressed
- * @param isTurningClockwise 			flag variable representing if right arrow key is pressed
- * @param isTurningCounterClockwise 	flag variable representing if left arrow key is pressed
+ * @param input 						the movements requested for this frame
  * @param playerPosition 				the vector representing the player position
  * @param playerDirection 				the vector representing the direction that the player is facing, this vector is
  									 	a unit vector
@@ -72,9 +79,9 @@ void MovePlayer(int isMovingForward, int isMovingBackWard, Vec3* playerPosition,
  * @param mapRectArray 					the rectangle array representing walls in map
  * @param mapRectArraySize 				the length of the rectangle array
  */
-void UpdatePlayerPosition(const Uint8* keyboardState, int isMovingForward, int isMovingBackWard, int isTurningClockwise,
-		int isTurningCounterClockwise, Vec3* playerPosition, Vec3* playerDirection, float playerStepSizeScalar,
-		float playerSize, float playerAbsoluteTurningAngle, SDL_FRect* mapRectArray, int mapRectArraySize);
+void UpdatePlayerPosition(const PlayerInput* input, Vec3* playerPosition, Vec3* playerDirection,
+		float playerStepSizeScalar, float playerSize, float playerAbsoluteTurningAngle, const Rect* mapRectArray,
+		int mapRectArraySize);
 
 /**
  * Gets the index of the cell in which the player is currently located.
@@ -84,6 +91,6 @@ void UpdatePlayerPosition(const Uint8* keyboardState, int isMovingForward, int i
  * @param mapSize 			the side length of the square map grid
  * @return the index of the cell in which the player is currently located
  */
-int GetPlayerCellIndex(Vec3* playerPosition, float mapCellSize, int mapSize);
+int GetPlayerCellIndex(const Vec3* playerPosition, float mapCellSize, int mapSize);
 
 #endif
\ No newline at end of file
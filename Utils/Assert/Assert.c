@@ -0,0 +1,33 @@
+#include <stdio.h>
+#include "Assert.h"
+#if defined(__GLIBC__) || defined(__APPLE__)
+#include <execinfo.h>
+#include <unistd.h>
+#define RCM_HAS_BACKTRACE
+#endif
+
+#define ASSERT_MAX_BACKTRACE_DEPTH 32 // maximum number of stack frames printed for a failed check
+
+/**
+ * Reports a failed contract check and exits the program. It prints the failed condition, its location and the call
+ * stack where the platform provides one, then calls ErrorHandler() with the given error code.
+ *
+ * @param condition the source text of the failed condition
+ * @param errorCode the error code passed to ErrorHandler()
+ * @param file 		the source file containing the check
+ * @param line 		the line of the check
+ * @param function 	the function containing the check
+ */
+void AssertionFailed(const char* condition, int errorCode, const char* file, int line, const char* function)
+{
+	fprintf(stderr, "%s:%d: %s: Assertion `%s` failed.\n", file, line, function, condition);
+#ifdef RCM_HAS_BACKTRACE
+	void* frames[ASSERT_MAX_BACKTRACE_DEPTH];
+	int depth = backtrace(frames, ASSERT_MAX_BACKTRACE_DEPTH);
+	fprintf(stderr, "Backtrace:\n");
+	fflush(stderr);
+	// Writes straight to the file descriptor, without allocating memory
+	backtrace_symbols_fd(frames, depth, STDERR_FILENO);
+#endif
+	ErrorHandler(errorCode);
+}
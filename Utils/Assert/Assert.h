@@ -0,0 +1,33 @@
+#ifndef RAY_CASTING_MAZE_ASSERT_H_
+#define RAY_CASTING_MAZE_ASSERT_H_
+
+#include <stddef.h>
+#include "../ErrorHandler/ErrorHandler.h"
+
+// Contract checks on function arguments. In release builds (NDEBUG defined) the checks compile to nothing, so they
+// add no branches to the ray casting loops. In debug builds a failed check prints the failed condition with its file,
+// line and function and a backtrace, then exits through ErrorHandler() with the given error code. Defining
+// RCM_ENABLE_ASSERTIONS keeps the checks in release builds.
+#if defined(NDEBUG) && !defined(RCM_ENABLE_ASSERTIONS)
+#define RCM_ASSERT(condition, errorCode) ((void)0)
+#else
+#define RCM_ASSERT(condition, errorCode) \
+	((condition) ? (void)0 : AssertionFailed(#condition, (errorCode), __FILE__, __LINE__, __func__))
+#endif
+
+// Checks that a pointer argument is not NULL, failing with ACCESSING_NULL_POINTER_ERROR
+#define RCM_ASSERT_NOT_NULL(pointer) RCM_ASSERT((pointer) != NULL, ACCESSING_NULL_POINTER_ERROR)
+
+/**
+ * Reports a failed contract check and exits the program. It prints the failed condition, its location and the call
+ * stack where the platform provides one, then calls ErrorHandler() with the given error code.
+ *
+ * @param condition the source text of the failed condition
+ * @param errorCode the error code passed to ErrorHandler()
+ * @param file 		the source file containing the check
+ * @param line 		the line of the check
+ * @param function 	the function containing the check
+ */
+void AssertionFailed(const char* condition, int errorCode, const char* file, int line, const char* function);
+
+#endif
@@ -0,0 +1,119 @@
+#include <stdlib.h>
+#include "AsyncTask.h"
+#include "../ErrorHandler/ErrorHandler.h"
+#include "../Assert/Assert.h"
+
+/**
+ * Thread main loop. Waits for a function, runs it and reports completion.
+ *
+ * @param data the async task
+ * @return 0
+ */
+static int AsyncTaskMain(void* data)
+{
+	AsyncTask* task = (AsyncTask*)data;
+	while (1)
+	{
+		SDL_LockMutex(task->mutex);
+		while (task->function == NULL && !task->isShuttingDown)
+		{SDL_CondWait(task->workAvailable, task->mutex);}
+		if (task->function == NULL)
+		{
+			SDL_UnlockMutex(task->mutex);
+			return 0;
+		}
+		AsyncTaskFunction function = task->function;
+		void* context = task->context;
+		SDL_UnlockMutex(task->mutex);
+
+		Uint64 start = SDL_GetPerformanceCounter();
+		function(context);
+		double elapsedMs = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 /
+				(double)SDL_GetPerformanceFrequency();
+
+		SDL_LockMutex(task->mutex);
+		task->function = NULL;
+		task->elapsedMs = elapsedMs;
+		task->isRunning = 0;
+		SDL_CondSignal(task->workFinished);
+		SDL_UnlockMutex(task->mutex);
+	}
+}
+
+/**
+ * Creates an async task and starts its thread, which waits for a function to run.
+ *
+ * @return the async task
+ */
+AsyncTask* CreateAsyncTask(void)
+{
+	AsyncTask* task = (AsyncTask*)calloc(1, sizeof(AsyncTask));
+	if (task == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	task->mutex = SDL_CreateMutex();
+	task->workAvailable = SDL_CreateCond();
+	task->workFinished = SDL_CreateCond();
+	task->thread = SDL_CreateThread(AsyncTaskMain, "RayCastingMazeAsyncTask", task);
+	if (task->mutex == NULL || task->workAvailable == NULL || task->workFinished == NULL || task->thread == NULL)
+	{ErrorHandler(UNKNOWN_ERROR);}
+	return task;
+}
+
+/**
+ * Stops the thread of the given async task and frees the memory allocated for it. A running function is finished
+ * first.
+ *
+ * @param task the given async task
+ */
+void DestroyAsyncTask(AsyncTask* task)
+{
+	if (task == NULL)
+	{return;}
+	WaitAsyncTask(task);
+	SDL_LockMutex(task->mutex);
+	task->isShuttingDown = 1;
+	SDL_CondSignal(task->workAvailable);
+	SDL_UnlockMutex(task->mutex);
+	SDL_WaitThread(task->thread, NULL);
+	SDL_DestroyCond(task->workFinished);
+	SDL_DestroyCond(task->workAvailable);
+	SDL_DestroyMutex(task->mutex);
+	free(task);
+}
+
+/**
+ * Runs a function on the thread of the task and returns without waiting for it.
+ *
+ * @param task 	   the async task, it must not be running
+ * @param function the function
+ * @param context  the context passed to the function
+ */
+void StartAsyncTask(AsyncTask* task, AsyncTaskFunction function, void* context)
+{
+	RCM_ASSERT_NOT_NULL(task);
+	RCM_ASSERT_NOT_NULL(function);
+	SDL_LockMutex(task->mutex);
+	RCM_ASSERT(!task->isRunning, UNKNOWN_ERROR);
+	task->function = function;
+	task->context = context;
+	task->isRunning = 1;
+	SDL_CondSignal(task->workAvailable);
+	SDL_UnlockMutex(task->mutex);
+}
+
+/**
+ * Waits until the function started last has returned. Returns at once if the task is not running.
+ *
+ * @param task the async task
+ * @return the time the function took on the thread of the task, in milliseconds
+ */
+double WaitAsyncTask(AsyncTask* task)
+{
+	RCM_ASSERT_NOT_NULL(task);
+	SDL_LockMutex(task->mutex);
+	while (task->isRunning)
+	{SDL_CondWait(task->workFinished, task->mutex);}
+	double elapsedMs = task->elapsedMs;
+	SDL_UnlockMutex(task->mutex);
+	return elapsedMs;
+}
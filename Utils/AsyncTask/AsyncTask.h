@@ -0,0 +1,60 @@
+#ifndef RAY_CASTING_MAZE_ASYNCTASK_H_
+#define RAY_CASTING_MAZE_ASYNCTASK_H_
+
+#include <SDL.h>
+
+/**
+ * Function run by an async task on its thread.
+ */
+typedef void (*AsyncTaskFunction)(void* context);
+
+/**
+ * A persistent thread that runs one function at a time while the thread that started it goes on with other work, used
+ * to render the next frame while the previous one is presented. Only one thread may start and wait for the task.
+ */
+typedef struct AsyncTask_struct
+{
+	SDL_Thread* thread;
+	SDL_mutex* mutex;
+	SDL_cond* workAvailable;
+	SDL_cond* workFinished;
+	AsyncTaskFunction function; // function of the current run, NULL while the thread is idle
+	void* context;              // context passed to the function
+	int isRunning;              // 1 from StartAsyncTask() until the function returned
+	int isShuttingDown;
+	double elapsedMs;           // time the last run of the function took on the thread
+} AsyncTask;
+
+/**
+ * Creates an async task and starts its thread, which waits for a function to run.
+ *
+ * @return the async task
+ */
+AsyncTask* CreateAsyncTask(void);
+
+/**
+ * Stops the thread of the given async task and frees the memory allocated for it. A running function is finished
+ * first.
+ *
+ * @param task the given async task
+ */
+void DestroyAsyncTask(AsyncTask* task);
+
+/**
+ * Runs a function on the thread of the task and returns without waiting for it.
+ *
+ * @param task 	   the async task, it must not be running
+ * @param function the function
+ * @param context  the context passed to the function
+ */
+void StartAsyncTask(AsyncTask* task, AsyncTaskFunction function, void* context);
+
+/**
+ * Waits until the function started last has returned. Returns at once if the task is not running.
+ *
+ * @param task the async task
+ * @return the time the function took on the thread of the task, in milliseconds
+ */
+double WaitAsyncTask(AsyncTask* task);
+
+#endif
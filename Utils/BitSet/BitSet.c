@@ -0,0 +1,84 @@
+#include <stdlib.h>
+#include <string.h>
+#include "BitSet.h"
+#include "../ErrorHandler/ErrorHandler.h"
+#include "../Assert/Assert.h"
+
+/**
+ * Counts the bits set in a word.
+ *
+ * @param word the word
+ * @return the number of bits set
+ */
+static inline int CountWordBits(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(word);
+#else
+	// Sums the bits in pairs, nibbles and bytes, then adds up the bytes with one multiplication
+	word = word - ((word >> 1) & 0x5555555555555555u);
+	word = (word & 0x3333333333333333u) + ((word >> 2) & 0x3333333333333333u);
+	word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Fu;
+	return (int)((word * 0x0101010101010101u) >> 56);
+#endif
+}
+
+/**
+ * Creates a bit set with all bits cleared.
+ *
+ * @param numBits the number of bits
+ * @return the bit set
+ */
+BitSet* CreateBitSet(int numBits)
+{
+	RCM_ASSERT(numBits >= 0, UNKNOWN_ERROR);
+	BitSet* bitSet = (BitSet*)calloc(1, sizeof(BitSet));
+	if (bitSet == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	bitSet->numBits = numBits;
+	bitSet->numWords = (numBits + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS;
+	// Allocates at least one word so that an empty set is not a NULL pointer
+	bitSet->words = (uint64_t*)calloc(bitSet->numWords > 0 ? bitSet->numWords : 1, sizeof(uint64_t));
+	if (bitSet->words == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	return bitSet;
+}
+
+/**
+ * Frees the memory allocated for the given bit set.
+ *
+ * @param bitSet the given bit set
+ */
+void DestroyBitSet(BitSet* bitSet)
+{
+	if (bitSet == NULL)
+	{return;}
+	free(bitSet->words);
+	free(bitSet);
+}
+
+/**
+ * Clears all bits of a bit set.
+ *
+ * @param bitSet the bit set
+ */
+void ClearBitSet(BitSet* bitSet)
+{
+	RCM_ASSERT_NOT_NULL(bitSet);
+	memset(bitSet->words, 0, (size_t)bitSet->numWords * sizeof(uint64_t));
+}
+
+/**
+ * Counts the bits that are set.
+ *
+ * @param bitSet the bit set
+ * @return the number of bits set
+ */
+int CountBitSet(const BitSet* bitSet)
+{
+	RCM_ASSERT_NOT_NULL(bitSet);
+	int count = 0;
+	for (int i = 0; i < bitSet->numWords; ++i)
+	{count += CountWordBits(bitSet->words[i]);}
+	return count;
+}
@@ -0,0 +1,95 @@
+#ifndef RAY_CASTING_MAZE_BITSET_H_
+#define RAY_CASTING_MAZE_BITSET_H_
+
+#include <stdint.h>
+
+#define BITSET_WORD_BITS 64 // number of bits stored in each word
+
+/**
+ * Struct for a fixed-size set of bits, one bit per element packed into 64-bit words.
+ */
+typedef struct BitSet_struct
+{
+	int numBits;     // number of bits in the set
+	int numWords;    // number of words holding the bits
+	uint64_t* words; // the bits, bit i is bit i % 64 of word i / 64
+} BitSet;
+
+/**
+ * Creates a bit set with all bits cleared.
+ *
+ * @param numBits the number of bits
+ * @return the bit set
+ */
+BitSet* CreateBitSet(int numBits);
+
+/**
+ * Frees the memory allocated for the given bit set.
+ *
+ * @param bitSet the given bit set
+ */
+void DestroyBitSet(BitSet* bitSet);
+
+/**
+ * Clears all bits of a bit set.
+ *
+ * @param bitSet the bit set
+ */
+void ClearBitSet(BitSet* bitSet);
+
+/**
+ * Counts the bits that are set.
+ *
+ * @param bitSet the bit set
+ * @return the number of bits set
+ */
+int CountBitSet(const BitSet* bitSet);
+
+/**
+ * Checks if a bit is set.
+ *
+ * @param bitSet the bit set
+ * @param index  the index of the bit
+ * @return 1 if the bit is set, 0 otherwise
+ */
+static inline int TestBit(const BitSet* bitSet, int index)
+{
+	return (int)((bitSet->words[index / BITSET_WORD_BITS] >> (index % BITSET_WORD_BITS)) & 1u);
+}
+
+/**
+ * Sets a bit. The word holding the bit is only written if the bit was not set, so setting a bit again leaves the cache
+ * line clean.
+ *
+ * @param bitSet the bit set
+ * @param index  the index of the bit
+ * @return 1 if the bit was not set before, 0 otherwise
+ */
+static inline int SetBit(BitSet* bitSet, int index)
+{
+	uint64_t* word = &bitSet->words[index / BITSET_WORD_BITS];
+	uint64_t mask = (uint64_t)1 << (index % BITSET_WORD_BITS);
+	if (*word & mask)
+	{return 0;}
+	*word |= mask;
+	return 1;
+}
+
+/**
+ * Clears a bit. The word holding the bit is only written if the bit was set.
+ *
+ * @param bitSet the bit set
+ * @param index  the index of the bit
+ * @return 1 if the bit was set before, 0 otherwise
+ */
+static inline int ClearBit(BitSet* bitSet, int index)
+{
+	uint64_t* word = &bitSet->words[index / BITSET_WORD_BITS];
+	uint64_t mask = (uint64_t)1 << (index % BITSET_WORD_BITS);
+	if (!(*word & mask))
+	{return 0;}
+	*word &= ~mask;
+	return 1;
+}
+
+#endif
@@ -8,7 +8,7 @@
  * @param b the rectangle b
  * @return 1 if the two rectangle are in collision, 0 otherwise
  */
-int AABBCollisionTest(const SDL_FRect* a, const SDL_FRect* b)
+int AABBCollisionTest(const Rect* a, const Rect* b)
 {
 	if (a->x + a->w < b->x || a->x > b->x + b->w || a->y + a->h < b->y || a->y > b->y + b->h)
 	{return 0;}
@@ -24,7 +24,7 @@ int AABBCollisionTest(const SDL_FRect* a, const SDL_FRect* b)
  * @param rectArraySize the size of the rectangle array
  * @return 1 if the given rectangle is in collision with any rectangle form the array, false otherwise
  */
-int CheckCollisionWithMapRectArray(const SDL_FRect* rectangle, const SDL_FRect rectArray[], int rectArraySize)
+int CheckCollisionWithMapRectArray(const Rect* rectangle, const Rect rectArray[], int rectArraySize)
 {
 	for (int i = 0; i < rectArraySize; ++i)
 	{
@@ -33,3 +33,19 @@ int CheckCollisionWithMapRectArray(const SDL_FRect* rectangle, const SDL_FRect r
 	}
 	return 0;
 }
+
+/**
+ * Checks if a square bounding box centered at a given position is in collision with any rectangle from an array of
+ * rectangle.
+ *
+ * @param center 		the center of the bounding box
+ * @param size 			the side length of the bounding box
+ * @param rectArray 	the rectangle array
+ * @param rectArraySize the size of the rectangle array
+ * @return 1 if the bounding box is in collision with any rectangle form the array, 0 otherwise
+ */
+int CheckCollisionAt(Vec2 center, float size, const Rect rectArray[], int rectArraySize)
+{
+	Rect boundingBox = {center.x - size / 2, center.y - size / 2, size, size};
+	return CheckCollisionWithMapRectArray(&boundingBox, rectArray, rectArraySize);
+}
@@ -1,7 +1,18 @@
 #ifndef RAY_CASTING_MAZE_COLLISION_H_
 #define RAY_CASTING_MAZE_COLLISION_H_
 
-#include <SDL.h>
+#include "../Vec2/Vec2.h"
+
+/**
+ * Struct for axis-aligned rectangle, with the top-left corner at (x, y).
+ */
+typedef struct Rect_struct
+{
+	float x;
+	float y;
+	float w;
+	float h;
+} Rect;
 
 /**
  * Checks if rectangle a is in collision with rectangle b using AABB (Axis-Aligned Bounding Box) collision detection
@@ -11,7 +22,7 @@
  * @param b the rectangle b
  * @return 1 if the two rectangle are in collision, 0 otherwise
  */
-int AABBCollisionTest(const SDL_FRect* a, const SDL_FRect* b);
+int AABBCollisionTest(const Rect* a, const Rect* b);
 
 /**
  * Checks if a given rectangle is in collision with any rectangle from an array of rectangle.
@@ -21,6 +32,18 @@ int AABBCollisionTest(const SDL_FRect* a, const SDL_FRect* b);
  * @param rectArraySize the size of the rectangle array
  * @return 1 if the given rectangle is in collision with any rectangle form the array, false otherwise
  */
-int CheckCollisionWithMapRectArray(const SDL_FRect* rectangle, const SDL_FRect rectArray[], int rectArraySize);
+int CheckCollisionWithMapRectArray(const Rect* rectangle, const Rect rectArray[], int rectArraySize);
+
+/**
+ * Checks if a square bounding box centered at a given position is in collision with any rectangle from an array of
+ * rectangle.
+ *
+ * @param center 		the center of the bounding box
+ * @param size 			the side length of the bounding box
+ * @param rectArray 	the rectangle array
+ * @param rectArraySize the size of the rectangle array
+ * @return 1 if the bounding box is in collision with any rectangle form the array, 0 otherwise
+ */
+int CheckCollisionAt(Vec2 center, float size, const Rect rectArray[], int rectArraySize);
 
 #endif
\ No newline at end of file
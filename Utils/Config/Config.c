@@ -0,0 +1,317 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include "Config.h"
+#include "../ErrorHandler/ErrorHandler.h"
+
+/**
+ * Sets every field of a configuration to its default value.
+ *
+ * @param config the configuration
+ */
+void SetDefaultConfig(Config* config)
+{
+	if (config == NULL)
+	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
+	config->windowWidth = 1024;
+	config->windowHeight = 768;
+	config->renderScale = 1.0f;
+	config->numRays = 0;
+	config->fieldOfView = (float)M_PI / 3;
+	config->stepScalar = 2.0f;
+	config->mouseSensitivity = 0.15f * (float)M_PI / 180.0f;
+	config->mazeSize = 23;
+	config->dynamicResolution = 1;
+	config->frameBudgetMs = 1000.0f / 60.0f;
+	config->pipelinedFrames = 0;
+	config->seed = 0;
+	config->doorInterval = 8;
+	config->lowWallInterval = 6;
+	config->windowInterval = 12;
+	config->recordPath[0] = '\0';
+}
+
+/**
+ * Compares two keys, treating dashes and underscores as equal.
+ *
+ * @param a the first key
+ * @param b the second key
+ * @return 1 if the keys are equal, 0 otherwise
+ */
+static int KeysEqual(const char* a, const char* b)
+{
+	for (; *a != '\0' && *b != '\0'; ++a, ++b)
+	{
+		char ca = *a == '-' ? '_' : *a;
+		char cb = *b == '-' ? '_' : *b;
+		if (ca != cb)
+		{return 0;}
+	}
+	return *a == *b;
+}
+
+/**
+ * Parses an integer value.
+ *
+ * @param value  the textual value
+ * @param result the parsed integer
+ * @return 1 if the whole value is an integer in the range of int, 0 otherwise
+ */
+static int ParseInt(const char* value, int* result)
+{
+	char* end = NULL;
+	errno = 0;
+	long parsed = strtol(value, &end, 10);
+	if (end == value || *end != '\0')
+	{return 0;}
+	// long is wider than int on most 64-bit targets, so the value is range checked before narrowing
+	if (errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX)
+	{return 0;}
+	*result = (int)parsed;
+	return 1;
+}
+
+/**
+ * Parses a float value.
+ *
+ * @param value  the textual value
+ * @param result the parsed float
+ * @return 1 if the whole value is a float, 0 otherwise
+ */
+static int ParseFloat(const char* value, float* result)
+{
+	char* end = NULL;
+	float parsed = strtof(value, &end);
+	if (end == value || *end != '\0')
+	{return 0;}
+	*result = parsed;
+	return 1;
+}
+
+/**
+ * Sets one configuration field from its key and textual value.
+ *
+ * @param config the configuration
+ * @param key 	 the key, dashes and underscores are interchangeable
+ * @param value  the textual value
+ * @return 1 if the key is known and the value could be parsed, 0 otherwise
+ */
+int SetConfigValue(Config* config, const char* key, const char* value)
+{
+	if (config == NULL || key == NULL || value == NULL)
+	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
+	if (KeysEqual(key, "window_width"))
+	{return ParseInt(value, &config->windowWidth);}
+	if (KeysEqual(key, "window_height"))
+	{return ParseInt(value, &config->windowHeight);}
+	if (KeysEqual(key, "render_scale"))
+	{return ParseFloat(value, &config->renderScale);}
+	if (KeysEqual(key, "rays"))
+	{return ParseInt(value, &config->numRays);}
+	if (KeysEqual(key, "fov"))
+	{
+		float degrees;
+		if (!ParseFloat(value, &degrees))
+		{return 0;}
+		config->fieldOfView = degrees * (float)M_PI / 180.0f;
+		return 1;
+	}
+	if (KeysEqual(key, "step"))
+	{return ParseFloat(value, &config->stepScalar);}
+	if (KeysEqual(key, "mouse_sensitivity"))
+	{
+		float degrees;
+		if (!ParseFloat(value, &degrees))
+		{return 0;}
+		config->mouseSensitivity = degrees * (float)M_PI / 180.0f;
+		return 1;
+	}
+	if (KeysEqual(key, "maze_size"))
+	{return ParseInt(value, &config->mazeSize);}
+	if (KeysEqual(key, "dynamic_resolution"))
+	{return ParseInt(value, &config->dynamicResolution);}
+	if (KeysEqual(key, "frame_budget_ms"))
+	{return ParseFloat(value, &config->frameBudgetMs);}
+	if (KeysEqual(key, "pipelined_frames"))
+	{return ParseInt(value, &config->pipelinedFrames);}
+	if (KeysEqual(key, "seed"))
+	{return ParseInt(value, &config->seed);}
+	if (KeysEqual(key, "door_interval"))
+	{return ParseInt(value, &config->doorInterval);}
+	if (KeysEqual(key, "low_wall_interval"))
+	{return ParseInt(value, &config->lowWallInterval);}
+	if (KeysEqual(key, "window_interval"))
+	{return ParseInt(value, &config->windowInterval);}
+	if (KeysEqual(key, "record"))
+	{
+		if (strlen(value) >= sizeof(config->recordPath))
+		{return 0;}
+		strcpy(config->recordPath, value);
+		return 1;
+	}
+	return 0;
+}
+
+/**
+ * Removes leading and trailing white space in place.
+ *
+ * @param text the text
+ * @return the first non-white-space character of the text
+ */
+static char* Trim(char* text)
+{
+	while (isspace((unsigned char)*text))
+	{++text;}
+	char* end = text + strlen(text);
+	while (end > text && isspace((unsigned char)end[-1]))
+	{--end;}
+	*end = '\0';
+	return text;
+}
+
+/**
+ * Reads an ini-style configuration file. Blank lines, lines starting with '#' or ';' and section headers are ignored.
+ *
+ * @param config the configuration
+ * @param path 	 the path of the configuration file
+ * @return 1 if the file was read, 0 if it could not be opened
+ */
+int LoadConfigFile(Config* config, const char* path)
+{
+	if (config == NULL || path == NULL)
+	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
+	FILE* file = fopen(path, "r");
+	if (file == NULL)
+	{return 0;}
+	char line[CONFIG_MAX_LINE_LENGTH];
+	int lineNumber = 0;
+	while (fgets(line, sizeof(line), file) != NULL)
+	{
+		++lineNumber;
+		char* text = Trim(line);
+		if (*text == '\0' || *text == '#' || *text == ';' || *text == '[')
+		{continue;}
+		char* separator = strchr(text, '=');
+		if (separator != NULL)
+		{*separator = '\0';}
+		if (separator == NULL || !SetConfigValue(config, Trim(text), Trim(separator + 1)))
+		{
+			printf("%s:%d: invalid configuration line.\n", path, lineNumber);
+			fclose(file);
+			ErrorHandler(INVALID_CONFIGURATION_ERROR);
+		}
+	}
+	fclose(file);
+	return 1;
+}
+
+/**
+ * Checks that every configuration value is usable, printing the first problem found. Float values must be finite, and
+ * the sizes are bounded so the cell and pixel indices computed from them fit in an int. LoadConfig() calls it, callers
+ * that override values afterwards call it again.
+ *
+ * @param config the configuration
+ * @return 1 if the configuration is valid, 0 otherwise
+ */
+int ValidateConfig(const Config* config)
+{
+	if (config->windowWidth < 64 || config->windowHeight < 64 || config->windowWidth > CONFIG_MAX_WINDOW_SIZE ||
+			config->windowHeight > CONFIG_MAX_WINDOW_SIZE)
+	{printf("Window size must be between 64x64 and %dx%d.\n", CONFIG_MAX_WINDOW_SIZE, CONFIG_MAX_WINDOW_SIZE);}
+	else if (!isfinite(config->renderScale) || config->renderScale <= 0.0f || config->renderScale > 4.0f)
+	{printf("Render scale must be in (0, 4].\n");}
+	else if ((float)config->windowWidth * config->renderScale > (float)CONFIG_MAX_WINDOW_SIZE ||
+			(float)config->windowHeight * config->renderScale > (float)CONFIG_MAX_WINDOW_SIZE)
+	{printf("Internal render size must be at most %dx%d.\n", CONFIG_MAX_WINDOW_SIZE, CONFIG_MAX_WINDOW_SIZE);}
+	else if (config->numRays < 0 || config->numRays > 8192)
+	{printf("Number of rays must be in [0, 8192].\n");}
+	else if (!isfinite(config->fieldOfView) || config->fieldOfView <= 0.0f || config->fieldOfView >= (float)M_PI)
+	{printf("Field of view must be in (0, 180) degrees.\n");}
+	else if (!isfinite(config->stepScalar) || config->stepScalar <= 0.0f)
+	{printf("Step must be a positive finite number.\n");}
+	else if (!isfinite(config->mouseSensitivity) || config->mouseSensitivity <= 0.0f ||
+			config->mouseSensitivity > (float)M_PI / 18.0f)
+	{printf("Mouse sensitivity must be in (0, 10] degrees per pixel.\n");}
+	else if (config->mazeSize < 5 || config->mazeSize > CONFIG_MAX_MAZE_SIZE || config->mazeSize % 2 == 0)
+	{printf("Maze size must be odd and in [5, %d].\n", CONFIG_MAX_MAZE_SIZE);}
+	else if (!isfinite(config->frameBudgetMs) || config->frameBudgetMs <= 0.0f)
+	{printf("Frame budget must be a positive finite number.\n");}
+	else if (config->pipelinedFrames != 0 && config->pipelinedFrames != 1)
+	{printf("Pipelined frames must be 0 or 1.\n");}
+	else if (config->seed < 0)
+	{printf("Seed must not be negative.\n");}
+	else if (config->doorInterval < 0)
+	{printf("Door interval must not be negative.\n");}
+	else if (config->lowWallInterval < 0)
+	{printf("Low wall interval must not be negative.\n");}
+	else if (config->windowInterval < 0)
+	{printf("Window interval must not be negative.\n");}
+	else
+	{return 1;}
+	return 0;
+}
+
+/**
+ * Loads the configuration. Defaults are overridden by the configuration file, which is CONFIG_DEFAULT_PATH unless
+ * --config names another file, and the configuration file is overridden by the remaining command-line options. The
+ * result is validated, invalid or unknown options print a message and exit.
+ *
+ * @param config the configuration to be written
+ * @param argc 	 the number of command-line arguments
+ * @param argv 	 the command-line arguments
+ */
+void LoadConfig(Config* config, int argc, char* argv[])
+{
+	if (config == NULL)
+	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
+	SetDefaultConfig(config);
+	// The configuration file is applied first, so it is located before the other options are parsed
+	const char* path = NULL;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strncmp(argv[i], "--config=", 9) == 0)
+		{path = argv[i] + 9;}
+		else if (strcmp(argv[i], "--config") == 0 && i + 1 < argc)
+		{path = argv[i + 1];}
+	}
+	if (path != NULL && !LoadConfigFile(config, path))
+	{
+		printf("Configuration file %s could not be opened.\n", path);
+		ErrorHandler(INVALID_CONFIGURATION_ERROR);
+	}
+	if (path == NULL)
+	{LoadConfigFile(config, CONFIG_DEFAULT_PATH);}
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strncmp(argv[i], "--", 2) != 0)
+		{
+			printf("Unexpected argument %s.\n", argv[i]);
+			ErrorHandler(INVALID_CONFIGURATION_ERROR);
+		}
+		char key[CONFIG_MAX_LINE_LENGTH];
+		const char* value = NULL;
+		const char* separator = strchr(argv[i], '=');
+		size_t keyLength = separator != NULL ? (size_t)(separator - argv[i] - 2) : strlen(argv[i] + 2);
+		if (keyLength >= sizeof(key))
+		{keyLength = sizeof(key) - 1;}
+		memcpy(key, argv[i] + 2, keyLength);
+		key[keyLength] = '\0';
+		if (separator != NULL)
+		{value = separator + 1;}
+		else if (i + 1 < argc)
+		{value = argv[++i];}
+		if (KeysEqual(key, "config"))
+		{continue;}
+		if (value == NULL || !SetConfigValue(config, key, value))
+		{
+			printf("Invalid option --%s.\n", key);
+			ErrorHandler(INVALID_CONFIGURATION_ERROR);
+		}
+	}
+	if (!ValidateConfig(config))
+	{ErrorHandler(INVALID_CONFIGURATION_ERROR);}
+}
@@ -0,0 +1,83 @@
+#ifndef RAY_CASTING_MAZE_CONFIG_H_
+#define RAY_CASTING_MAZE_CONFIG_H_
+
+#define CONFIG_DEFAULT_PATH "rayCastingMaze.ini" // configuration file loaded when no --config option is given
+#define CONFIG_MAX_LINE_LENGTH 256               // maximum length of a line in a configuration file
+#define CONFIG_MAX_WINDOW_SIZE 16384             // maximum window and internal render size, keeps pixel indices in int
+#define CONFIG_MAX_MAZE_SIZE 4095                // maximum maze size, keeps cell indices in int
+
+/**
+ * Runtime configuration. Every field can be set in an ini-style file as "key = value" and on the command line as
+ * "--key=value" or "--key value", where dashes and underscores in keys are interchangeable.
+ */
+typedef struct Config_struct
+{
+	int windowWidth;          // window_width: SDL window width in pixels
+	int windowHeight;         // window_height: SDL window height in pixels
+	float renderScale;        // render_scale: internal render height relative to the window height
+	int numRays;              // rays: maximum number of rays, which is also the maximum internal render width, 0 to
+							  // derive it from the window width and the render scale
+	float fieldOfView;        // fov: field of view, given in degrees and stored in radians
+	float stepScalar;         // step: scale coefficient for change in player's position
+	float mouseSensitivity;   // mouse_sensitivity: mouse look turn per pixel of mouse motion, given in degrees and
+							  // stored in radians
+	int mazeSize;             // maze_size: side length of the square maze, in cells
+	int dynamicResolution;    // dynamic_resolution: 1 to adjust the internal render width to the frame budget
+	float frameBudgetMs;      // frame_budget_ms: render time budget per frame in milliseconds
+	int pipelinedFrames;      // pipelined_frames: 1 to render the next frame while the previous one is presented
+	int seed;                 // seed: seed of the maze, 0 to pick one from the clock
+	int doorInterval;         // door_interval: average number of corridor cells per door, 0 for no doors
+	int lowWallInterval;      // low_wall_interval: average number of inner walls per low wall, 0 for full walls only
+	int windowInterval;       // window_interval: average number of walls between two corridors per window, 0 for none
+	char recordPath[CONFIG_MAX_LINE_LENGTH]; // record: path the input log of the session is written to, empty to not
+											 // record
+} Config;
+
+/**
+ * Loads the configuration. Defaults are overridden by the configuration file, which is CONFIG_DEFAULT_PATH unless
+ * --config names another file, and the configuration file is overridden by the remaining command-line options. The
+ * result is validated, invalid or unknown options print a message and exit.
+ *
+ * @param config the configuration to be written
+ * @param argc 	 the number of command-line arguments
+ * @param argv 	 the command-line arguments
+ */
+void LoadConfig(Config* config, int argc, char* argv[]);
+
+/**
+ * Checks that every configuration value is usable, printing the first problem found. Float values must be finite, and
+ * the sizes are bounded so the cell and pixel indices computed from them fit in an int. LoadConfig() calls it, callers
+ * that override values afterwards call it again.
+ *
+ * @param config the configuration
+ * @return 1 if the configuration is valid, 0 otherwise
+ */
+int ValidateConfig(const Config* config);
+
+/**
+ * Sets every field of a configuration to its default value.
+ *
+ * @param config the configuration
+ */
+void SetDefaultConfig(Config* config);
+
+/**
+ * Sets one configuration field from its key and textual value.
+ *
+ * @param config the configuration
+ * @param key 	 the key, dashes and underscores are interchangeable
+ * @param value  the textual value
+ * @return 1 if the key is known and the value could be parsed, 0 otherwise
+ */
+int SetConfigValue(Config* config, const char* key, const char* value);
+
+/**
+ * Reads an ini-style configuration file. Blank lines, lines starting with '#' or ';' and section headers are ignored.
+ *
+ * @param config the configuration
+ * @param path 	 the path of the configuration file
+ * @return 1 if the file was read, 0 if it could not be opened
+ */
+int LoadConfigFile(Config* config, const char* path);
+
+#endif
@@ -0,0 +1,479 @@
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "DistanceField.h"
+#include "../WorkerPool/WorkerPool.h"
+#include "../ErrorHandler/ErrorHandler.h"
+#include "../Assert/Assert.h"
+
+#define GOAL_DISTANCE_AFFECTED (-2) // goal distance of a cell that lost all its shortest paths, while it is updated
+#define GOAL_DISTANCE_QUEUED (-3)   // a queued cell holds GOAL_DISTANCE_QUEUED minus its distance until it is checked
+
+/**
+ * Struct for one round of the wall distance calculation, shared by the worker threads.
+ */
+typedef struct WallDistanceRound_struct
+{
+	const unsigned char* previous; // distances after the previous round, WALL_DISTANCE_MAX for cells not reached yet
+	unsigned char* next;           // distances after this round
+	unsigned char* rowChanged;     // 1 for each row in which a cell was reached in this round
+	int mazeSize;                  // side length of the square maze grid
+	int round;                     // distance of the cells reached in this round
+} WallDistanceRound;
+
+/**
+ * Struct for a cell whose goal distance is recalculated after a wall was added.
+ */
+typedef struct GoalDistanceCandidate_struct
+{
+	int cell;     // index of the cell
+	int distance; // one more than the smallest distance of its unaffected neighbors, INT_MAX if none reaches the goal
+} GoalDistanceCandidate;
+
+/**
+ * Calculates the number of steps between each open cell of a maze and the goal cell, moving between neighboring open
+ * cells. The field is filled with a breadth-first search from the goal. Walking from any cell to a neighbor whose
+ * distance is one less leads to the goal along a shortest path.
+ *
+ * @param maze 		1D array representing the maze, each element in the array represents a cell in the maze grid
+ * @param wallValue the value of wall cells in the maze array
+ * @param mazeSize 	the side length of the square maze grid
+ * @param goal 		the index of the goal cell
+ * @param distances the array of mazeSize * mazeSize distances to be written, DISTANCE_FIELD_UNREACHABLE for walls and
+ * 					cells that can not reach the goal
+ */
+void CalculateGoalDistances(const int maze[], int wallValue, int mazeSize, int goal, int distances[])
+{
+	RCM_ASSERT_NOT_NULL(maze);
+	RCM_ASSERT_NOT_NULL(distances);
+	RCM_ASSERT(goal >= 0 && goal < mazeSize * mazeSize, UNKNOWN_ERROR);
+	const int numCells = mazeSize * mazeSize;
+	for (int i = 0; i < numCells; ++i)
+	{distances[i] = DISTANCE_FIELD_UNREACHABLE;}
+	if (maze[goal] == wallValue)
+	{return;}
+	// A perfect maze is a tree, so the search frontier stays a few cells wide and the search is not worth splitting
+	// between threads
+	int* queue = (int*)calloc(numCells, sizeof(int));
+	if (queue == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	const int offsets[4] = {-mazeSize, mazeSize, -1, 1}; // up, down, left, right
+	int head = 0;
+	int tail = 0;
+	queue[tail++] = goal;
+	distances[goal] = 0;
+	while (head < tail)
+	{
+		int cell = queue[head++];
+		for (int i = 0; i < 4; ++i)
+		{
+			// The maze border is made of walls, so neighbors of open cells never leave the grid
+			int neighbor = cell + offsets[i];
+			if (maze[neighbor] == wallValue || distances[neighbor] != DISTANCE_FIELD_UNREACHABLE)
+			{continue;}
+			distances[neighbor] = distances[cell] + 1;
+			queue[tail++] = neighbor;
+		}
+	}
+	free(queue);
+}
+
+/**
+ * Runs one round of the wall distance calculation over a range of rows: each cell not reached yet that touches a cell
+ * reached in the previous round, including diagonally, is reached in this round. Cells outside the maze count as
+ * walls. Only the previous distances are read, so rows can be processed in any order by any thread.
+ *
+ * @param begin   the first row
+ * @param end 	  one past the last row
+ * @param context the WallDistanceRound
+ */
+static void RunWallDistanceRound(int begin, int end, void* context)
+{
+	const WallDistanceRound* round = (const WallDistanceRound*)context;
+	const int size = round->mazeSize;
+	const unsigned char reachedBefore = (unsigned char)(round->round - 1);
+	for (int y = begin; y < end; ++y)
+	{
+		int isRowChanged = 0;
+		for (int x = 0; x < size; ++x)
+		{
+			int cell = y * size + x;
+			unsigned char distance = round->previous[cell];
+			if (distance == WALL_DISTANCE_MAX)
+			{
+				int isTouching = reachedBefore == 0 && (x == 0 || y == 0 || x == size - 1 || y == size - 1);
+				for (int ny = y > 0 ? y - 1 : 0; ny <= y + 1 && ny < size && !isTouching; ++ny)
+				{
+					for (int nx = x > 0 ? x - 1 : 0; nx <= x + 1 && nx < size; ++nx)
+					{
+						if (round->previous[ny * size + nx] == reachedBefore)
+						{
+							isTouching = 1;
+							break;
+						}
+					}
+				}
+				if (isTouching)
+				{
+					distance = (unsigned char)round->round;
+					isRowChanged = 1;
+				}
+			}
+			round->next[cell] = distance;
+		}
+		round->rowChanged[y] = (unsigned char)isRowChanged;
+	}
+}
+
+/**
+ * Calculates the Chebyshev distance in cells between each cell of a maze and the nearest wall: 0 for walls, 1 for open
+ * cells touching a wall, including diagonally, and so on. A cell at distance d is the center of a square of
+ * 2 * d - 1 cells on each side that holds no wall, which lets a ray skip that square at once. Cells outside the maze
+ * count as walls. The field grows one cell per round from the walls, each round is split between worker threads in
+ * bands of rows.
+ *
+ * @param maze 		 1D array representing the maze, each element in the array represents a cell in the maze grid
+ * @param openValue  the value of open cells in the maze array, every other cell counts as a wall
+ * @param mazeSize 	 the side length of the square maze grid
+ * @param distances  the array of mazeSize * mazeSize distances to be written, clamped to WALL_DISTANCE_MAX
+ * @param workerPool the worker threads used to split the rounds, NULL to calculate serially
+ */
+void CalculateWallDistances(const int maze[], int openValue, int mazeSize, unsigned char distances[],
+		struct WorkerPool_struct* workerPool)
+{
+	RCM_ASSERT_NOT_NULL(maze);
+	RCM_ASSERT_NOT_NULL(distances);
+	const int numCells = mazeSize * mazeSize;
+	// Rounds alternate between the output array and a scratch array, a round never reads what it writes
+	unsigned char* scratch = (unsigned char*)calloc(numCells, sizeof(unsigned char));
+	unsigned char* rowChanged = (unsigned char*)calloc(mazeSize, sizeof(unsigned char));
+	if (scratch == NULL || rowChanged == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	for (int i = 0; i < numCells; ++i)
+	{distances[i] = maze[i] == openValue ? WALL_DISTANCE_MAX : 0;}
+	WallDistanceRound round = {distances, scratch, rowChanged, mazeSize, 1};
+	// Cells still not reached after the last round are at least WALL_DISTANCE_MAX cells from a wall
+	for (; round.round < WALL_DISTANCE_MAX; ++round.round)
+	{
+		RunParallelFor(workerPool, mazeSize, WALL_DISTANCE_ROW_BAND_SIZE, RunWallDistanceRound, &round);
+		unsigned char* written = round.next;
+		round.next = (unsigned char*)round.previous;
+		round.previous = written;
+		int isChanged = 0;
+		for (int y = 0; y < mazeSize && !isChanged; ++y)
+		{isChanged = rowChanged[y];}
+		if (!isChanged)
+		{break;}
+	}
+	if (round.previous != distances)
+	{memcpy(distances, round.previous, (size_t)numCells);}
+	free(scratch);
+	free(rowChanged);
+}
+
+/**
+ * Lowers the goal distances after a wall was removed: the cell gets one more than its nearest neighbor, then a
+ * breadth-first search from the cell lowers the distances of the cells that now reach the goal sooner through it.
+ *
+ * @param maze 		1D array representing the maze
+ * @param wallValue the value of wall cells in the maze array
+ * @param offsets 	the index offsets of the four neighbors of a cell
+ * @param goal 		the index of the goal cell
+ * @param distances the goal distances, updated in place
+ * @param cell 		the index of the new open cell
+ * @param queue 	the scratch array of one entry per cell
+ */
+static void LowerGoalDistances(const int maze[], int wallValue, const int offsets[4], int goal, int distances[],
+		int cell, int queue[])
+{
+	int distance = cell == goal ? 0 : DISTANCE_FIELD_UNREACHABLE;
+	for (int i = 0; i < 4 && cell != goal; ++i)
+	{
+		int neighbor = distances[cell + offsets[i]];
+		if (neighbor >= 0 && (distance < 0 || neighbor + 1 < distance))
+		{distance = neighbor + 1;}
+	}
+	distances[cell] = distance;
+	if (distance == DISTANCE_FIELD_UNREACHABLE)
+	{return;}
+	// Distances only drop, each cell is queued at most once since the first lower distance it gets is final
+	int head = 0;
+	int tail = 0;
+	queue[tail++] = cell;
+	while (head < tail)
+	{
+		int current = queue[head++];
+		for (int i = 0; i < 4; ++i)
+		{
+			int neighbor = current + offsets[i];
+			if (maze[neighbor] == wallValue || (distances[neighbor] != DISTANCE_FIELD_UNREACHABLE &&
+					distances[neighbor] <= distances[current] + 1))
+			{continue;}
+			distances[neighbor] = distances[current] + 1;
+			queue[tail++] = neighbor;
+		}
+	}
+}
+
+/**
+ * Orders goal distance candidates by distance, used with qsort().
+ *
+ * @param a the first candidate
+ * @param b the second candidate
+ * @return a negative value if the first candidate is nearer to the goal, a positive value if it is farther, 0 otherwise
+ */
+static int CompareGoalDistanceCandidates(const void* a, const void* b)
+{
+	int distanceA = ((const GoalDistanceCandidate*)a)->distance;
+	int distanceB = ((const GoalDistanceCandidate*)b)->distance;
+	return (distanceA > distanceB) - (distanceA < distanceB);
+}
+
+/**
+ * Raises the goal distances after a wall was added. The cells that lost all their shortest paths are found first:
+ * starting from the neighbors one step farther than the wall, in breadth-first order, a cell is affected if none of its
+ * neighbors one step nearer to the goal is unaffected, and only the neighbors of affected cells are checked. Then the
+ * affected cells are given their new distance from the unaffected cells around them, nearest first, by merging the
+ * candidates sorted by distance with a breadth-first search through the affected cells. Affected cells left over no
+ * longer reach the goal.
+ *
+ * @param offsets 	the index offsets of the four neighbors of a cell
+ * @param distances the goal distances, updated in place
+ * @param cell 		the index of the new wall
+ * @param queue 	the scratch array of one entry per cell
+ */
+static void RaiseGoalDistances(const int offsets[4], int distances[], int cell, int queue[])
+{
+	int wallDistance = distances[cell];
+	distances[cell] = DISTANCE_FIELD_UNREACHABLE;
+	if (wallDistance == DISTANCE_FIELD_UNREACHABLE)
+	{return;}
+	int head = 0;
+	int tail = 0;
+	int numAffected = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		int neighbor = cell + offsets[i];
+		if (distances[neighbor] == wallDistance + 1)
+		{
+			distances[neighbor] = GOAL_DISTANCE_QUEUED - distances[neighbor];
+			queue[tail++] = neighbor;
+		}
+	}
+	// Cells are queued by increasing distance, so the neighbors nearer to the goal of a cell are settled before it
+	while (head < tail)
+	{
+		int current = queue[head++];
+		int distance = GOAL_DISTANCE_QUEUED - distances[current];
+		int isSupported = 0;
+		for (int i = 0; i < 4 && !isSupported; ++i)
+		{isSupported = distances[current + offsets[i]] == distance - 1;}
+		if (isSupported)
+		{
+			distances[current] = distance;
+			continue;
+		}
+		distances[current] = GOAL_DISTANCE_AFFECTED;
+		// The affected cells are gathered at the front of the queue, in the entries already taken
+		queue[numAffected++] = current;
+		for (int i = 0; i < 4; ++i)
+		{
+			int neighbor = current + offsets[i];
+			if (distances[neighbor] == distance + 1)
+			{
+				distances[neighbor] = GOAL_DISTANCE_QUEUED - distances[neighbor];
+				queue[tail++] = neighbor;
+			}
+		}
+	}
+	if (numAffected == 0)
+	{return;}
+
+	GoalDistanceCandidate* candidates = (GoalDistanceCandidate*)calloc(numAffected, sizeof(GoalDistanceCandidate));
+	int* settled = (int*)calloc(numAffected, sizeof(int));
+	if (candidates == NULL || settled == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	for (int i = 0; i < numAffected; ++i)
+	{
+		candidates[i].cell = queue[i];
+		candidates[i].distance = INT_MAX;
+		for (int j = 0; j < 4; ++j)
+		{
+			int neighbor = distances[queue[i] + offsets[j]];
+			if (neighbor >= 0 && neighbor + 1 < candidates[i].distance)
+			{candidates[i].distance = neighbor + 1;}
+		}
+	}
+	qsort(candidates, (size_t)numAffected, sizeof(GoalDistanceCandidate), CompareGoalDistanceCandidates);
+	// Both the candidates and the settled cells come in increasing distance, the nearer of the two is taken each time
+	int next = 0;
+	head = 0;
+	tail = 0;
+	for (;;)
+	{
+		int current;
+		if (head < tail && (next == numAffected || distances[settled[head]] <= candidates[next].distance))
+		{current = settled[head++];}
+		else if (next < numAffected && candidates[next].distance != INT_MAX)
+		{
+			const GoalDistanceCandidate* candidate = &candidates[next++];
+			if (distances[candidate->cell] != GOAL_DISTANCE_AFFECTED)
+			{continue;}
+			distances[candidate->cell] = candidate->distance;
+			current = candidate->cell;
+		}
+		else
+		{break;}
+		for (int i = 0; i < 4; ++i)
+		{
+			int neighbor = current + offsets[i];
+			if (distances[neighbor] == GOAL_DISTANCE_AFFECTED)
+			{
+				distances[neighbor] = distances[current] + 1;
+				settled[tail++] = neighbor;
+			}
+		}
+	}
+	for (int i = 0; i < numAffected; ++i)
+	{
+		if (distances[queue[i]] == GOAL_DISTANCE_AFFECTED)
+		{distances[queue[i]] = DISTANCE_FIELD_UNREACHABLE;}
+	}
+	free(candidates);
+	free(settled);
+}
+
+/**
+ * Updates the goal distances after one cell turned into a wall or into an open cell, touching only the cells whose
+ * distance changes. A new open cell lowers the distances behind it with a breadth-first search from the cell. A new
+ * wall first finds the cells whose every shortest path ran through it, in breadth-first order, then gives them their
+ * new distance from the unaffected cells around them.
+ *
+ * @param maze 		1D array representing the maze, already holding the new value of the cell
+ * @param wallValue the value of wall cells in the maze array
+ * @param mazeSize 	the side length of the square maze grid
+ * @param goal 		the index of the goal cell
+ * @param distances the goal distances of the maze before the change, updated in place
+ * @param cell 		the index of the changed cell, must not be on the border of the maze
+ * @param queue 	the scratch array of mazeSize * mazeSize cells used by the searches
+ */
+void UpdateGoalDistances(const int maze[], int wallValue, int mazeSize, int goal, int distances[], int cell,
+		int queue[])
+{
+	RCM_ASSERT_NOT_NULL(maze);
+	RCM_ASSERT_NOT_NULL(distances);
+	RCM_ASSERT_NOT_NULL(queue);
+	RCM_ASSERT(goal >= 0 && goal < mazeSize * mazeSize, UNKNOWN_ERROR);
+	// The searches rely on the border of walls to never leave the grid
+	RCM_ASSERT(cell % mazeSize > 0 && cell % mazeSize < mazeSize - 1 && cell / mazeSize > 0 &&
+			cell / mazeSize < mazeSize - 1, UNKNOWN_ERROR);
+	const int offsets[4] = {-mazeSize, mazeSize, -1, 1}; // up, down, left, right
+	if (maze[cell] != wallValue)
+	{LowerGoalDistances(maze, wallValue, offsets, goal, distances, cell, queue);}
+	else if (cell == goal)
+	{CalculateGoalDistances(maze, wallValue, mazeSize, goal, distances);}
+	else
+	{RaiseGoalDistances(offsets, distances, cell, queue);}
+}
+
+/**
+ * Searches the Chebyshev distance from a cell to the nearest wall ring by ring, nearest first. Cells outside the maze
+ * count as walls.
+ *
+ * @param maze 		1D array representing the maze
+ * @param openValue the value of open cells in the maze array, every other cell counts as a wall
+ * @param mazeSize 	the side length of the square maze grid
+ * @param x 		the column of the cell
+ * @param y 		the row of the cell
+ * @return the wall distance, clamped to WALL_DISTANCE_MAX
+ */
+static unsigned char FindWallDistance(const int maze[], int openValue, int mazeSize, int x, int y)
+{
+	if (maze[y * mazeSize + x] != openValue)
+	{return 0;}
+	// The nearest cell outside the maze bounds the search, the rings before it lie inside the maze
+	int limit = x < y ? x : y;
+	limit = mazeSize - 1 - x < limit ? mazeSize - 1 - x : limit;
+	limit = mazeSize - 1 - y < limit ? mazeSize - 1 - y : limit;
+	limit = limit + 1 < WALL_DISTANCE_MAX ? limit + 1 : WALL_DISTANCE_MAX;
+	for (int ring = 1; ring < limit; ++ring)
+	{
+		for (int i = -ring; i <= ring; ++i)
+		{
+			if (maze[(y - ring) * mazeSize + x + i] != openValue || maze[(y + ring) * mazeSize + x + i] != openValue ||
+					maze[(y + i) * mazeSize + x - ring] != openValue || maze[(y + i) * mazeSize + x + ring] != openValue)
+			{return (unsigned char)ring;}
+		}
+	}
+	return (unsigned char)limit;
+}
+
+/**
+ * Updates the wall distances of the cells on the square ring at a Chebyshev distance from a changed cell, clipped to
+ * the maze. Around a new wall, a distance larger than the ring drops to it. Around a removed wall, the cells whose
+ * distance equals the ring may have had the removed wall as their nearest one and are searched again.
+ *
+ * @param maze 		1D array representing the maze, already holding the new value of the cell
+ * @param openValue the value of open cells in the maze array, every other cell counts as a wall
+ * @param mazeSize 	the side length of the square maze grid
+ * @param distances the wall distances, updated in place
+ * @param centerX 	the column of the changed cell
+ * @param centerY 	the row of the changed cell
+ * @param ring 		the Chebyshev distance of the ring from the changed cell
+ * @return 1 if a cell of the ring may depend on the changed cell, 0 otherwise
+ */
+static int UpdateWallDistanceRing(const int maze[], int openValue, int mazeSize, unsigned char distances[],
+		int centerX, int centerY, int ring)
+{
+	const int isWall = maze[centerY * mazeSize + centerX] != openValue;
+	int isAffected = 0;
+	int yBegin = centerY - ring > 0 ? centerY - ring : 0;
+	int yLast = centerY + ring < mazeSize - 1 ? centerY + ring : mazeSize - 1;
+	for (int y = yBegin; y <= yLast; ++y)
+	{
+		// The top and bottom rows of the ring are full, the rows in between only hold their two ends
+		int step = y == centerY - ring || y == centerY + ring ? 1 : 2 * ring;
+		for (int x = centerX - ring; x <= centerX + ring; x += step)
+		{
+			if (x < 0 || x >= mazeSize)
+			{continue;}
+			unsigned char* distance = &distances[y * mazeSize + x];
+			if (isWall && *distance > ring)
+			{
+				*distance = (unsigned char)ring;
+				isAffected = 1;
+			}
+			else if (!isWall && *distance == ring)
+			{
+				*distance = FindWallDistance(maze, openValue, mazeSize, x, y);
+				isAffected = 1;
+			}
+		}
+	}
+	return isAffected;
+}
+
+/**
+ * Updates the wall distances after one cell turned into a wall or into an open cell. A distance changes by at most one
+ * from a cell to its neighbor, so the update walks the square rings around the changed cell and stops at the first ring
+ * in which no cell could have changed, which is usually a few cells away.
+ *
+ * @param maze 		1D array representing the maze, already holding the new value of the cell
+ * @param openValue the value of open cells in the maze array, every other cell counts as a wall
+ * @param mazeSize 	the side length of the square maze grid
+ * @param distances the wall distances of the maze before the change, updated in place
+ * @param cell 		the index of the changed cell
+ */
+void UpdateWallDistances(const int maze[], int openValue, int mazeSize, unsigned char distances[], int cell)
+{
+	RCM_ASSERT_NOT_NULL(maze);
+	RCM_ASSERT_NOT_NULL(distances);
+	RCM_ASSERT(cell >= 0 && cell < mazeSize * mazeSize, UNKNOWN_ERROR);
+	// If no cell of a ring depends on the changed cell, no cell of a farther ring does either: a cell on the next ring
+	// with the changed cell as its nearest wall would have a neighbor on this ring in the same situation
+	for (int ring = 0; ring < WALL_DISTANCE_MAX; ++ring)
+	{
+		if (!UpdateWallDistanceRing(maze, openValue, mazeSize, distances, cell % mazeSize, cell / mazeSize, ring))
+		{break;}
+	}
+}
@@ -0,0 +1,70 @@
+#ifndef RAY_CASTING_MAZE_DISTANCEFIELD_H_
+#define RAY_CASTING_MAZE_DISTANCEFIELD_H_
+
+#define DISTANCE_FIELD_UNREACHABLE (-1)    // goal distance of walls and of open cells not connected to the goal
+#define WALL_DISTANCE_MAX 255              // largest wall distance stored, farther cells are clamped to it
+#define WALL_DISTANCE_ROW_BAND_SIZE 64     // number of rows claimed at a time by a worker thread
+
+struct WorkerPool_struct;
+
+/**
+ * Calculates the number of steps between each open cell of a maze and the goal cell, moving between neighboring open
+ * cells. The field is filled with a breadth-first search from the goal. Walking from any cell to a neighbor whose
+ * distance is one less leads to the goal along a shortest path.
+ *
+ * @param maze 		1D array representing the maze, each element in the array represents a cell in the maze grid
+ * @param wallValue the value of wall cells in the maze array
+ * @param mazeSize 	the side length of the square maze grid
+ * @param goal 		the index of the goal cell
+ * @param distances the array of mazeSize * mazeSize distances to be written, DISTANCE_FIELD_UNREACHABLE for walls and
+ * 					cells that can not reach the goal
+ */
+void CalculateGoalDistances(const int maze[], int wallValue, int mazeSize, int goal, int distances[]);
+
+/**
+ * Calculates the Chebyshev distance in cells between each cell of a maze and the nearest wall: 0 for walls, 1 for open
+ * cells touching a wall, including diagonally, and so on. A cell at distance d is the center of a square of
+ * 2 * d - 1 cells on each side that holds no wall, which lets a ray skip that square at once. Cells outside the maze
+ * count as walls. The field grows one cell per round from the walls, each round is split between worker threads in
+ * bands of rows.
+ *
+ * @param maze 		 1D array representing the maze, each element in the array represents a cell in the maze grid
+ * @param openValue  the value of open cells in the maze array, every other cell counts as a wall
+ * @param mazeSize 	 the side length of the square maze grid
+ * @param distances  the array of mazeSize * mazeSize distances to be written, clamped to WALL_DISTANCE_MAX
+ * @param workerPool the worker threads used to split the rounds, NULL to calculate serially
+ */
+void CalculateWallDistances(const int maze[], int openValue, int mazeSize, unsigned char distances[],
+		struct WorkerPool_struct* workerPool);
+
+/**
+ * Updates the goal distances after one cell turned into a wall or into an open cell, touching only the cells whose
+ * distance changes. A new open cell lowers the distances behind it with a breadth-first search from the cell. A new
+ * wall first finds the cells whose every shortest path ran through it, in breadth-first order, then gives them their
+ * new distance from the unaffected cells around them.
+ *
+ * @param maze 		1D array representing the maze, already holding the new value of the cell
+ * @param wallValue the value of wall cells in the maze array
+ * @param mazeSize 	the side length of the square maze grid
+ * @param goal 		the index of the goal cell
+ * @param distances the goal distances of the maze before the change, updated in place
+ * @param cell 		the index of the changed cell, must not be on the border of the maze
+ * @param queue 	the scratch array of mazeSize * mazeSize cells used by the searches
+ */
+void UpdateGoalDistances(const int maze[], int wallValue, int mazeSize, int goal, int distances[], int cell,
+		int queue[]);
+
+/**
+ * Updates the wall distances after one cell turned into a wall or into an open cell. A distance changes by at most one
+ * from a cell to its neighbor, so the update walks the square rings around the changed cell and stops at the first ring
+ * in which no cell could have changed, which is usually a few cells away.
+ *
+ * @param maze 		1D array representing the maze, already holding the new value of the cell
+ * @param openValue the value of open cells in the maze array, every other cell counts as a wall
+ * @param mazeSize 	the side length of the square maze grid
+ * @param distances the wall distances of the maze before the change, updated in place
+ * @param cell 		the index of the changed cell
+ */
+void UpdateWallDistances(const int maze[], int openValue, int mazeSize, unsigned char distances[], int cell);
+
+#endif
@@ -0,0 +1,73 @@
+#include <stdlib.h>
+#include "DynamicResolution.h"
+#include "../ErrorHandler/ErrorHandler.h"
+
+/**
+ * Creates a dynamic resolution controller starting at the maximum width.
+ *
+ * @param minWidth 		the lowest internal width
+ * @param maxWidth 		the highest internal width
+ * @param stepWidth 	the change in width per adjustment
+ * @param frameBudgetMs the frame time budget in milliseconds
+ * @return the dynamic resolution controller
+ */
+DynamicResolution* CreateDynamicResolution(int minWidth, int maxWidth, int stepWidth, double frameBudgetMs)
+{
+	DynamicResolution* controller = (DynamicResolution*)calloc(1, sizeof(DynamicResolution));
+	if (controller == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	controller->minWidth = minWidth < maxWidth ? minWidth : maxWidth;
+	controller->maxWidth = maxWidth;
+	controller->stepWidth = stepWidth > 0 ? stepWidth : 1;
+	controller->currentWidth = maxWidth;
+	controller->frameBudgetMs = frameBudgetMs;
+	controller->averageFrameMs = 0.0;
+	controller->framesSinceChange = 0;
+	return controller;
+}
+
+/**
+ * Frees the memory allocated for the given dynamic resolution controller.
+ *
+ * @param controller the given dynamic resolution controller
+ */
+void DestroyDynamicResolution(DynamicResolution* controller)
+{
+	if (controller == NULL)
+	{return;}
+	free(controller);
+}
+
+/**
+ * Records the time of the last frame and adjusts the internal width. The width is lowered when the smoothed frame time
+ * exceeds the budget and raised when there is headroom.
+ *
+ * @param controller the dynamic resolution controller
+ * @param frameMs 	 the time spent rendering the last frame in milliseconds, excluding the wait for presentation
+ * @return the internal width for the next frame
+ */
+int UpdateDynamicResolution(DynamicResolution* controller, double frameMs)
+{
+	if (controller == NULL)
+	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
+	if (controller->averageFrameMs == 0.0)
+	{controller->averageFrameMs = frameMs;}
+	controller->averageFrameMs += DYNAMIC_RESOLUTION_SMOOTHING * (frameMs - controller->averageFrameMs);
+	if (++(controller->framesSinceChange) < DYNAMIC_RESOLUTION_COOLDOWN)
+	{return controller->currentWidth;}
+	int width = controller->currentWidth;
+	if (controller->averageFrameMs > controller->frameBudgetMs * DYNAMIC_RESOLUTION_UPPER_BOUND)
+	{width -= controller->stepWidth;}
+	else if (controller->averageFrameMs < controller->frameBudgetMs * DYNAMIC_RESOLUTION_LOWER_BOUND)
+	{width += controller->stepWidth;}
+	width = width < controller->minWidth ? controller->minWidth : width;
+	width = width > controller->maxWidth ? controller->maxWidth : width;
+	if (width != controller->currentWidth)
+	{
+		// Render cost scales with the width, so the average is rescaled instead of waiting for it to settle
+		controller->averageFrameMs *= (double)width / (double)controller->currentWidth;
+		controller->currentWidth = width;
+		controller->framesSinceChange = 0;
+	}
+	return controller->currentWidth;
+}
@@ -0,0 +1,53 @@
+#ifndef RAY_CASTING_MAZE_DYNAMICRESOLUTION_H_
+#define RAY_CASTING_MAZE_DYNAMICRESOLUTION_H_
+
+#define DYNAMIC_RESOLUTION_SMOOTHING 0.1     // weight of the newest frame time in the moving average
+#define DYNAMIC_RESOLUTION_UPPER_BOUND 1.0   // fraction of the budget above which the width is lowered
+#define DYNAMIC_RESOLUTION_LOWER_BOUND 0.75  // fraction of the budget below which the width is raised
+#define DYNAMIC_RESOLUTION_COOLDOWN 30       // number of frames between two width changes
+
+/**
+ * Controller adjusting the internal render width to keep the frame time within a budget. The frame time is smoothed
+ * with an exponential moving average, and the width only changes after a cooldown and outside a band around the
+ * budget, so the resolution does not oscillate from frame to frame.
+ */
+typedef struct DynamicResolution_struct
+{
+	int minWidth;           // lowest internal width
+	int maxWidth;           // highest internal width
+	int stepWidth;          // change in width per adjustment
+	int currentWidth;       // current internal width
+	double frameBudgetMs;   // frame time budget in milliseconds
+	double averageFrameMs;  // smoothed frame time in milliseconds
+	int framesSinceChange;  // frames since the last width change
+} DynamicResolution;
+
+/**
+ * Creates a dynamic resolution controller starting at the maximum width.
+ *
+ * @param minWidth 		the lowest internal width
+ * @param maxWidth 		the highest internal width
+ * @param stepWidth 	the change in width per adjustment
+ * @param frameBudgetMs the frame time budget in milliseconds
+ * @return the dynamic resolution controller
+ */
+DynamicResolution* CreateDynamicResolution(int minWidth, int maxWidth, int stepWidth, double frameBudgetMs);
+
+/**
+ * Frees the memory allocated for the given dynamic resolution controller.
+ *
+ * @param controller the given dynamic resolution controller
+ */
+void DestroyDynamicResolution(DynamicResolution* controller);
+
+/**
+ * Records the time of the last frame and adjusts the internal width. The width is lowered when the smoothed frame time
+ * exceeds the budget and raised when there is headroom.
+ *
+ * @param controller the dynamic resolution controller
+ * @param frameMs 	 the time spent rendering the last frame in milliseconds, excluding the wait for presentation
+ * @return the internal width for the next frame
+ */
+int UpdateDynamicResolution(DynamicResolution* controller, double frameMs);
+
+#endif
@@ -21,6 +21,9 @@ void ErrorHandler(int errorCode)
 	case POPPING_FROM_EMPTY_STACK_ERROR:
 		printf("ErrCode: %d. Popping from empty stack.", POPPING_FROM_EMPTY_STACK_ERROR);
 		exit(POPPING_FROM_EMPTY_STACK_ERROR);
+	case INVALID_CONFIGURATION_ERROR:
+		printf("ErrCode: %d. Invalid configuration.", INVALID_CONFIGURATION_ERROR);
+		exit(INVALID_CONFIGURATION_ERROR);
 	default:
 		printf("ErrCode: %d. Unknown error.", UNKNOWN_ERROR);
 		exit(UNKNOWN_ERROR);
@@ -5,6 +5,7 @@
 #define MEMORY_ALLOCATION_ERROR 1
 #define ACCESSING_NULL_POINTER_ERROR 2
 #define POPPING_FROM_EMPTY_STACK_ERROR 3
+#define INVALID_CONFIGURATION_ERROR 4
 #define UNKNOWN_ERROR 9
 
 /**
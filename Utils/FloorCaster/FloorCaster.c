@@ -0,0 +1,242 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <math.h>
+#include "FloorCaster.h"
+#include "../ErrorHandler/ErrorHandler.h"
+#include "../RayCaster/RayCaster.h"
+
+/**
+ * Packs color channels into an opaque ARGB8888 pixel.
+ *
+ * @param r the red channel
+ * @param g the green channel
+ * @param b the blue channel
+ * @return the packed pixel
+ */
+static uint32_t PackColor(uint32_t r, uint32_t g, uint32_t b)
+{
+	return 0xFF000000u | (r << 16) | (g << 8) | b;
+}
+
+/**
+ * Generates the procedural floor and ceiling textures. The floor is a tile with darker grout lines and the ceiling is
+ * a plain panel with a dark border, both close to the flat grays used before floor casting.
+ *
+ * @param floorCaster the floor caster
+ */
+static void GenerateTextures(FloorCaster* floorCaster)
+{
+	for (int y = 0; y < FLOOR_TEXTURE_SIZE; ++y)
+	{
+		for (int x = 0; x < FLOOR_TEXTURE_SIZE; ++x)
+		{
+			int isGrout = x % (FLOOR_TEXTURE_SIZE / 2) == 0 || y % (FLOOR_TEXTURE_SIZE / 2) == 0;
+			int isBorder = x == 0 || y == 0 || x == FLOOR_TEXTURE_SIZE - 1 || y == FLOOR_TEXTURE_SIZE - 1;
+			uint32_t noise = (uint32_t)((x * 7 + y * 13) ^ (x * y)) & 7u;
+			floorCaster->floorTexture[y * FLOOR_TEXTURE_SIZE + x] = isGrout
+					? PackColor(40, 40, 40) : PackColor(62 + noise, 62 + noise, 62 + noise);
+			floorCaster->ceilingTexture[y * FLOOR_TEXTURE_SIZE + x] = isBorder
+					? PackColor(70, 70, 70) : PackColor(92 + noise / 2, 92 + noise / 2, 92 + noise / 2);
+		}
+	}
+}
+
+/**
+ * Creates a floor caster for frame buffers of the given height. The perpendicular distance and the shading level of
+ * each row are computed here, since they only depend on the frame buffer height. The width may change every frame.
+ *
+ * @param height 	   the frame buffer height
+ * @param mapCellSize  the size of each cell in the map grid
+ * @param shadingTable the lighting and fog lookup tables
+ * @return the floor caster
+ */
+FloorCaster* CreateFloorCaster(int height, float mapCellSize, const ShadingTable* shadingTable)
+{
+	if (shadingTable == NULL)
+	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
+	FloorCaster* floorCaster = (FloorCaster*)calloc(1, sizeof(FloorCaster));
+	if (floorCaster == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	floorCaster->height = height;
+	floorCaster->numRows = height / 2;
+	floorCaster->textureScale = (float)FLOOR_TEXTURE_SIZE / mapCellSize;
+	floorCaster->shadingTable = shadingTable;
+	floorCaster->rowDistances = (float*)calloc(floorCaster->numRows, sizeof(float));
+	floorCaster->rowShadeLevels = (int*)calloc(floorCaster->numRows, sizeof(int));
+	floorCaster->rowStartX = (float*)calloc(floorCaster->numRows, sizeof(float));
+	floorCaster->rowStartY = (float*)calloc(floorCaster->numRows, sizeof(float));
+	floorCaster->rowStepX = (float*)calloc(floorCaster->numRows, sizeof(float));
+	floorCaster->rowStepY = (float*)calloc(floorCaster->numRows, sizeof(float));
+	floorCaster->floorTexture = (uint32_t*)calloc(FLOOR_TEXTURE_SIZE * FLOOR_TEXTURE_SIZE, sizeof(uint32_t));
+	floorCaster->ceilingTexture = (uint32_t*)calloc(FLOOR_TEXTURE_SIZE * FLOOR_TEXTURE_SIZE, sizeof(uint32_t));
+	if (floorCaster->rowDistances == NULL || floorCaster->rowShadeLevels == NULL || floorCaster->rowStartX == NULL || floorCaster->rowStartY == NULL ||
+			floorCaster->rowStepX == NULL || floorCaster->rowStepY == NULL || floorCaster->floorTexture == NULL ||
+			floorCaster->ceilingTexture == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	// A wall at perpendicular distance d spans RAY_HEIGHT_COEFFICIENT * height / d pixels centered on the horizon, so
+	// the floor seen p pixels below the horizon is at distance RAY_HEIGHT_COEFFICIENT * height / (2 * p). Sampling at
+	// the pixel center keeps the first row finite.
+	for (int row = 0; row < floorCaster->numRows; ++row)
+	{
+		float pixelsBelowHorizon = (float)row + 0.5f;
+		floorCaster->rowDistances[row] = RAY_HEIGHT_COEFFICIENT * (float)height / (2.0f * pixelsBelowHorizon);
+		floorCaster->rowShadeLevels[row] = GetShadeLevel(shadingTable, floorCaster->rowDistances[row]);
+	}
+	GenerateTextures(floorCaster);
+	return floorCaster;
+}
+
+/**
+ * Frees the memory allocated for the given floor caster.
+ *
+ * @param floorCaster the given floor caster
+ */
+void DestroyFloorCaster(FloorCaster* floorCaster)
+{
+	if (floorCaster == NULL)
+	{return;}
+	free(floorCaster->rowDistances);
+	free(floorCaster->rowShadeLevels);
+	free(floorCaster->rowStartX);
+	free(floorCaster->rowStartY);
+	free(floorCaster->rowStepX);
+	free(floorCaster->rowStepY);
+	free(floorCaster->floorTexture);
+	free(floorCaster->ceilingTexture);
+	free(floorCaster);
+}
+
+/**
+ * Precomputes the per-row constants for the current frame from the player position, the player direction and the
+ * camera plane derived from the field of view. The target must have the height the floor caster was created with.
+ *
+ * @param floorCaster 	  the floor caster
+ * @param target 		  the frame buffer to be written
+ * @param playerPosition  the vector representing the player position
+ * @param playerDirection the vector representing the direction that the player is facing, this vector is a unit
+ * 						  vector
+ * @param fieldOfView 	  the angle in radians
+ */
+void PrepareFloorCasterFrame(FloorCaster* floorCaster, FrameBuffer* target, const Vec3* playerPosition,
+		const Vec3* playerDirection, float fieldOfView)
+{
+	if (floorCaster == NULL || target == NULL || playerPosition == NULL || playerDirection == NULL)
+	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
+	floorCaster->target = target;
+	floorCaster->width = target->width;
+	// The camera plane is perpendicular to the player direction, pointing to the right of the screen
+	float planeLength = tanf(fieldOfView / 2.0f);
+	float planeX = -playerDirection->y * planeLength;
+	float planeY = playerDirection->x * planeLength;
+	// Direction of the ray through the center of the leftmost column, and the change in direction per column
+	float columnStepX = 2.0f * planeX / (float)floorCaster->width;
+	float columnStepY = 2.0f * planeY / (float)floorCaster->width;
+	float leftRayX = playerDirection->x - planeX + 0.5f * columnStepX;
+	float leftRayY = playerDirection->y - planeY + 0.5f * columnStepY;
+	for (int row = 0; row < floorCaster->numRows; ++row)
+	{
+		float distance = floorCaster->rowDistances[row];
+		floorCaster->rowStartX[row] = (playerPosition->x + distance * leftRayX) * floorCaster->textureScale;
+		floorCaster->rowStartY[row] = (playerPosition->y + distance * leftRayY) * floorCaster->textureScale;
+		floorCaster->rowStepX[row] = distance * columnStepX * floorCaster->textureScale;
+		floorCaster->rowStepY[row] = distance * columnStepY * floorCaster->textureScale;
+	}
+}
+
+/**
+ * Casts the floor rows [rowBegin, rowEnd) and their mirrored ceiling rows into the target frame buffer. Row 0 is the
+ * first row below the horizon. Disjoint row ranges can be cast concurrently, the signature matches WorkerTask.
+ *
+ * @param rowBegin 	  the first floor row
+ * @param rowEnd 	  one past the last floor row
+ * @param floorCaster the floor caster, passed as void* so the function can be used as a WorkerTask
+ */
+void CastFloorAndCeilingRows(int rowBegin, int rowEnd, void* floorCaster)
+{
+	const FloorCaster* caster = (const FloorCaster*)floorCaster;
+	const int width = caster->width;
+	const int horizon = caster->height / 2;
+	const int textureMask = FLOOR_TEXTURE_SIZE - 1;
+	const uint32_t* restrict floorTexture = caster->floorTexture;
+	const uint32_t* restrict ceilingTexture = caster->ceilingTexture;
+	for (int row = rowBegin; row < rowEnd; ++row)
+	{
+		uint32_t* restrict floorRow = caster->target->pixels + (size_t)(horizon + row) * width;
+		uint32_t* restrict ceilingRow = caster->target->pixels + (size_t)(horizon - 1 - row) * width;
+		const float startX = caster->rowStartX[row];
+		const float startY = caster->rowStartY[row];
+		const float stepX = caster->rowStepX[row];
+		const float stepY = caster->rowStepY[row];
+		// The whole row is at the same distance, so it shares one color map
+		const uint8_t* colorMap = caster->shadingTable->colorMap[SHADE_SURFACE_FLAT][caster->rowShadeLevels[row]];
+		// Positions are computed from the column index instead of accumulated, so iterations are independent
+		for (int x = 0; x < width; ++x)
+		{
+			int textureX = (int)floorf(startX + (float)x * stepX) & textureMask;
+			int textureY = (int)floorf(startY + (float)x * stepY) & textureMask;
+			int texel = textureY * FLOOR_TEXTURE_SIZE + textureX;
+			floorRow[x] = ShadePixel(colorMap, floorTexture[texel]);
+			ceilingRow[x] = ShadePixel(colorMap, ceilingTexture[texel]);
+		}
+	}
+}
+
+/**
+ * Casts the rows [rowBegin, rowEnd) of one column of a floor or ceiling texture, one pixel per row. Row 0 is the row
+ * nearest to the horizon.
+ *
+ * @param caster 	the floor caster
+ * @param x 		the frame buffer column
+ * @param rowBegin 	the first floor row
+ * @param rowEnd 	one past the last floor row
+ * @param texture 	the floor or ceiling texture
+ * @param pixel 	the pixel of the first row
+ * @param stride 	the change in pixel address from one row to the next, negative for the ceiling
+ */
+static inline void CastColumnRows(const FloorCaster* caster, int x, int rowBegin, int rowEnd,
+		const uint32_t* restrict texture, uint32_t* restrict pixel, ptrdiff_t stride)
+{
+	const int textureMask = FLOOR_TEXTURE_SIZE - 1;
+	const uint8_t (*colorMaps)[256] = caster->shadingTable->colorMap[SHADE_SURFACE_FLAT];
+	for (int row = rowBegin; row < rowEnd; ++row)
+	{
+		// The same expressions as the row loop, so both give the same texel
+		int textureX = (int)floorf(caster->rowStartX[row] + (float)x * caster->rowStepX[row]) & textureMask;
+		int textureY = (int)floorf(caster->rowStartY[row] + (float)x * caster->rowStepY[row]) & textureMask;
+		*pixel = ShadePixel(colorMaps[caster->rowShadeLevels[row]], texture[textureY * FLOOR_TEXTURE_SIZE + textureX]);
+		pixel += stride;
+	}
+}
+
+/**
+ * Casts the frame buffer rows [yBegin, yEnd) of one column into the target frame buffer, the ceiling above the horizon
+ * and the floor below it. The pixels are the same as the ones CastFloorAndCeilingRows() writes. Walking a column costs
+ * a few table loads per pixel that the row loop hoists out, in exchange only the pixels not covered by walls are
+ * written.
+ *
+ * @param floorCaster the floor caster
+ * @param x 		  the frame buffer column
+ * @param yBegin 	  the first frame buffer row
+ * @param yEnd 		  one past the last frame buffer row
+ */
+void CastFloorAndCeilingColumn(const FloorCaster* floorCaster, int x, int yBegin, int yEnd)
+{
+	const int width = floorCaster->width;
+	const int horizon = floorCaster->height / 2;
+	uint32_t* pixels = floorCaster->target->pixels;
+	// Ceiling rows are mirrored, frame buffer row horizon - 1 is ceiling row 0
+	int ceilingEnd = yEnd < horizon ? yEnd : horizon;
+	if (yBegin < ceilingEnd)
+	{
+		CastColumnRows(floorCaster, x, horizon - ceilingEnd, horizon - yBegin, floorCaster->ceilingTexture,
+				pixels + (size_t)(ceilingEnd - 1) * width + x, -(ptrdiff_t)width);
+	}
+	// With an odd height the last frame buffer row has no floor row, as in the row loop
+	int floorBegin = yBegin > horizon ? yBegin : horizon;
+	int floorEnd = yEnd < horizon + floorCaster->numRows ? yEnd : horizon + floorCaster->numRows;
+	if (floorBegin < floorEnd)
+	{
+		CastColumnRows(floorCaster, x, floorBegin - horizon, floorEnd - horizon, floorCaster->floorTexture,
+				pixels + (size_t)floorBegin * width + x, (ptrdiff_t)width);
+	}
+}
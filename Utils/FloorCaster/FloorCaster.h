@@ -0,0 +1,91 @@
+#ifndef RAY_CASTING_MAZE_FLOORCASTER_H_
+#define RAY_CASTING_MAZE_FLOORCASTER_H_
+
+#define FLOOR_TEXTURE_SIZE 64 // side length of the square floor and ceiling textures, must be a power of two
+#define FLOOR_ROW_BAND_SIZE 16 // number of rows claimed at a time by a worker thread
+
+#include <stdint.h>
+#include "../Vec3/Vec3.h"
+#include "../FrameBuffer/FrameBuffer.h"
+#include "../Shading/Shading.h"
+
+/**
+ * Horizontal-scanline floor and ceiling caster. Every pixel on one screen row below the horizon sees the floor at the
+ * same perpendicular distance, and the mirrored row above the horizon sees the ceiling at that same distance, so the
+ * world position along a row is a linear function of the column. The per-row start position and per-column step are
+ * precomputed once per frame, which leaves a branch-free inner loop over the row that the compiler can vectorize. The
+ * same per-row constants give any single pixel, so the wall renderer can also fill the rows of a column that no wall
+ * covers with CastFloorAndCeilingColumn().
+ */
+typedef struct FloorCaster_struct
+{
+	int width;                 // frame buffer width of the current frame
+	int height;                // frame buffer height
+	int numRows;               // number of floor rows, equal to the number of ceiling rows
+	float textureScale;        // texels per world unit, one texture tile covers one map cell
+	float* rowDistances;       // perpendicular distance seen by each floor row, depends only on the height
+	int* rowShadeLevels;       // shading table distance level of each floor row, depends only on the height
+	float* rowStartX;          // world x coordinate seen by the leftmost column of each floor row
+	float* rowStartY;          // world y coordinate seen by the leftmost column of each floor row
+	float* rowStepX;           // change in world x coordinate per column of each floor row
+	float* rowStepY;           // change in world y coordinate per column of each floor row
+	uint32_t* floorTexture;    // FLOOR_TEXTURE_SIZE * FLOOR_TEXTURE_SIZE ARGB8888 texels
+	uint32_t* ceilingTexture;  // FLOOR_TEXTURE_SIZE * FLOOR_TEXTURE_SIZE ARGB8888 texels
+	const ShadingTable* shadingTable; // lighting and fog lookup tables
+	FrameBuffer* target;       // frame buffer written by CastFloorAndCeilingRows() and CastFloorAndCeilingColumn()
+} FloorCaster;
+
+/**
+ * Creates a floor caster for frame buffers of the given height. The perpendicular distance and the shading level of
+ * each row are computed here, since they only depend on the frame buffer height. The width may change every frame.
+ *
+ * @param height 	   the frame buffer height
+ * @param mapCellSize  the size of each cell in the map grid
+ * @param shadingTable the lighting and fog lookup tables
+ * @return the floor caster
+ */
+FloorCaster* CreateFloorCaster(int height, float mapCellSize, const ShadingTable* shadingTable);
+
+/**
+ * Frees the memory allocated for the given floor caster.
+ *
+ * @param floorCaster the given floor caster
+ */
+void DestroyFloorCaster(FloorCaster* floorCaster);
+
+/**
+ * Precomputes the per-row constants for the current frame from the player position, the player direction and the
+ * camera plane derived from the field of view. The target must have the height the floor caster was created with.
+ *
+ * @param floorCaster 	  the floor caster
+ * @param target 		  the frame buffer to be written
+ * @param playerPosition  the vector representing the player position
+ * @param playerDirection the vector representing the direction that the player is facing, this vector is a unit
+ * 						  vector
+ * @param fieldOfView 	  the angle in radians
+ */
+void PrepareFloorCasterFrame(FloorCaster* floorCaster, FrameBuffer* target, const Vec3* playerPosition,
+		const Vec3* playerDirection, float fieldOfView);
+
+/**
+ * Casts the floor rows [rowBegin, rowEnd) and their mirrored ceiling rows into the target frame buffer. Row 0 is the
+ * first row below the horizon. Disjoint row ranges can be cast concurrently, the signature matches WorkerTask.
+ *
+ * @param rowBegin 	  the first floor row
+ * @param rowEnd 	  one past the last floor row
+ * @param floorCaster the floor caster, passed as void* so the function can be used as a WorkerTask
+ */
+void CastFloorAndCeilingRows(int rowBegin, int rowEnd, void* floorCaster);
+
+/**
+ * Casts the frame buffer rows [yBegin, yEnd) of one column into the target frame buffer, the ceiling above the horizon
+ * and the floor below it. The pixels are the same as the ones CastFloorAndCeilingRows() writes.
+ *
+ * @param floorCaster the floor caster
+ * @param x 		  the frame buffer column
+ * @param yBegin 	  the first frame buffer row
+ * @param yEnd 		  one past the last frame buffer row
+ */
+void CastFloorAndCeilingColumn(const FloorCaster* floorCaster, int x, int yBegin, int yEnd);
+
+#endif
@@ -0,0 +1,61 @@
+#include <stdlib.h>
+#include "FrameBuffer.h"
+#include "../ErrorHandler/ErrorHandler.h"
+
+/**
+ * Creates a frame buffer with all pixels initialized to transparent black.
+ *
+ * @param width  the width of the frame buffer in pixels
+ * @param height the height of the frame buffer in pixels
+ * @return the frame buffer
+ */
+FrameBuffer* CreateFrameBuffer(int width, int height)
+{
+	FrameBuffer* frameBuffer = (FrameBuffer*)calloc(1, sizeof(FrameBuffer));
+	if (frameBuffer == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	frameBuffer->width = width;
+	frameBuffer->height = height;
+	frameBuffer->capacity = width * height;
+	frameBuffer->pixels = (uint32_t*)calloc((size_t)width * (size_t)height, sizeof(uint32_t));
+	if (frameBuffer->pixels == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	return frameBuffer;
+}
+
+/**
+ * Frees the memory allocated for the given frame buffer.
+ *
+ * @param frameBuffer the given frame buffer
+ */
+void DestroyFrameBuffer(FrameBuffer* frameBuffer)
+{
+	if (frameBuffer == NULL)
+	{return;}
+	free(frameBuffer->pixels);
+	free(frameBuffer);
+}
+
+/**
+ * Resizes the given frame buffer. The pixel array is only reallocated when the new size exceeds the capacity, the
+ * content of the frame buffer is undefined after resizing.
+ *
+ * @param frameBuffer the given frame buffer
+ * @param width 	  the new width in pixels
+ * @param height 	  the new height in pixels
+ */
+void ResizeFrameBuffer(FrameBuffer* frameBuffer, int width, int height)
+{
+	if (frameBuffer == NULL)
+	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
+	if (width * height > frameBuffer->capacity)
+	{
+		free(frameBuffer->pixels);
+		frameBuffer->pixels = (uint32_t*)calloc((size_t)width * (size_t)height, sizeof(uint32_t));
+		if (frameBuffer->pixels == NULL)
+		{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+		frameBuffer->capacity = width * height;
+	}
+	frameBuffer->width = width;
+	frameBuffer->height = height;
+}
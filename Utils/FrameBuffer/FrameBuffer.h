@@ -0,0 +1,45 @@
+#ifndef RAY_CASTING_MAZE_FRAMEBUFFER_H_
+#define RAY_CASTING_MAZE_FRAMEBUFFER_H_
+
+#include <stdint.h>
+
+/**
+ * Software frame buffer. Pixels are stored row-major in ARGB8888 format, which matches the streaming texture the
+ * frame buffer is uploaded to. Rows are width pixels apart, so the pixels stay contiguous when the frame buffer is
+ * resized within its capacity.
+ */
+typedef struct FrameBuffer_struct
+{
+	int width;
+	int height;
+	int capacity;     // number of pixels allocated
+	uint32_t* pixels;
+} FrameBuffer;
+
+/**
+ * Creates a frame buffer with all pixels initialized to transparent black.
+ *
+ * @param width  the width of the frame buffer in pixels
+ * @param height the height of the frame buffer in pixels
+ * @return the frame buffer
+ */
+FrameBuffer* CreateFrameBuffer(int width, int height);
+
+/**
+ * Frees the memory allocated for the given frame buffer.
+ *
+ * @param frameBuffer the given frame buffer
+ */
+void DestroyFrameBuffer(FrameBuffer* frameBuffer);
+
+/**
+ * Resizes the given frame buffer. The pixel array is only reallocated when the new size exceeds the capacity, the
+ * content of the frame buffer is undefined after resizing.
+ *
+ * @param frameBuffer the given frame buffer
+ * @param width 	  the new width in pixels
+ * @param height 	  the new height in pixels
+ */
+void ResizeFrameBuffer(FrameBuffer* frameBuffer, int width, int height);
+
+#endif
@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "ImageWriter.h"
+#include "../ErrorHandler/ErrorHandler.h"
+#include "../Assert/Assert.h"
+
+/**
+ * Converts one row of ARGB8888 pixels into packed 8-bit samples.
+ *
+ * @param pixels the row of pixels
+ * @param width  the number of pixels in the row
+ * @param isBGR  1 to write the samples in blue, green, red order as BMP does, 0 for red, green, blue
+ * @param row 	 the 3 * width samples to be written
+ */
+static void PackRow(const uint32_t* pixels, int width, int isBGR, unsigned char* row)
+{
+	for (int x = 0; x < width; ++x)
+	{
+		unsigned char r = (unsigned char)(pixels[x] >> 16);
+		unsigned char g = (unsigned char)(pixels[x] >> 8);
+		unsigned char b = (unsigned char)pixels[x];
+		row[3 * x] = isBGR ? b : r;
+		row[3 * x + 1] = g;
+		row[3 * x + 2] = isBGR ? r : b;
+	}
+}
+
+/**
+ * Stores a 32-bit value in little-endian byte order.
+ *
+ * @param value the value
+ * @param bytes the 4 bytes to be written
+ */
+static void PutLittleEndian32(uint32_t value, unsigned char* bytes)
+{
+	bytes[0] = (unsigned char)value;
+	bytes[1] = (unsigned char)(value >> 8);
+	bytes[2] = (unsigned char)(value >> 16);
+	bytes[3] = (unsigned char)(value >> 24);
+}
+
+/**
+ * Writes the frame buffer as a binary PPM (P6) image with 8-bit RGB samples. The alpha channel is dropped.
+ *
+ * @param frameBuffer the frame buffer
+ * @param path 		  the path of the image file, overwritten if it exists
+ * @return 1 if the image was written, 0 if the file could not be written
+ */
+int WriteFrameBufferPPM(const FrameBuffer* frameBuffer, const char* path)
+{
+	RCM_ASSERT_NOT_NULL(frameBuffer);
+	RCM_ASSERT_NOT_NULL(path);
+	FILE* file = fopen(path, "wb");
+	if (file == NULL)
+	{return 0;}
+	unsigned char* row = (unsigned char*)malloc((size_t)frameBuffer->width * 3);
+	if (row == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	int isWritten = fprintf(file, "P6\n%d %d\n255\n", frameBuffer->width, frameBuffer->height) > 0;
+	for (int y = 0; y < frameBuffer->height && isWritten; ++y)
+	{
+		PackRow(frameBuffer->pixels + (size_t)y * frameBuffer->width, frameBuffer->width, 0, row);
+		isWritten = fwrite(row, 3, (size_t)frameBuffer->width, file) == (size_t)frameBuffer->width;
+	}
+	free(row);
+	return fclose(file) == 0 && isWritten;
+}
+
+/**
+ * Writes the frame buffer as an uncompressed 24-bit BMP image. The alpha channel is dropped.
+ *
+ * @param frameBuffer the frame buffer
+ * @param path 		  the path of the image file, overwritten if it exists
+ * @return 1 if the image was written, 0 if the file could not be written
+ */
+int WriteFrameBufferBMP(const FrameBuffer* frameBuffer, const char* path)
+{
+	RCM_ASSERT_NOT_NULL(frameBuffer);
+	RCM_ASSERT_NOT_NULL(path);
+	FILE* file = fopen(path, "wb");
+	if (file == NULL)
+	{return 0;}
+	// Rows are padded to a multiple of 4 bytes
+	size_t rowSize = ((size_t)frameBuffer->width * 3 + 3) & ~(size_t)3;
+	unsigned char* row = (unsigned char*)calloc(rowSize, 1);
+	if (row == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	// File header (14 bytes) followed by the BITMAPINFOHEADER (40 bytes), all fields little-endian
+	unsigned char header[54] = {'B', 'M'};
+	PutLittleEndian32((uint32_t)(54 + rowSize * (size_t)frameBuffer->height), header + 2);
+	PutLittleEndian32(54, header + 10);
+	PutLittleEndian32(40, header + 14);
+	PutLittleEndian32((uint32_t)frameBuffer->width, header + 18);
+	PutLittleEndian32((uint32_t)frameBuffer->height, header + 22);
+	header[26] = 1;  // color planes
+	header[28] = 24; // bits per pixel
+	PutLittleEndian32((uint32_t)(rowSize * (size_t)frameBuffer->height), header + 34);
+	int isWritten = fwrite(header, sizeof(header), 1, file) == 1;
+	// A positive height stores the rows bottom-up
+	for (int y = frameBuffer->height - 1; y >= 0 && isWritten; --y)
+	{
+		PackRow(frameBuffer->pixels + (size_t)y * frameBuffer->width, frameBuffer->width, 1, row);
+		isWritten = fwrite(row, rowSize, 1, file) == 1;
+	}
+	free(row);
+	return fclose(file) == 0 && isWritten;
+}
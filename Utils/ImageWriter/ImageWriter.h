@@ -0,0 +1,24 @@
+#ifndef RAY_CASTING_MAZE_IMAGEWRITER_H_
+#define RAY_CASTING_MAZE_IMAGEWRITER_H_
+
+#include "../FrameBuffer/FrameBuffer.h"
+
+/**
+ * Writes the frame buffer as a binary PPM (P6) image with 8-bit RGB samples. The alpha channel is dropped.
+ *
+ * @param frameBuffer the frame buffer
+ * @param path 		  the path of the image file, overwritten if it exists
+ * @return 1 if the image was written, 0 if the file could not be written
+ */
+int WriteFrameBufferPPM(const FrameBuffer* frameBuffer, const char* path);
+
+/**
+ * Writes the frame buffer as an uncompressed 24-bit BMP image. The alpha channel is dropped.
+ *
+ * @param frameBuffer the frame buffer
+ * @param path 		  the path of the image file, overwritten if it exists
+ * @return 1 if the image was written, 0 if the file could not be written
+ */
+int WriteFrameBufferBMP(const FrameBuffer* frameBuffer, const char* path);
+
+#endif
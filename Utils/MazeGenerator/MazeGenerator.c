@@ -1,4 +1,5 @@
 #include <stdlib.h>
+#include <stdint.h>
 #include "MazeGenerator.h"
 #include "../ErrorHandler/ErrorHandler.h"
 
@@ -39,9 +40,10 @@ int hasValidNeighbors(const int neighborIndex[])
  * @param neighborIndex the neighbor index array
  * @param maze 			the maze array
  * @param mazeSize 		the size of the maze array
+ * @param random 		the generator choosing the neighbor
  * @return the index of the chosen neighbor, -1 if no valid neighbor exists
  */
-int GetRandomNeighborIndex(int currentIndex, int neighborIndex[], const int maze[], int mazeSize)
+int GetRandomNeighborIndex(int currentIndex, int neighborIndex[], const int maze[], int mazeSize, Random* random)
 {
 	if (neighborIndex == NULL || maze == NULL)
 	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
@@ -68,7 +70,7 @@ int GetRandomNeighborIndex(int currentIndex, int neighborIndex[], const int maze
 	// If valid neighbor exists, picks one valid neighbor
 	while (1)
 	{
-		randomIndex = arc4random_uniform(TOTAL_NUM_NEIGHBORS);
+		randomIndex = NextRandomBelow(random, TOTAL_NUM_NEIGHBORS);
 		if (!(neighborIndex[randomIndex] != -1 && maze[neighborIndex[randomIndex]] != VISITED))
 		{continue;}
 		else
@@ -82,8 +84,9 @@ int GetRandomNeighborIndex(int currentIndex, int neighborIndex[], const int maze
  *
  * @param maze 	   the maze array
  * @param mazeSize the size of the maze array
+ * @param random   the generator choosing the neighbors, the same sequence always gives the same maze
  */
-void GenerateMaze(int maze[], int mazeSize)
+void GenerateMaze(int maze[], int mazeSize, Random* random)
 {
 	if (maze == NULL)
 	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
@@ -99,7 +102,7 @@ void GenerateMaze(int maze[], int mazeSize)
 		int neighborIndex[TOTAL_NUM_NEIGHBORS];
 		for (int i = 0; i < TOTAL_NUM_NEIGHBORS; ++i)
 		{neighborIndex[i] = -1;}
-		int nextMove = GetRandomNeighborIndex(currentIndex, neighborIndex, maze, mazeSize);
+		int nextMove = GetRandomNeighborIndex(currentIndex, neighborIndex, maze, mazeSize, random);
 		// If no valid neighbor was found, backtrack
 		if (nextMove == -1)
 		{Pop(stack);}
@@ -128,15 +131,18 @@ void GenerateMaze(int maze[], int mazeSize)
  * Creates maze map array.
  *
  * @param mazeSize size of the maze map array
+ * @param seed 	   the seed of the maze, the same seed and size always give the same maze
  * @return the maze map array
  */
-int* CreateMazeMap(int mazeSize)
+int* CreateMazeMap(int mazeSize, uint32_t seed)
 {
 	int* maze = (int*)calloc(mazeSize * mazeSize, sizeof(int));
 	if (maze == NULL)
 	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
 	for (int i = 0; i < mazeSize * mazeSize; ++i)
 	{maze[i] = UNVISITED;}
-	GenerateMaze(maze, mazeSize);
+	Random random;
+	SeedRandom(&random, seed);
+	GenerateMaze(maze, mazeSize, &random);
 	return maze;
 }
\ No newline at end of file
@@ -4,21 +4,25 @@
 #define VISITED 0 	// used to mark a cell as visited
 #define UNVISITED 1 // used to mark a cell as unvisited
 
+#include <stdint.h>
 #include "../Stack/Stack.h"
+#include "../Random/Random.h"
 
 /**
  * Traverses the maze array and generates maze. In-place modification is made to the maze array.
  *
  * @param maze 	   the maze array
  * @param mazeSize the size of the maze array
+ * @param random   the generator choosing the neighbors, the same sequence always gives the same maze
  */
- void GenerateMaze(int maze[], int mazeSize);
+ void GenerateMaze(int maze[], int mazeSize, Random* random);
 
 /**
  * Creates maze map array.
  *
  * @param mazeSize size of the maze map array
+ * @param seed 	   the seed of the maze, the same seed and size always give the same maze
  * @return the maze map array
  */
- int* CreateMazeMap(int mazeSize);
+ int* CreateMazeMap(int mazeSize, uint32_t seed);
 #endif
@@ -0,0 +1,140 @@
+#include <stdlib.h>
+#include "MazeSolver.h"
+#include "../ErrorHandler/ErrorHandler.h"
+#include "../Assert/Assert.h"
+
+/**
+ * Creates a solver for mazes of the given size.
+ *
+ * @param mazeSize the side length of the square maze grid
+ * @return the solver
+ */
+MazeSolver* CreateMazeSolver(int mazeSize)
+{
+	RCM_ASSERT(mazeSize > 0, INVALID_CONFIGURATION_ERROR);
+	MazeSolver* solver = (MazeSolver*)calloc(1, sizeof(MazeSolver));
+	if (solver == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	int numCells = mazeSize * mazeSize;
+	solver->mazeSize = mazeSize;
+	solver->queue = (int*)calloc(numCells, sizeof(int));
+	solver->parent = (int*)calloc(numCells, sizeof(int));
+	solver->visitedMark = (unsigned*)calloc(numCells, sizeof(unsigned));
+	solver->path = (int*)calloc(numCells, sizeof(int));
+	if (solver->queue == NULL || solver->parent == NULL || solver->visitedMark == NULL || solver->path == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	return solver;
+}
+
+/**
+ * Frees the memory allocated for the given solver.
+ *
+ * @param solver the given solver
+ */
+void DestroyMazeSolver(MazeSolver* solver)
+{
+	if (solver == NULL)
+	{return;}
+	free(solver->queue);
+	free(solver->parent);
+	free(solver->visitedMark);
+	free(solver->path);
+	free(solver);
+}
+
+/**
+ * Finds a shortest path between two open cells of a maze. The path is stored in the solver, start and goal included.
+ *
+ * @param solver 	the solver
+ * @param maze 		1D array representing the maze, each element in the array represents a cell in the maze grid
+ * @param wallValue the value of wall cells in the maze array
+ * @param start 	the index of the start cell
+ * @param goal 		the index of the goal cell
+ * @return the number of cells in the path, MAZE_SOLVER_NO_PATH if the goal can not be reached
+ */
+int SolveMaze(MazeSolver* solver, const int maze[], int wallValue, int start, int goal)
+{
+	RCM_ASSERT_NOT_NULL(solver);
+	RCM_ASSERT_NOT_NULL(maze);
+	const int mazeSize = solver->mazeSize;
+	RCM_ASSERT(start >= 0 && start < mazeSize * mazeSize && goal >= 0 && goal < mazeSize * mazeSize, UNKNOWN_ERROR);
+	solver->pathLength = 0;
+	if (maze[start] == wallValue || maze[goal] == wallValue)
+	{return MAZE_SOLVER_NO_PATH;}
+	// Starts a new search, the marks are cleared only when the search number wraps around
+	if (++solver->searchNumber == 0)
+	{
+		for (int i = 0; i < mazeSize * mazeSize; ++i)
+		{solver->visitedMark[i] = 0;}
+		solver->searchNumber = 1;
+	}
+	const unsigned mark = solver->searchNumber;
+	const int offsets[4] = {-mazeSize, mazeSize, -1, 1}; // up, down, left, right
+	int head = 0;
+	int tail = 0;
+	solver->queue[tail++] = start;
+	solver->visitedMark[start] = mark;
+	solver->parent[start] = start;
+	while (head < tail && solver->visitedMark[goal] != mark)
+	{
+		int cell = solver->queue[head++];
+		for (int i = 0; i < 4; ++i)
+		{
+			// The maze border is made of walls, so neighbors of open cells never leave the grid
+			int neighbor = cell + offsets[i];
+			if (maze[neighbor] == wallValue || solver->visitedMark[neighbor] == mark)
+			{continue;}
+			solver->visitedMark[neighbor] = mark;
+			solver->parent[neighbor] = cell;
+			solver->queue[tail++] = neighbor;
+		}
+	}
+	if (solver->visitedMark[goal] != mark)
+	{return MAZE_SOLVER_NO_PATH;}
+	// Follows the parent links back from the goal, then reverses the path
+	for (int cell = goal; cell != start; cell = solver->parent[cell])
+	{solver->path[solver->pathLength++] = cell;}
+	solver->path[solver->pathLength++] = start;
+	for (int i = 0, j = solver->pathLength - 1; i < j; ++i, --j)
+	{
+		int cell = solver->path[i];
+		solver->path[i] = solver->path[j];
+		solver->path[j] = cell;
+	}
+	return solver->pathLength;
+}
+
+/**
+ * Follows a field of distances to the goal from the start cell to the goal, stepping each time to the neighbor one
+ * step closer, and stores the path in the solver, start and goal included. No search is needed, so it takes constant
+ * time per cell of the path.
+ *
+ * @param solver 	the solver
+ * @param distances the number of steps from each cell to the goal, negative for walls and unreachable cells, as
+ * 					calculated by CalculateGoalDistances()
+ * @param start 	the index of the start cell
+ * @return the number of cells in the path, MAZE_SOLVER_NO_PATH if the goal can not be reached from the start
+ */
+int FollowDistanceField(MazeSolver* solver, const int distances[], int start)
+{
+	RCM_ASSERT_NOT_NULL(solver);
+	RCM_ASSERT_NOT_NULL(distances);
+	const int mazeSize = solver->mazeSize;
+	RCM_ASSERT(start >= 0 && start < mazeSize * mazeSize, UNKNOWN_ERROR);
+	solver->pathLength = 0;
+	if (distances[start] < 0)
+	{return MAZE_SOLVER_NO_PATH;}
+	const int offsets[4] = {-mazeSize, mazeSize, -1, 1}; // up, down, left, right
+	int cell = start;
+	solver->path[solver->pathLength++] = cell;
+	while (distances[cell] > 0)
+	{
+		// The maze border is made of walls, so neighbors of open cells never leave the grid
+		int i = 0;
+		while (distances[cell + offsets[i]] != distances[cell] - 1)
+		{++i;}
+		cell += offsets[i];
+		solver->path[solver->pathLength++] = cell;
+	}
+	return solver->pathLength;
+}
@@ -0,0 +1,64 @@
+#ifndef RAY_CASTING_MAZE_MAZESOLVER_H_
+#define RAY_CASTING_MAZE_MAZESOLVER_H_
+
+#define MAZE_SOLVER_NO_PATH (-1) // returned by SolveMaze() when the goal can not be reached
+
+/**
+ * Breadth-first search over the cells of a maze. All moves between neighboring open cells cost the same, so the first
+ * path found is a shortest one. The queue, the parent links and the visited marks are allocated once for the maze
+ * size and reused by every search. Cells are marked with the number of the search instead of a flag, so the marks do
+ * not have to be cleared between searches.
+ */
+typedef struct MazeSolver_struct
+{
+	int mazeSize;           // side length of the mazes that can be solved
+	int* queue;             // cells waiting to be expanded, mazeSize * mazeSize entries
+	int* parent;            // cell each cell was reached from
+	unsigned* visitedMark;  // search number of the last search that reached each cell
+	unsigned searchNumber;  // number of the current search
+	int* path;              // cells of the last path found, from the start to the goal
+	int pathLength;         // number of cells in the last path found
+} MazeSolver;
+
+/**
+ * Creates a solver for mazes of the given size.
+ *
+ * @param mazeSize the side length of the square maze grid
+ * @return the solver
+ */
+MazeSolver* CreateMazeSolver(int mazeSize);
+
+/**
+ * Frees the memory allocated for the given solver.
+ *
+ * @param solver the given solver
+ */
+void DestroyMazeSolver(MazeSolver* solver);
+
+/**
+ * Finds a shortest path between two open cells of a maze. The path is stored in the solver, start and goal included.
+ *
+ * @param solver 	the solver
+ * @param maze 		1D array representing the maze, each element in the array represents a cell in the maze grid
+ * @param wallValue the value of wall cells in the maze array
+ * @param start 	the index of the start cell
+ * @param goal 		the index of the goal cell
+ * @return the number of cells in the path, MAZE_SOLVER_NO_PATH if the goal can not be reached
+ */
+int SolveMaze(MazeSolver* solver, const int maze[], int wallValue, int start, int goal);
+
+
+/**
+ * Follows a field of distances to the goal from the start cell to the goal, stepping each time to the neighbor one
+ * step closer, and stores the path in the solver, start and goal included. No search is needed, so it takes constant
+ * time per cell of the path.
+ *
+ * @param solver 	the solver
+ * @param distances the number of steps from each cell to the goal, negative for walls and unreachable cells, as
+ * 					calculated by CalculateGoalDistances()
+ * @param start 	the index of the start cell
+ * @return the number of cells in the path, MAZE_SOLVER_NO_PATH if the goal can not be reached from the start
+ */
+int FollowDistanceField(MazeSolver* solver, const int distances[], int start);
+
+#endif
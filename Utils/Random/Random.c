@@ -0,0 +1,58 @@
+#include "Random.h"
+#include "../ErrorHandler/ErrorHandler.h"
+#include "../Assert/Assert.h"
+
+#define PCG32_MULTIPLIER 6364136223846793005ULL
+#define PCG32_INCREMENT 1442695040888963407ULL
+
+/**
+ * Initializes a generator from a seed.
+ *
+ * @param random the generator
+ * @param seed 	 the seed
+ */
+void SeedRandom(Random* random, uint32_t seed)
+{
+	RCM_ASSERT_NOT_NULL(random);
+	random->state = 0;
+	NextRandom(random);
+	random->state += seed;
+	NextRandom(random);
+}
+
+/**
+ * Gets the next uniformly distributed 32-bit value.
+ *
+ * @param random the generator
+ * @return the value
+ */
+uint32_t NextRandom(Random* random)
+{
+	RCM_ASSERT_NOT_NULL(random);
+	uint64_t state = random->state;
+	random->state = state * PCG32_MULTIPLIER + PCG32_INCREMENT;
+	// Output permutation: xorshift of the high bits followed by a random rotation
+	uint32_t xorShifted = (uint32_t)(((state >> 18u) ^ state) >> 27u);
+	uint32_t rotation = (uint32_t)(state >> 59u);
+	return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+}
+
+/**
+ * Gets the next uniformly distributed value in [0, bound). Values that would bias the result are rejected.
+ *
+ * @param random the generator
+ * @param bound  one past the largest value, must be positive
+ * @return the value
+ */
+uint32_t NextRandomBelow(Random* random, uint32_t bound)
+{
+	RCM_ASSERT(bound > 0, UNKNOWN_ERROR);
+	// 2^32 mod bound values at the bottom of the range would be drawn more often than the others
+	uint32_t threshold = (0u - bound) % bound;
+	while (1)
+	{
+		uint32_t value = NextRandom(random);
+		if (value >= threshold)
+		{return value % bound;}
+	}
+}
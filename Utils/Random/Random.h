@@ -0,0 +1,40 @@
+#ifndef RAY_CASTING_MAZE_RANDOM_H_
+#define RAY_CASTING_MAZE_RANDOM_H_
+
+#include <stdint.h>
+
+/**
+ * Seeded pseudo-random number generator (PCG32). The same seed always gives the same sequence on every platform, so a
+ * maze can be regenerated from its seed.
+ */
+typedef struct Random_struct
+{
+	uint64_t state;
+} Random;
+
+/**
+ * Initializes a generator from a seed.
+ *
+ * @param random the generator
+ * @param seed 	 the seed
+ */
+void SeedRandom(Random* random, uint32_t seed);
+
+/**
+ * Gets the next uniformly distributed 32-bit value.
+ *
+ * @param random the generator
+ * @return the value
+ */
+uint32_t NextRandom(Random* random);
+
+/**
+ * Gets the next uniformly distributed value in [0, bound). Values that would bias the result are rejected.
+ *
+ * @param random the generator
+ * @param bound  one past the largest value, must be positive
+ * @return the value
+ */
+uint32_t NextRandomBelow(Random* random, uint32_t bound);
+
+#endif
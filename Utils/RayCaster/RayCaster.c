@@ -2,85 +2,71 @@
 #include <math.h>
 #include "RayCaster.h"
 #include "../ErrorHandler/ErrorHandler.h"
+#include "../Assert/Assert.h"
 #include "../Comparator/Comparator.h"
 
 /**
  * Calculates the first horizontal intersection between the ray cast by player and the wall of the cell in which
- * the player is located. 3D vectors are used for the calculation, assuming that the z component is 0.0f.
+ * the player is located.
  *
  * @param playerPosition	the vector representing the player position
  * @param rayCastedByPlayer the ray cast by player
  * @param mapCellSize 		the size of each cell in the map grid
  * @return the vector representing the first horizontal intersection between the ray cast by player and a map cell
  */
-Vec3* CalculateFirstHorizontalIntersection(const Vec3* playerPosition, const Vec3* rayCastedByPlayer, float mapCellSize)
+Vec2 CalculateFirstHorizontalIntersection(Vec2 playerPosition, Vec2 rayCastedByPlayer, float mapCellSize)
 {
-	if (playerPosition == NULL || rayCastedByPlayer == NULL)
-	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
-	Vec3* firstHorizontalIntersection = Vec3D(playerPosition->x, playerPosition->y, ZERO);
-	if (!(CompareFloats(rayCastedByPlayer->x, ZERO) == 0))
+	Vec2 firstHorizontalIntersection = playerPosition;
+	if (!(CompareFloats(rayCastedByPlayer.x, ZERO) == 0))
 	{
-		float slope = rayCastedByPlayer->y / rayCastedByPlayer->x;
-		float dx;
+		float slope = rayCastedByPlayer.y / rayCastedByPlayer.x;
 		float dy = ZERO;
-		if (rayCastedByPlayer->y < 0)  // facing up
+		if (rayCastedByPlayer.y < 0)  // facing up
 		{
 			// Subtracts COORDINATE_OFFSET to correct hit detection result when facing up
-			dy = floorf(playerPosition->y / mapCellSize) * mapCellSize - playerPosition->y - COORDINATE_OFFSET;
+			dy = floorf(playerPosition.y / mapCellSize) * mapCellSize - playerPosition.y - COORDINATE_OFFSET;
 		}
-		else if (rayCastedByPlayer->y > 0)  // facing down
+		else if (rayCastedByPlayer.y > 0)  // facing down
 		{
-			dy = ceilf(playerPosition->y / mapCellSize) * mapCellSize - playerPosition->y;
+			dy = ceilf(playerPosition.y / mapCellSize) * mapCellSize - playerPosition.y;
 		}
-		dx = dy / slope;
-		// Initialize translationVector with z component equal to 0.0f
-		Vec3* translationVector = Vec3D(dx, dy, ZERO);
-		Translate3D(firstHorizontalIntersection, translationVector);
-		free(translationVector);
+		firstHorizontalIntersection = V2Add(firstHorizontalIntersection, V2(dy / slope, dy));
 	}
 	return firstHorizontalIntersection;
 }
 
 /**
  * Calculates the first vertical intersection between the ray cast by player and the wall of the cell in which
- * the player is located. 3D vectors are used for the calculation, assuming that the z component is 0.0f.
+ * the player is located.
  *
  * @param playerPosition 	the vector representing the player position
  * @param rayCastedByPlayer the ray cast by player
  * @param mapCellSize 		the size of each cell in the map grid
  * @return the vector representing the first vertical intersection between the ray cast by player and a map cell
  */
-Vec3* CalculateFirstVerticalIntersection(const Vec3* playerPosition, const Vec3* rayCastedByPlayer, float mapCellSize)
+Vec2 CalculateFirstVerticalIntersection(Vec2 playerPosition, Vec2 rayCastedByPlayer, float mapCellSize)
 {
-	if (playerPosition == NULL || rayCastedByPlayer == NULL)
-	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
-	Vec3* firstVerticalIntersection = Vec3D(playerPosition->x, playerPosition->y, ZERO);
-	if (!(CompareFloats(rayCastedByPlayer->x, ZERO) == 0))
+	Vec2 firstVerticalIntersection = playerPosition;
+	if (!(CompareFloats(rayCastedByPlayer.x, ZERO) == 0))
 	{
-		float slope = rayCastedByPlayer->y / rayCastedByPlayer->x;
+		float slope = rayCastedByPlayer.y / rayCastedByPlayer.x;
 		float dx = 0.0f;
-		float dy;
-		if (rayCastedByPlayer->x < 0)  // facing left
+		if (rayCastedByPlayer.x < 0)  // facing left
 		{
 			// Subtracts COORDINATE_OFFSET to correct hit detection result when facing left
-			dx = floorf(playerPosition->x / mapCellSize) * mapCellSize - playerPosition->x - COORDINATE_OFFSET;
+			dx = floorf(playerPosition.x / mapCellSize) * mapCellSize - playerPosition.x - COORDINATE_OFFSET;
 		}
-		else if (rayCastedByPlayer->x > 0)  // facing right
+		else if (rayCastedByPlayer.x > 0)  // facing right
 		{
-			dx = ceilf(playerPosition->x / mapCellSize) * mapCellSize - playerPosition->x;
+			dx = ceilf(playerPosition.x / mapCellSize) * mapCellSize - playerPosition.x;
 		}
-		dy = dx * slope;
-		// Initialize translationVector with z component equal to 0.0f
-		Vec3* translationVector = Vec3D(dx, dy, ZERO);
-		Translate3D(firstVerticalIntersection, translationVector);
-		free(translationVector);
+		firstVerticalIntersection = V2Add(firstVerticalIntersection, V2(dx, dx * slope));
 	}
 	return firstVerticalIntersection;
 }
 
 /**
  * Checks if the ray cast by player intersects with a cell that is a wall (represented using 1 in the map array).
- * 3D vectors are used for the calculation, assuming that the z component is 0.0f.
  *
  * @param intersection the current intersection between the ray cast by player and a cell
  * @param mapCellSize  the size of each cell in the map grid
@@ -88,12 +74,10 @@ Vec3* CalculateFirstVerticalIntersection(const Vec3* playerPosition, const Vec3*
  * @param mapSize 	   the side length of the square map grid (mapSize * mapSize == map.size())
  * @return 1 if the ray cast player intersects will a wall, 0 otherwise
  */
-int HasHit(const Vec3* intersection, float mapCellSize, const int map[], int mapSize)
+int HasHit(Vec2 intersection, float mapCellSize, const int map[], int mapSize)
 {
-	if (intersection == NULL || map == NULL)
-	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
-	int xIndex = (int)((intersection->x) / mapCellSize);
-	int yIndex = (int)((intersection->y) / mapCellSize);
+	int xIndex = (int)(intersection.x / mapCellSize);
+	int yIndex = (int)(intersection.y / mapCellSize);
 
 	if (xIndex >= 0 && xIndex < mapSize && yIndex >= 0 && yIndex < mapSize)
 	{
@@ -104,142 +88,706 @@ int HasHit(const Vec3* intersection, float mapCellSize, const int map[], int map
 }
 
 /**
- * Calculates the first horizontal intersection between the ray cast by player and a cell that represents a wall.
- * 3D vectors are used for the calculation, assuming that the z component is 0.0f.
+ * Calculates the number of grid lines a ray crosses before its length exceeds the maximum ray length, capped at
+ * MAX_DDA_ITERATION. Each step of the traversal moves by one cell along one axis, which is mapCellSize / |component|
+ * along the ray for a unit ray.
+ *
+ * @param rayComponent the component of the unit ray along the stepping axis
+ * @param mapCellSize  the size of each cell in the map grid
+ * @param maxRayLength the length after which the traversal stops
+ * @return the maximum number of traversal steps
+ */
+int GetMaxIteration(float rayComponent, float mapCellSize, float maxRayLength)
+{
+	// One extra step guarantees the last intersection lies beyond maxRayLength
+	float steps = maxRayLength * fabsf(rayComponent) / mapCellSize + 1.0f;
+	return steps < (float)MAX_DDA_ITERATION ? (int)steps : MAX_DDA_ITERATION;
+}
+
+/**
+ * Calculates how many steps a traversal can take at once from the distance between the cell of the current
+ * intersection and the nearest wall. A step moves one cell along the stepping axis and cellsPerStep cells along the
+ * other axis, so the k-th next intersection is at most max(k, k * cellsPerStep + 1) cells away. Every intersection
+ * closer than the wall distance is in an open cell, the step after the last of them has to be checked.
+ *
+ * @param wallDistance the Chebyshev distance between the cell of the current intersection and the nearest wall
+ * @param stepsPerCell the number of steps per cell moved along the other axis, INFINITY if the ray is parallel to the
+ * 					   stepping axis
+ * @return the number of steps to take
+ */
+static inline int GetTraversalSteps(int wallDistance, float stepsPerCell)
+{
+	// Cells touching a wall, which are all open cells of a maze with one cell wide corridors, allow no skipping
+	if (wallDistance < 2)
+	{return 1;}
+	float skippableSteps = (float)(wallDistance - 2) * stepsPerCell;
+	return skippableSteps < (float)(wallDistance - 1) ? (int)skippableSteps + 1 : wallDistance;
+}
+
+/**
+ * Checks if a ray crossing the middle plane of a door cell hits the door panel there. The panel stands in that plane
+ * and slides towards the top or the left side of the cell, the part of the plane between that side and the opening is
+ * open. Only panels in the planes crossed by the traversal are tested, the cells on both ends of a panel are walls, so
+ * a ray reaching the panel always enters the door cell across a grid line parallel to it.
+ *
+ * @param panelPoint    the point where the ray crosses the middle plane of the cell
+ * @param value 		the value of the door cell
+ * @param xIndex 		the column of the door cell
+ * @param yIndex 		the row of the door cell
+ * @param mapCellSize   the size of each cell in the map grid
+ * @param verticalPanel DOOR_VERTICAL for the traversal of the vertical intersections, 0 for the horizontal one
+ * @return 1 if the ray hits the closed part of the panel, 0 otherwise
+ */
+static inline int HitsDoorPanel(Vec2 panelPoint, int value, int xIndex, int yIndex, float mapCellSize,
+		int verticalPanel)
+{
+	// The ray may leave the cell across another grid line before it reaches the middle plane
+	if ((value & DOOR_VERTICAL) != verticalPanel || (int)(panelPoint.x / mapCellSize) != xIndex ||
+			(int)(panelPoint.y / mapCellSize) != yIndex)
+	{return 0;}
+	float alongPanel = verticalPanel ? panelPoint.y / mapCellSize - (float)yIndex :
+			panelPoint.x / mapCellSize - (float)xIndex;
+	return alongPanel * (float)DOOR_OPENING_MAX >= (float)GetDoorOpening(value);
+}
+
+/**
+ * Checks if a ray cast from inside a door cell hits the panel of the door in front of the player, before the first
+ * intersection of the traversal.
  *
  * @param playerPosition 	the vector representing the player position
  * @param rayCastedByPlayer the vector representing the ray cast by player
  * @param mapCellSize 		the size of each cell in the map grid
  * @param map 				1D array representing the map, each element in the array represents a cell in the map grid
  * @param mapSize 			the side length of the square map grid (mapSize * mapSize == map.size())
- * @return the vector representing the first horizontal intersection between the ray cast player and a map cell
- * that represents a wall
+ * @param verticalPanel 	DOOR_VERTICAL for the traversal of the vertical intersections, 0 for the horizontal one
+ * @param hit 				receives the point where the ray hits the panel
+ * @return 1 if the ray hits the panel, 0 otherwise
  */
-Vec3* CalculateFinalHorizontalIntersection(const Vec3* playerPosition, const Vec3* rayCastedByPlayer, float mapCellSize,
-		const int map[], int mapSize)
+static int HitsPlayerCellDoor(Vec2 playerPosition, Vec2 rayCastedByPlayer, float mapCellSize, const int map[],
+		int mapSize, int verticalPanel, Vec2* hit)
+{
+	int xIndex = (int)(playerPosition.x / mapCellSize);
+	int yIndex = (int)(playerPosition.y / mapCellSize);
+	if (xIndex < 0 || xIndex >= mapSize || yIndex < 0 || yIndex >= mapSize || !IsDoor(map[yIndex * mapSize + xIndex]))
+	{return 0;}
+	float component = verticalPanel ? rayCastedByPlayer.x : rayCastedByPlayer.y;
+	float position = verticalPanel ? playerPosition.x : playerPosition.y;
+	float middle = ((float)(verticalPanel ? xIndex : yIndex) + 0.5f) * mapCellSize;
+	// Only a panel ahead of the player can be hit
+	if (component == 0.0f || (middle - position) / component <= 0.0f)
+	{return 0;}
+	*hit = V2Add(playerPosition, V2Scale(rayCastedByPlayer, (middle - position) / component));
+	return HitsDoorPanel(*hit, map[yIndex * mapSize + xIndex], xIndex, yIndex, mapCellSize, verticalPanel);
+}
+
+/**
+ * Struct for the cells one traversal of a ray passed through, recorded while the traversal steps.
+ */
+typedef struct TraversalCells_struct
+{
+	int cells[MAX_DDA_ITERATION + 1];       // cell of each intersection inside the map, in traversal order
+	float distances[MAX_DDA_ITERATION + 1]; // distance along the ray from the player to each of these intersections
+	int numCells;                           // number of cells recorded
+} TraversalCells;
+
+/**
+ * Records the cell of an intersection of a traversal, if the intersection is inside the map.
+ *
+ * @param crossed 			the cells of the traversal
+ * @param playerPosition 	the vector representing the player position
+ * @param rayCastedByPlayer the vector representing the ray cast by player, this vector is a unit vector
+ * @param intersection 		the intersection
+ * @param mapCellSize 		the size of each cell in the map grid
+ * @param mapSize 			the side length of the square map grid (mapSize * mapSize == map.size())
+ */
+static inline void RecordTraversalCell(TraversalCells* crossed, Vec2 playerPosition, Vec2 rayCastedByPlayer,
+		Vec2 intersection, float mapCellSize, int mapSize)
+{
+	int xIndex = (int)(intersection.x / mapCellSize);
+	int yIndex = (int)(intersection.y / mapCellSize);
+	if (xIndex >= 0 && xIndex < mapSize && yIndex >= 0 && yIndex < mapSize)
+	{
+		crossed->cells[crossed->numCells] = yIndex * mapSize + xIndex;
+		crossed->distances[crossed->numCells] = V2Dot(V2Sub(intersection, playerPosition), rayCastedByPlayer);
+		++crossed->numCells;
+	}
+}
+
+/**
+ * Translates an intersection along a ray until it is in a cell that represents a wall, the ray hits a door panel or the
+ * maximum number of steps was taken. This is the traversal shared by the horizontal and the vertical intersections. A
+ * door panel stands half a step into its cell, where the ray is hit.
+ *
+ * @param intersection 		the first intersection
+ * @param translationVector the vector between two consecutive intersections
+ * @param maxIteration 		the maximum number of steps
+ * @param playerPosition 	the vector representing the player position
+ * @param rayCastedByPlayer the vector representing the ray cast by player, this vector is a unit vector
+ * @param mapCellSize 		the size of each cell in the map grid
+ * @param map 				1D array representing the map, each element in the array represents a cell in the map grid
+ * @param mapSize 			the side length of the square map grid (mapSize * mapSize == map.size())
+ * @param wallDistances 	the Chebyshev distance from each cell to the nearest wall, used to skip empty space, NULL to
+ * 							step one cell at a time
+ * @param stepsPerCell 		the number of steps per cell moved along the other axis, used with wallDistances
+ * @param crossed 			receives the cell of each intersection, NULL to record none
+ * @param verticalPanel 	DOOR_VERTICAL for the traversal of the vertical intersections, 0 for the horizontal one
+ * @return the final intersection, or the point of the door panel that was hit
+ */
+static inline Vec2 TraverseGrid(Vec2 intersection, Vec2 translationVector, int maxIteration, Vec2 playerPosition,
+		Vec2 rayCastedByPlayer, float mapCellSize, const int map[], int mapSize, const unsigned char wallDistances[],
+		float stepsPerCell, TraversalCells* crossed, int verticalPanel)
 {
-	if (playerPosition == NULL || rayCastedByPlayer == NULL || rayCastedByPlayer == NULL)
-	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
-	Vec3* runningHorizontalIntersection = CalculateFirstHorizontalIntersection(playerPosition, rayCastedByPlayer,
-			mapCellSize);
 	int i = 0;
-	// If current intersection is not in a cell that represents a wall, continue translating the intersection vector
-	while (!HasHit(runningHorizontalIntersection, mapCellSize, map, mapSize) &&
-			i < MAX_DDA_ITERATION) // Prevents infinite loop
+	if (wallDistances == NULL && crossed == NULL)
 	{
-		float slope = rayCastedByPlayer->y / rayCastedByPlayer->x;
-		Vec3* translationVector = NULL;
-		if (rayCastedByPlayer->y < 0)
-		{
-			translationVector = Vec3D(-mapCellSize / slope, -mapCellSize, ZERO);
-		}
-		else if (rayCastedByPlayer->y > 0)
+		// If current intersection is not in a cell that represents a wall, continue translating the intersection vector
+		for (;;)
 		{
-			translationVector = Vec3D(mapCellSize / slope, mapCellSize, ZERO);
+			int xIndex = (int)(intersection.x / mapCellSize);
+			int yIndex = (int)(intersection.y / mapCellSize);
+			if (xIndex >= 0 && xIndex < mapSize && yIndex >= 0 && yIndex < mapSize)
+			{
+				int value = map[yIndex * mapSize + xIndex];
+				if (value == WALL)
+				{break;}
+				if (IsDoor(value))
+				{
+					Vec2 panelPoint = V2Add(intersection, V2Scale(translationVector, 0.5f));
+					if (HitsDoorPanel(panelPoint, value, xIndex, yIndex, mapCellSize, verticalPanel))
+					{return panelPoint;}
+				}
+			}
+			if (i >= maxIteration) // Prevents infinite loop
+			{break;}
+			intersection = V2Add(intersection, translationVector);
+			++i;
 		}
-		else
+		return intersection;
+	}
+	// With the wall distances, skips the steps known to stay in open cells, counting them towards the maximum number of
+	// steps. The cells of the skipped intersections are recorded as well.
+	for (;;)
+	{
+		if (crossed != NULL)
+		{RecordTraversalCell(crossed, playerPosition, rayCastedByPlayer, intersection, mapCellSize, mapSize);}
+		if (i >= maxIteration)
+		{break;}
+		int xIndex = (int)(intersection.x / mapCellSize);
+		int yIndex = (int)(intersection.y / mapCellSize);
+		int steps = 1;
+		if (xIndex >= 0 && xIndex < mapSize && yIndex >= 0 && yIndex < mapSize)
 		{
-			break;
+			int value = map[yIndex * mapSize + xIndex];
+			if (value == WALL)
+			{break;}
+			if (IsDoor(value))
+			{
+				Vec2 panelPoint = V2Add(intersection, V2Scale(translationVector, 0.5f));
+				if (HitsDoorPanel(panelPoint, value, xIndex, yIndex, mapCellSize, verticalPanel))
+				{return panelPoint;}
+			}
+			// Doors count as walls in the wall distances, so no step skips over a door cell
+			if (wallDistances != NULL)
+			{
+				steps = GetTraversalSteps(wallDistances[yIndex * mapSize + xIndex], stepsPerCell);
+				if (steps > maxIteration - i)
+				{steps = maxIteration - i;}
+			}
 		}
-		if (translationVector != NULL)
+		for (int j = 1; j < steps && crossed != NULL; ++j)
 		{
-			Translate3D(runningHorizontalIntersection, translationVector);
-			free(translationVector);
+			RecordTraversalCell(crossed, playerPosition, rayCastedByPlayer,
+					V2Add(intersection, V2Scale(translationVector, (float)j)), mapCellSize, mapSize);
 		}
-		++i;
+		intersection = V2Add(intersection, steps == 1 ? translationVector : V2Scale(translationVector, (float)steps));
+		i += steps;
 	}
-	return runningHorizontalIntersection;
+	return intersection;
 }
 
 /**
- * Calculates the first vertical intersection between the ray cast by player and a cell that represents a wall.
- * 3D vectors are used for the calculation, assuming that the z component is 0.0f.
+ * Calculates the first horizontal intersection between the ray cast by player and a cell that represents a wall,
+ * recording the cells the traversal passed through.
  *
  * @param playerPosition 	the vector representing the player position
  * @param rayCastedByPlayer the vector representing the ray cast by player
  * @param mapCellSize 		the size of each cell in the map grid
  * @param map 				1D array representing the map, each element in the array represents a cell in the map grid
  * @param mapSize 			the side length of the square map grid (mapSize * mapSize == map.size())
- * @return the vector representing the first vertical intersection between the ray cast by player and a map cell
- * that represents a wall
+ * @param wallDistances 	the Chebyshev distance from each cell to the nearest wall, NULL to step one cell at a time
+ * @param maxRayLength 		the length after which the traversal stops
+ * @param crossed 			receives the cell of each intersection, NULL to record none
+ * @return the final horizontal intersection
  */
-Vec3* CalculateFinalVerticalIntersection(const Vec3* playerPosition, const Vec3* rayCastedByPlayer, float mapCellSize,
-		const int map[], int mapSize)
+static Vec2 TraverseHorizontalIntersections(Vec2 playerPosition, Vec2 rayCastedByPlayer, float mapCellSize,
+		const int map[], int mapSize, const unsigned char wallDistances[], float maxRayLength, TraversalCells* crossed)
 {
-	if (playerPosition == NULL || rayCastedByPlayer == NULL || map == NULL)
-	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
-	Vec3* runningVerticalIntersection = CalculateFirstVerticalIntersection(playerPosition, rayCastedByPlayer,
+	Vec2 doorHit;
+	if (HitsPlayerCellDoor(playerPosition, rayCastedByPlayer, mapCellSize, map, mapSize, 0, &doorHit))
+	{
+		if (crossed != NULL)
+		{RecordTraversalCell(crossed, playerPosition, rayCastedByPlayer, doorHit, mapCellSize, mapSize);}
+		return doorHit;
+	}
+	Vec2 runningHorizontalIntersection = CalculateFirstHorizontalIntersection(playerPosition, rayCastedByPlayer,
 			mapCellSize);
-	int i = 0;
-	// If current intersection is not in a cell that represents a wall, continue translating the intersection vector
-	while (!HasHit(runningVerticalIntersection, mapCellSize, map, mapSize) &&
-			i < MAX_DDA_ITERATION) // Prevents infinite loop
+	// Vertical rays never cross a horizontal grid line, so the first intersection is final
+	if (rayCastedByPlayer.y == 0)
 	{
-		float slope = rayCastedByPlayer->y / rayCastedByPlayer->x;
-		Vec3* translationVector = NULL;
-		if (rayCastedByPlayer->x < 0)
+		if (crossed != NULL)
 		{
-			translationVector = Vec3D(-mapCellSize, -mapCellSize * slope, ZERO);
+			RecordTraversalCell(crossed, playerPosition, rayCastedByPlayer, runningHorizontalIntersection, mapCellSize,
+					mapSize);
 		}
-		else if (rayCastedByPlayer->x > 0)
+		return runningHorizontalIntersection;
+	}
+	float slope = rayCastedByPlayer.y / rayCastedByPlayer.x;
+	Vec2 translationVector = rayCastedByPlayer.y < 0 ? V2(-mapCellSize / slope, -mapCellSize)
+			: V2(mapCellSize / slope, mapCellSize);
+	return TraverseGrid(runningHorizontalIntersection, translationVector,
+			GetMaxIteration(rayCastedByPlayer.y, mapCellSize, maxRayLength), playerPosition, rayCastedByPlayer,
+			mapCellSize, map, mapSize, wallDistances, mapCellSize / fabsf(translationVector.x), crossed, 0);
+}
+
+/**
+ * Calculates the first vertical intersection between the ray cast by player and a cell that represents a wall,
+ * recording the cells the traversal passed through.
+ *
+ * @param playerPosition 	the vector representing the player position
+ * @param rayCastedByPlayer the vector representing the ray cast by player
+ * @param mapCellSize 		the size of each cell in the map grid
+ * @param map 				1D array representing the map, each element in the array represents a cell in the map grid
+ * @param mapSize 			the side length of the square map grid (mapSize * mapSize == map.size())
+ * @param wallDistances 	the Chebyshev distance from each cell to the nearest wall, NULL to step one cell at a time
+ * @param maxRayLength 		the length after which the traversal stops
+ * @param crossed 			receives the cell of each intersection, NULL to record none
+ * @return the final vertical intersection
+ */
+static Vec2 TraverseVerticalIntersections(Vec2 playerPosition, Vec2 rayCastedByPlayer, float mapCellSize,
+		const int map[], int mapSize, const unsigned char wallDistances[], float maxRayLength, TraversalCells* crossed)
+{
+	Vec2 doorHit;
+	if (HitsPlayerCellDoor(playerPosition, rayCastedByPlayer, mapCellSize, map, mapSize, DOOR_VERTICAL, &doorHit))
+	{
+		if (crossed != NULL)
+		{RecordTraversalCell(crossed, playerPosition, rayCastedByPlayer, doorHit, mapCellSize, mapSize);}
+		return doorHit;
+	}
+	Vec2 runningVerticalIntersection = CalculateFirstVerticalIntersection(playerPosition, rayCastedByPlayer,
+			mapCellSize);
+	// Horizontal rays never cross a vertical grid line, so the first intersection is final
+	if (rayCastedByPlayer.x == 0)
+	{
+		if (crossed != NULL)
 		{
-			translationVector = Vec3D(mapCellSize, mapCellSize * slope, ZERO);
+			RecordTraversalCell(crossed, playerPosition, rayCastedByPlayer, runningVerticalIntersection, mapCellSize,
+					mapSize);
 		}
-		else
+		return runningVerticalIntersection;
+	}
+	float slope = rayCastedByPlayer.y / rayCastedByPlayer.x;
+	Vec2 translationVector = rayCastedByPlayer.x < 0 ? V2(-mapCellSize, -mapCellSize * slope)
+			: V2(mapCellSize, mapCellSize * slope);
+	return TraverseGrid(runningVerticalIntersection, translationVector,
+			GetMaxIteration(rayCastedByPlayer.x, mapCellSize, maxRayLength), playerPosition, rayCastedByPlayer,
+			mapCellSize, map, mapSize, wallDistances, mapCellSize / fabsf(translationVector.y), crossed,
+			DOOR_VERTICAL);
+}
+
+/**
+ * Calculates the first horizontal intersection between the ray cast by player and a cell that represents a wall.
+ *
+ * @param playerPosition 	the vector representing the player position
+ * @param rayCastedByPlayer the vector representing the ray cast by player
+ * @param mapCellSize 		the size of each cell in the map grid
+ * @param map 				1D array representing the map, each element in the array represents a cell in the map grid
+ * @param mapSize 			the side length of the square map grid (mapSize * mapSize == map.size())
+ * @param wallDistances 	the Chebyshev distance from each cell to the nearest wall, used to skip empty space, NULL to
+ * 							step one cell at a time
+ * @param maxRayLength 		the length after which the traversal stops, the intersection returned is at least this far
+ * 							from the player if no wall was hit before
+ * @return the vector representing the first horizontal intersection between the ray cast player and a map cell
+ * that represents a wall
+ */
+Vec2 CalculateFinalHorizontalIntersection(Vec2 playerPosition, Vec2 rayCastedByPlayer, float mapCellSize,
+		const int map[], int mapSize, const unsigned char wallDistances[], float maxRayLength)
+{
+	return TraverseHorizontalIntersections(playerPosition, rayCastedByPlayer, mapCellSize, map, mapSize, wallDistances,
+			maxRayLength, NULL);
+}
+
+/**
+ * Calculates the first vertical intersection between the ray cast by player and a cell that represents a wall.
+ *
+ * @param playerPosition 	the vector representing the player position
+ * @param rayCastedByPlayer the vector representing the ray cast by player
+ * @param mapCellSize 		the size of each cell in the map grid
+ * @param map 				1D array representing the map, each element in the array represents a cell in the map grid
+ * @param mapSize 			the side length of the square map grid (mapSize * mapSize == map.size())
+ * @param wallDistances 	the Chebyshev distance from each cell to the nearest wall, used to skip empty space, NULL to
+ * 							step one cell at a time
+ * @param maxRayLength 		the length after which the traversal stops, the intersection returned is at least this far
+ * 							from the player if no wall was hit before
+ * @return the vector representing the first vertical intersection between the ray cast by player and a map cell
+ * that represents a wall
+ */
+Vec2 CalculateFinalVerticalIntersection(Vec2 playerPosition, Vec2 rayCastedByPlayer, float mapCellSize,
+		const int map[], int mapSize, const unsigned char wallDistances[], float maxRayLength)
+{
+	return TraverseVerticalIntersections(playerPosition, rayCastedByPlayer, mapCellSize, map, mapSize, wallDistances,
+			maxRayLength, NULL);
+}
+
+/**
+ * Lists the cells a ray passed through before it stopped: the player's cell, then the cells recorded by the traversal
+ * that stopped the ray and those recorded by the other traversal up to the final intersection. The other traversal
+ * only checks the cells entered across its own grid lines, so it may have run past the wall that stopped the ray.
+ *
+ * @param playerPosition the vector representing the player position
+ * @param mapCellSize 	 the size of each cell in the map grid
+ * @param mapSize 		 the side length of the square map grid (mapSize * mapSize == map.size())
+ * @param hit 			 the cells of the traversal that stopped the ray
+ * @param other 		 the cells of the other traversal
+ * @param cells 		 the array of RAY_MAX_CROSSED_CELLS cells receiving the cells
+ * @return the number of cells listed
+ */
+static int ListCrossedCells(Vec2 playerPosition, float mapCellSize, int mapSize, const TraversalCells* hit,
+		const TraversalCells* other, int cells[])
+{
+	int numCells = 0;
+	int xIndex = (int)(playerPosition.x / mapCellSize);
+	int yIndex = (int)(playerPosition.y / mapCellSize);
+	if (xIndex >= 0 && xIndex < mapSize && yIndex >= 0 && yIndex < mapSize)
+	{cells[numCells++] = yIndex * mapSize + xIndex;}
+	for (int i = 0; i < hit->numCells; ++i)
+	{cells[numCells++] = hit->cells[i];}
+	// Intersections only get farther from the player along the ray
+	float hitDistance = hit->numCells > 0 ? hit->distances[hit->numCells - 1] : 0.0f;
+	for (int i = 0; i < other->numCells && other->distances[i] <= hitDistance; ++i)
+	{cells[numCells++] = other->cells[i];}
+	return numCells;
+}
+
+/**
+ * Casts one ray and calculates its intersection with a cell that represents a wall. It calculates the final
+ * horizontal and final vertical intersections, and the one closer to the player is returned. The z component of the
+ * result is HORIZONTAL_WALL or VERTICAL_WALL depending on the side of the wall that was hit. A door stops the ray in
+ * the middle of its cell where its panel is closed, the hit lies inside the door cell. The cells the ray passed
+ * through before it stopped, including the wall that was hit, can be listed as well.
+ *
+ * @param playerPosition 	the vector representing the player position
+ * @param rayCastedByPlayer the vector representing the ray cast by player, this vector is a unit vector
+ * @param mapCellSize 		the size of each cell in the map grid
+ * @param map 				1D array representing the map, each element in the array represents a cell in the map grid
+ * @param mapSize 			the side length of the square map grid (mapSize * mapSize == map.size())
+ * @param wallDistances 	the Chebyshev distance from each cell to the nearest wall, used to skip empty space, NULL to
+ * 							step one cell at a time
+ * @param maxRayLength 		the length after which the traversal stops, RAY_UNLIMITED_LENGTH to only stop at walls
+ * @param crossedCells 		the array of RAY_MAX_CROSSED_CELLS cells receiving the cells the ray passed through, a cell
+ * 							may be listed twice, NULL to list none
+ * @param numCrossedCells 	receives the number of cells listed, may be NULL if crossedCells is NULL
+ * @return the intersection, with the wall side in the z component
+ */
+Vec3 CastRay(Vec2 playerPosition, Vec2 rayCastedByPlayer, float mapCellSize, const int map[], int mapSize,
+		const unsigned char wallDistances[], float maxRayLength, int crossedCells[], int* numCrossedCells)
+{
+	TraversalCells horizontalCells;
+	TraversalCells verticalCells;
+	horizontalCells.numCells = 0;
+	verticalCells.numCells = 0;
+	Vec2 horizontalIntersection = TraverseHorizontalIntersections(playerPosition, rayCastedByPlayer, mapCellSize, map,
+			mapSize, wallDistances, maxRayLength, crossedCells != NULL ? &horizontalCells : NULL);
+	Vec2 verticalIntersection = TraverseVerticalIntersections(playerPosition, rayCastedByPlayer, mapCellSize, map,
+			mapSize, wallDistances, maxRayLength, crossedCells != NULL ? &verticalCells : NULL);
+	// Squared distances order the intersections the same way as distances
+	if (V2DistanceSquared(playerPosition, horizontalIntersection) <
+			V2DistanceSquared(playerPosition, verticalIntersection))
+	{
+		if (crossedCells != NULL)
 		{
-			break;
+			*numCrossedCells = ListCrossedCells(playerPosition, mapCellSize, mapSize, &horizontalCells,
+					&verticalCells, crossedCells);
 		}
-		if (translationVector != NULL)
+		return V3FromVec2(horizontalIntersection, HORIZONTAL_WALL);
+	}
+	else
+	{
+		if (crossedCells != NULL)
 		{
-			Translate3D(runningVerticalIntersection, translationVector);
-			free(translationVector);
+			*numCrossedCells = ListCrossedCells(playerPosition, mapCellSize, mapSize, &verticalCells,
+					&horizontalCells, crossedCells);
 		}
-		++i;
+		return V3FromVec2(verticalIntersection, VERTICAL_WALL);
 	}
-	return runningVerticalIntersection;
 }
 
 /**
  * Calculates the final intersection between the ray cast by player and a cell that represents a wall. If first
  * calculates the first horizontal and first vertical intersections, then calculates the euclidean distance between the
  * player position and the two intersection points respectively, the intersection that produces the shorter distance is
- * returned. 3D vectors are used for the calculation, assuming that the z component is 0.0f.
+ * returned. Kept for compatibility, CastRay() returns the intersection by value.
  *
  * @param playerPosition 	the vector representing the player position
  * @param rayCastedByPlayer the vector representing the ray cast by player
  * @param mapCellSize 		the size of each cell in the map grid
  * @param map 				1D array representing the map, each element in the array represents a cell in the map grid
  * @param mapSize 			the side length of the square map grid (mapSize * mapSize == map.size())
+ * @param maxRayLength 		the length after which the traversal stops, RAY_UNLIMITED_LENGTH to only stop at walls
  * @return the final vector representing the intersection between the ray cast by player and a map cell
  * that represents a wall
  */
 Vec3* CalculateFinalIntersection(const Vec3* playerPosition, const Vec3* rayCastedByPlayer, float mapCellSize,
-		const int map[], int mapSize)
+		const int map[], int mapSize, float maxRayLength)
+{
+	RCM_ASSERT_NOT_NULL(playerPosition);
+	RCM_ASSERT_NOT_NULL(rayCastedByPlayer);
+	RCM_ASSERT_NOT_NULL(map);
+	Vec3 intersection = CastRay(V3XY(*playerPosition), V3XY(*rayCastedByPlayer), mapCellSize, map, mapSize, NULL,
+			maxRayLength, NULL, NULL);
+	return Vec3D(intersection.x, intersection.y, intersection.z);
+}
+
+/**
+ * Casts the rays within the field of view into a caller-provided array. Ray i points at the angle
+ * -fieldOfView / 2 + (i + 1) * fieldOfView / numOfRays relative to the player direction. The rotation between two
+ * consecutive rays is the same for all rays, so its cosine and sine are evaluated once.
+ *
+ * @param playerPosition  the vector representing the player position
+ * @param playerDirection the vector representing the direction that the player is facing, this vector is a unit
+ * 						  vector
+ * @param mapCellSize 	  the size of each cell in the map grid
+ * @param map 			  1D array representing the map, each element in the array represents a cell in the map grid
+ * @param mapSize 		  the side length of the square map grid (mapSize * mapSize == map.size())
+ * @param wallDistances   the Chebyshev distance from each cell to the nearest wall, used to skip empty space, NULL to
+ * 						  step one cell at a time
+ * @param fieldOfView 	  the angle in radians
+ * @param numOfRays 	  the number of rays cast by player within the field of view
+ * @param maxRayLength 	  the length after which the traversal stops
+ * @param intersections   the array of numOfRays intersections to be written
+ * @param crossedCells 	  the array of numOfRays * RAY_MAX_CROSSED_CELLS cells receiving the cells each ray passed
+ * 						  through, starting at i * RAY_MAX_CROSSED_CELLS for ray i, NULL to list none
+ * @param numCrossedCells the array of numOfRays counts receiving the number of cells listed for each ray, may be NULL
+ * 						  if crossedCells is NULL
+ */
+void CastRays(Vec2 playerPosition, Vec2 playerDirection, float mapCellSize, const int map[], int mapSize,
+		const unsigned char wallDistances[], float fieldOfView, int numOfRays, float maxRayLength, Vec3 intersections[],
+		int crossedCells[], int numCrossedCells[])
+{
+	CastRaysInRange(playerPosition, playerDirection, mapCellSize, map, mapSize, wallDistances, fieldOfView, numOfRays,
+			0, numOfRays, maxRayLength, intersections, crossedCells, numCrossedCells);
+}
+
+/**
+ * Casts the rays [rayBegin, rayEnd) of the numOfRays rays within the field of view, so that disjoint ranges of one view
+ * can be cast by different threads. Every RAY_DIRECTION_ANCHOR_INTERVAL rays the direction is rotated from the player
+ * direction, the rays in between are rotated from their predecessor. The anchors do not depend on the range, so the
+ * result is the same however the rays are split between threads.
+ *
+ * @param playerPosition  the vector representing the player position
+ * @param playerDirection the vector representing the direction that the player is facing, this vector is a unit
+ * 						  vector
+ * @param mapCellSize 	  the size of each cell in the map grid
+ * @param map 			  1D array representing the map, each element in the array represents a cell in the map grid
+ * @param mapSize 		  the side length of the square map grid (mapSize * mapSize == map.size())
+ * @param wallDistances   the Chebyshev distance from each cell to the nearest wall, used to skip empty space, NULL to
+ * 						  step one cell at a time
+ * @param fieldOfView 	  the angle in radians
+ * @param numOfRays 	  the number of rays cast by player within the field of view
+ * @param rayBegin 		  the first ray to be cast
+ * @param rayEnd 		  one past the last ray to be cast
+ * @param maxRayLength 	  the length after which the traversal stops
+ * @param intersections   the array of numOfRays intersections, only [rayBegin, rayEnd) is written
+ * @param crossedCells 	  the array of numOfRays * RAY_MAX_CROSSED_CELLS cells receiving the cells each ray passed
+ * 						  through, starting at i * RAY_MAX_CROSSED_CELLS for ray i, NULL to list none
+ * @param numCrossedCells the array of numOfRays counts receiving the number of cells listed for each ray, may be NULL
+ * 						  if crossedCells is NULL
+ */
+void CastRaysInRange(Vec2 playerPosition, Vec2 playerDirection, float mapCellSize, const int map[], int mapSize,
+		const unsigned char wallDistances[], float fieldOfView, int numOfRays, int rayBegin, int rayEnd,
+		float maxRayLength, Vec3 intersections[], int crossedCells[], int numCrossedCells[])
 {
-	if (playerPosition == NULL || rayCastedByPlayer == NULL || map == NULL)
-	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
-	Vec3* horizontalIntersection = CalculateFinalHorizontalIntersection(
-			playerPosition, rayCastedByPlayer, mapCellSize, map, mapSize);
-	Vec3* verticalIntersection = CalculateFinalVerticalIntersection(
-			playerPosition, rayCastedByPlayer, mapCellSize, map, mapSize);
-	if (EuclideanDistance3D(playerPosition, horizontalIntersection) < EuclideanDistance3D(playerPosition,
-			verticalIntersection))
+	float angleIncrement = fieldOfView / (float)numOfRays;
+	float cosIncrement = cosf(angleIncrement);
+	float sinIncrement = sinf(angleIncrement);
+	Vec2 runningRayDirection = playerDirection;
+	// Starts at the anchor preceding the range, the directions of the rays before rayBegin are not cast
+	for (int i = rayBegin - rayBegin % RAY_DIRECTION_ANCHOR_INTERVAL; i < rayEnd; ++i)
 	{
-		free(verticalIntersection);
-		horizontalIntersection->z = HORIZONTAL_WALL;
-		return horizontalIntersection;
+		if (i % RAY_DIRECTION_ANCHOR_INTERVAL == 0)
+		{runningRayDirection = V2Rotate(playerDirection, -fieldOfView / 2 + (float)(i + 1) * angleIncrement);}
+		else
+		{runningRayDirection = V2RotateCosSin(runningRayDirection, cosIncrement, sinIncrement);}
+		if (i >= rayBegin)
+		{
+			// Each ray lists its cells in its own part of the arrays, so ranges cast by different threads never overlap
+			if (crossedCells != NULL)
+			{
+				intersections[i] = CastRay(playerPosition, runningRayDirection, mapCellSize, map, mapSize,
+						wallDistances, maxRayLength, crossedCells + i * RAY_MAX_CROSSED_CELLS, &numCrossedCells[i]);
+			}
+			else
+			{
+				intersections[i] = CastRay(playerPosition, runningRayDirection, mapCellSize, map, mapSize,
+						wallDistances, maxRayLength, NULL, NULL);
+			}
+		}
 	}
-	else
+}
+
+/**
+ * Appends a span to the spans of a ray followed past low walls and through windows, unless RAY_MAX_SPANS spans are
+ * listed already.
+ *
+ * @param spans 	 the array of RAY_MAX_SPANS spans
+ * @param numSpans 	 the number of spans listed, updated
+ * @param point 	 the point where the ray meets the surface
+ * @param side 		 HORIZONTAL_WALL or VERTICAL_WALL
+ * @param distance 	 the perpendicular distance of the point
+ * @param baseHeight the height of the bottom of the face
+ * @param topHeight  the height of the top of the face or of the top surface
+ * @param cell 		 the index of the cell of the surface
+ * @param isTop 	 1 for the far edge of a top surface, 0 for a face
+ * @param isWindow 	 1 for the face of a window, 0 otherwise
+ */
+static inline void AddRaySpan(RaySpan spans[], int* numSpans, Vec2 point, float side, float distance,
+		float baseHeight, float topHeight, int cell, int isTop, int isWindow)
+{
+	if (*numSpans >= RAY_MAX_SPANS)
+	{return;}
+	RaySpan* span = &spans[(*numSpans)++];
+	span->intersection = V3FromVec2(point, side);
+	span->distance = distance;
+	span->baseHeight = baseHeight;
+	span->topHeight = topHeight;
+	span->cell = cell;
+	span->isTop = isTop;
+	span->isWindow = isWindow;
+}
+
+/**
+ * Follows a ray that hit a low wall or a window to list the surfaces seen over or through it, from the nearest to the
+ * farthest: the face of the wall, the far edge of its top if it is lower than the eye, then the faces rising above the
+ * cell in front of them, the tops of the walls behind and the faces of the windows, until a full wall, a door panel or
+ * a window past the RAY_MAX_WINDOW_LAYERS first ones stops the ray. The cells entered past the wall that was hit are
+ * appended to the cells listed by CastRay(). Past that wall the ray steps one cell at a time across the nearer of the
+ * next vertical and horizontal grid lines, since every grid line crossed may start a new span. The bounded number of
+ * window layers keeps the cost of compositing a column predictable.
+ *
+ * @param playerPosition  the vector representing the player position
+ * @param playerDirection the vector representing the direction that the player is facing, this vector is a unit vector
+ * @param intersection 	  the intersection returned by CastRay() for the ray
+ * @param distance 		  the perpendicular distance of the intersection
+ * @param mapCellSize 	  the size of each cell in the map grid
+ * @param map 			  the map
+ * @param maxRayLength 	  the length after which the ray is no longer followed
+ * @param spans 		  the array of RAY_MAX_SPANS spans to be written
+ * @param crossedCells 	  the array of RAY_MAX_CROSSED_CELLS cells listed for the ray by CastRay(), NULL to list none
+ * @param numCrossedCells the number of cells listed for the ray, updated, may be NULL if crossedCells is NULL
+ * @return the number of spans written, 0 if the ray did not hit a low wall or a window
+ */
+int TraceRaySpans(Vec2 playerPosition, Vec2 playerDirection, Vec3 intersection, float distance, float mapCellSize,
+		const Map* map, float maxRayLength, RaySpan spans[], int crossedCells[], int* numCrossedCells)
+{
+	RCM_ASSERT_NOT_NULL(map);
+	const int size = map->size;
+	int xIndex = (int)(intersection.x / mapCellSize);
+	int yIndex = (int)(intersection.y / mapCellSize);
+	// Rays stopped by the maximum length may end outside the map
+	if (xIndex < 0 || xIndex >= size || yIndex < 0 || yIndex >= size ||
+			(!IsMapLowWall(map, yIndex * size + xIndex) && !IsMapWindow(map, yIndex * size + xIndex)))
+	{return 0;}
+	Vec2 ray = V2Normalize(V2Sub(V3XY(intersection), playerPosition));
+	float perpendicularScale = V2Dot(ray, playerDirection);
+	// Length along the ray at which it crosses the next vertical and the next horizontal grid line, and the length
+	// between two consecutive ones
+	int stepX = ray.x < 0.0f ? -1 : 1;
+	int stepY = ray.y < 0.0f ? -1 : 1;
+	float nextX = ray.x != 0.0f ? ((float)(xIndex + (stepX > 0)) * mapCellSize - playerPosition.x) / ray.x : INFINITY;
+	float nextY = ray.y != 0.0f ? ((float)(yIndex + (stepY > 0)) * mapCellSize - playerPosition.y) / ray.y : INFINITY;
+	float deltaX = ray.x != 0.0f ? mapCellSize / fabsf(ray.x) : INFINITY;
+	float deltaY = ray.y != 0.0f ? mapCellSize / fabsf(ray.y) : INFINITY;
+
+	int cell = yIndex * size + xIndex;
+	// The height of the cell the ray is in, which hides the bottom of the faces behind it, a window hides nothing
+	float height = (float)GetMapWallHeight(map, cell) / MAP_WALL_HEIGHT_FULL;
+	int isWindow = IsMapWindow(map, cell);
+	int numSpans = 0;
+	int numWindows = isWindow;
+	AddRaySpan(spans, &numSpans, V3XY(intersection), intersection.z, distance, 0.0f, height, cell, 0, isWindow);
+	if (isWindow)
+	{height = 0.0f;}
+	for (int i = 0; i < RAY_MAX_SPAN_STEPS && numSpans < RAY_MAX_SPANS; ++i)
 	{
-		free(horizontalIntersection);
-		verticalIntersection->z = VERTICAL_WALL;
-		return verticalIntersection;
+		int crossesX = nextX < nextY;
+		float length = crossesX ? nextX : nextY;
+		if (length > maxRayLength)
+		{break;}
+		Vec2 point = V2Add(playerPosition, V2Scale(ray, length));
+		float side = crossesX ? VERTICAL_WALL : HORIZONTAL_WALL;
+		// The top of a wall lower than the eye is seen up to where the ray leaves the wall
+		if (height > 0.0f && height < 0.5f)
+		{AddRaySpan(spans, &numSpans, point, side, length * perpendicularScale, height, height, cell, 1, 0);}
+		if (crossesX)
+		{
+			xIndex += stepX;
+			nextX += deltaX;
+		}
+		else
+		{
+			yIndex += stepY;
+			nextY += deltaY;
+		}
+		if (xIndex < 0 || xIndex >= size || yIndex < 0 || yIndex >= size)
+		{break;}
+		cell = yIndex * size + xIndex;
+		if (crossedCells != NULL && *numCrossedCells < RAY_MAX_CROSSED_CELLS)
+		{crossedCells[(*numCrossedCells)++] = cell;}
+		int value = map->cells[cell];
+		if (value == WALL)
+		{
+			float wallHeight = (float)GetMapWallHeight(map, cell) / MAP_WALL_HEIGHT_FULL;
+			isWindow = IsMapWindow(map, cell) && numWindows < RAY_MAX_WINDOW_LAYERS;
+			// Only the part of the face rising above the cell in front of it can be seen
+			if (wallHeight > height)
+			{
+				AddRaySpan(spans, &numSpans, point, side, length * perpendicularScale, height, wallHeight, cell, 0,
+						isWindow);
+			}
+			if (isWindow)
+			{
+				++numWindows;
+				height = 0.0f;
+				continue;
+			}
+			if (wallHeight >= 1.0f)
+			{break;}
+			height = wallHeight;
+			continue;
+		}
+		height = 0.0f;
+		if (IsDoor(value))
+		{
+			int verticalPanel = value & DOOR_VERTICAL;
+			float component = verticalPanel ? ray.x : ray.y;
+			float middle = ((float)(verticalPanel ? xIndex : yIndex) + 0.5f) * mapCellSize;
+			float panelLength = (middle - (verticalPanel ? playerPosition.x : playerPosition.y)) / component;
+			if (component == 0.0f || panelLength < length)
+			{continue;}
+			Vec2 panelPoint = V2Add(playerPosition, V2Scale(ray, panelLength));
+			if (HitsDoorPanel(panelPoint, value, xIndex, yIndex, mapCellSize, verticalPanel))
+			{
+				AddRaySpan(spans, &numSpans, panelPoint, verticalPanel ? VERTICAL_WALL : HORIZONTAL_WALL,
+						panelLength * perpendicularScale, 0.0f, 1.0f, cell, 0, 0);
+				break;
+			}
+		}
 	}
+	return numSpans;
 }
 
 /**
- * Calculates all the intersections between the rays cast by player and the cells that represent walls.
- * 3D vectors are used for the calculation, assuming that the z component is 0.0f.
+ * Calculates all the intersections between the rays cast by player and the cells that represent walls. Kept for
+ * compatibility, CastRays() writes into an existing array instead of allocating one.
  *
  * @param playerPosition 	the vector representing the player position
  * @param rayCastedByPlayer the vector representing the ray cast by player
@@ -248,93 +796,86 @@ Vec3* CalculateFinalIntersection(const Vec3* playerPosition, const Vec3* rayCast
  * @param mapSize 			the side length of the square map grid (mapSize * mapSize == map.size())
  * @param fieldOfView 		the angle in radians
  * @param numOfRays 		the number of rays cast by player within the field of view
+ * @param maxRayLength 		the length after which the traversal stops, walls beyond the fog distance are invisible
+ * 							so the fog distance is passed here
  * @return an array of vector that represents all the intersections between the rays cast by player and the cells
  * that represent walls
  */
 Vec3* CalculateIntersections(const Vec3* playerPosition, const Vec3* playerDirection, float mapCellSize,
-		const int map[], int mapSize, float fieldOfView, int numOfRays)
+		const int map[], int mapSize, float fieldOfView, int numOfRays, float maxRayLength)
 {
-	if (playerPosition == NULL || playerDirection == NULL || map == NULL)
-	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
-	// Calculate the angle step size based on the field of view and the number of rays
-	float angleIncrement = fieldOfView / (float)numOfRays;
-
-	Vec3 runningRayDirection = *playerDirection;
-	Rotate3D(&runningRayDirection, -fieldOfView / 2);
+	RCM_ASSERT_NOT_NULL(playerPosition);
+	RCM_ASSERT_NOT_NULL(playerDirection);
+	RCM_ASSERT_NOT_NULL(map);
 	// Allocate Vec3 array to store all intersections
 	Vec3* allIntersections = (Vec3*)calloc((int)numOfRays, sizeof(Vec3));
 	if (allIntersections == NULL)
 	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
-	// Cast a ray for each angle in the field of view
-	for (int i = 0; i < numOfRays; ++i)
-	{
-		Rotate3D(&runningRayDirection, angleIncrement);
-		// Calculate the intersection of the ray with the map
-		Vec3* currentIntersection = CalculateFinalIntersection(
-				playerPosition, &runningRayDirection, mapCellSize, map, mapSize);
-		allIntersections[i] = *currentIntersection;
-		free(currentIntersection);
-	}
+	CastRays(V3XY(*playerPosition), V3XY(*playerDirection), mapCellSize, map, mapSize, NULL, fieldOfView, numOfRays,
+			maxRayLength, allIntersections, NULL, NULL);
 	return allIntersections;
 }
 
 /**
- * Calculates the height used for first-person view rendering based on the length of the ray vector. The player
- * direction vector is always a unit vector, the angle between the player direction vector and the ray vector is denoted
- * as "theta", then the perpendicular distance between the ray-wall intersection point and its projection point on the
- * camera plane (line in 2D) is equal to the dot product between the player direction vector and the ray vector.
+ * Calculates the heights and perpendicular distances used for first-person view rendering into caller-provided
+ * arrays. The player direction vector is always a unit vector, the angle between the player direction vector and the
+ * ray vector is denoted as "theta", then the perpendicular distance between the ray-wall intersection point and its
+ * projection point on the camera plane (line in 2D) is equal to the dot product between the player direction vector
+ * and the ray vector.
  *
  * If playerDirection is a unit vector, then:
  * playerDirection * ray = ||playerDirection|| * ||ray|| * cos(theta) = ||ray|| * cos(theta)
  *
- * @param rayVector 	  the vector representing the ray cast by player
- * @param playerDirection the vector representing the direction that the player is facing, this vector is a unit vector
- * @param windowHeight 	  the height of the SDL window
- * @return the height converted from the ray vector length
+ * @param allIntersections the vectors representing all the intersection points
+ * @param playerPosition   the vector representing the player position
+ * @param playerDirection  the vector representing the direction that the player is facing, this vector is a unit vector
+ * @param numOfRays 	   the number of rays casted by the player within the field of view
+ * @param windowHeight     the height of the first-person view in pixels
+ * @param heights 		   the array receiving the height of each ray, may be NULL
+ * @param distances 	   the array receiving the perpendicular distance of each ray, may be NULL
  */
-float ConvertRayLengthToHeight(const Vec3* rayVector, const Vec3* playerDirection, float windowHeight)
+void CalculateRayHeights(const Vec3 allIntersections[], Vec2 playerPosition, Vec2 playerDirection, int numOfRays,
+		float windowHeight, float heights[], float distances[])
 {
-	if (rayVector == NULL || playerDirection == NULL)
-	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
-	// Calculates the length of the line segment orthogonal to the camera plane.
-	// Reference: https://lodev.org/cgtutor/raycasting.html
-	float height = RAY_HEIGHT_COEFFICIENT * windowHeight / Dot3D(rayVector, playerDirection);
-	// Height can not exceed window height
-	height = height > windowHeight ? windowHeight : height;
-	return height;
+	for (int i = 0; i < numOfRays; ++i)
+	{
+		// Calculates the length of the line segment orthogonal to the camera plane.
+		// Reference: https://lodev.org/cgtutor/raycasting.html
+		float distance = V2Dot(V2Sub(V3XY(allIntersections[i]), playerPosition), playerDirection);
+		if (heights != NULL)
+		{
+			float height = RAY_HEIGHT_COEFFICIENT * windowHeight / distance;
+			// Height can not exceed window height
+			heights[i] = height > windowHeight ? windowHeight : height;
+		}
+		if (distances != NULL)
+		{distances[i] = distance;}
+	}
 }
 
 /**
- * Calculates all the heights used for first-person view rendering based on the length of each ray vector.
+ * Calculates all the heights used for first-person view rendering based on the length of each ray vector. Kept for
+ * compatibility, CalculateRayHeights() writes into existing arrays instead of allocating one.
  *
  * @param allIntersections the vectors representing all the intersection points
  * @param playerPosition   the vector representing the player position
  * @param playerDirection  the vector representing the direction that the player is facing, this vector is a unit vector
  * @param numOfRays 	   the number of rays casted by the player within the field of view
- * @param windowHeight     the height of the SDL window
- * @return an array of float that represents the height used to render the rectangles in the SDL renderer
+ * @param windowHeight     the height of the first-person view in pixels
+ * @param distances 	   the array receiving the perpendicular distance of each ray, may be NULL
+ * @return an array of float that represents the height of each wall column in the first-person view
  */
 float* CalculateHeights(const Vec3* allIntersections, const Vec3* playerPosition, const Vec3* playerDirection,
-		int numOfRays, float windowHeight)
+		int numOfRays, float windowHeight, float* distances)
 {
-	if (allIntersections == NULL || playerPosition == NULL || playerDirection == NULL)
-	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
+	RCM_ASSERT_NOT_NULL(allIntersections);
+	RCM_ASSERT_NOT_NULL(playerPosition);
+	RCM_ASSERT_NOT_NULL(playerDirection);
 	float* heights = (float*)calloc(numOfRays, sizeof(float));
 	if (heights == NULL)
 	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
-	// Retrieves player's position in order to calculate ray vector
-	Vec3 playerPosForCalculation = *playerPosition;
-	Invert3D(&playerPosForCalculation);
-
-	for (int i = 0; i < numOfRays; ++i)
-	{
-		// Initialize each ray vector
-		Vec3* rayVector = Vec3D(allIntersections[i].x, allIntersections[i].y, ZERO);
-		Translate3D(rayVector, &playerPosForCalculation);
-		// Calculate height based on ray vector length
-		heights[i] = ConvertRayLengthToHeight(rayVector, playerDirection, windowHeight);
-		free(rayVector);
-	}
+	CalculateRayHeights(allIntersections, V3XY(*playerPosition), V3XY(*playerDirection), numOfRays, windowHeight,
+			heights, distances);
 	return heights;
 }
 
@@ -352,8 +893,8 @@ float* CalculateHeights(const Vec3* allIntersections, const Vec3* playerPosition
 int GetPointedNonWallCellIndex(const Vec3* playerDirectionIntersection, const Vec3* playerDirection,
 		float mapCellSize, int mapSize)
 {
-	if (playerDirectionIntersection == NULL || playerDirection == NULL)
-	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
+	RCM_ASSERT_NOT_NULL(playerDirectionIntersection);
+	RCM_ASSERT_NOT_NULL(playerDirection);
 	if (CompareFloats(playerDirectionIntersection->z, VERTICAL_WALL) == 0) // Vertical intersection
 	{
 		if (playerDirection->x < 0) // left intersection
@@ -380,5 +921,39 @@ int GetPointedNonWallCellIndex(const Vec3* playerDirectionIntersection, const Ve
 					+ (int)(playerDirectionIntersection->x / mapCellSize) - mapSize;
 		}
 	}
+	// The player direction is parallel to the wall, the cell containing the intersection is returned
+	return (int)(playerDirectionIntersection->y / mapCellSize) * mapSize
+			+ (int)(playerDirectionIntersection->x / mapCellSize);
+}
 
-}
\ No newline at end of file
+/**
+ * Gets the position of an intersection along the wall it hit, used as the horizontal texture coordinate. Vertical
+ * walls run along the y axis and horizontal walls along the x axis.
+ *
+ * @param intersection the intersection, the z component holds the wall side
+ * @param mapCellSize  the size of each cell in the map grid
+ * @return the offset along the wall in [0, 1)
+ */
+float GetWallHitOffset(const Vec3* intersection, float mapCellSize)
+{
+	RCM_ASSERT_NOT_NULL(intersection);
+	float alongWall = CompareFloats(intersection->z, VERTICAL_WALL) == 0 ? intersection->y : intersection->x;
+	float cellPosition = alongWall / mapCellSize;
+	return cellPosition - floorf(cellPosition);
+}
+
+/**
+ * Gets the index of the cell containing an intersection. For an intersection returned by CalculateFinalIntersection()
+ * this is the wall cell that was hit. Intersections of rays that stopped before hitting a wall may lie outside the map
+ * grid, in which case the index is out of range.
+ *
+ * @param intersection the intersection
+ * @param mapCellSize  the size of each cell in the map grid
+ * @param mapSize 	   the side length of the square map grid (mapSize * mapSize == map.size())
+ * @return the index of the cell containing the intersection
+ */
+int GetHitCellIndex(const Vec3* intersection, float mapCellSize, int mapSize)
+{
+	RCM_ASSERT_NOT_NULL(intersection);
+	return (int)(intersection->y / mapCellSize) * mapSize + (int)(intersection->x / mapCellSize);
+}
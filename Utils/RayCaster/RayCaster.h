@@ -6,10 +6,163 @@
 #define HORIZONTAL_WALL (-1.0f)   // representing a horizontal wall, passed as the z component in 3D vector
 #define VERTICAL_WALL 1.0f        // representing a vertical wall, passed as the z component in 3D vector
 #define RAY_HEIGHT_COEFFICIENT 16 // changing the rectangle height for rendering
+#define RAY_UNLIMITED_LENGTH INFINITY // maximum ray length that only stops the traversal at walls
+#define RAY_DIRECTION_ANCHOR_INTERVAL 32 // number of rays between two ray directions rotated from the player direction
+#define RAY_MAX_SPANS 8           // maximum number of surfaces a ray is followed through past low walls and windows
+#define RAY_MAX_WINDOW_LAYERS 3   // maximum number of windows a ray sees through, a window behind them is opaque
+#define RAY_MAX_SPAN_STEPS (2 * MAX_DDA_ITERATION) // maximum number of cells a ray is followed through past the wall
+														   // it hit
+#define RAY_MAX_CROSSED_CELLS (2 * MAX_DDA_ITERATION + 3 + RAY_MAX_SPAN_STEPS) // maximum number of cells listed for one
+														  // ray: the player's cell, the cell of each intersection of
+														  // both traversals and the cells past the wall it hit
 
+#include <math.h>
 #include "../Vec3/Vec3.h"
 #include "../../Map/Map.h"
 
+/**
+ * Struct for one surface met by a ray that is followed past low walls and through windows, drawn as one span of a frame
+ * buffer column. Heights are relative to a full wall, the eye is at half height, so the top of a wall lower than that
+ * is seen from above between the point where the ray enters the wall and the point where it leaves it.
+ */
+typedef struct RaySpan_struct
+{
+	Vec3 intersection; // point where the ray meets the face or leaves the top, the z component holds the wall side
+	float distance;    // perpendicular distance of the point
+	float baseHeight;  // height of the bottom of a face, which is the height of the cell in front of it
+	float topHeight;   // height of the top of a face, or of the top surface ending at this point
+	int cell;          // index of the wall or door cell the surface belongs to
+	int isTop;         // 1 for the far edge of the top surface of a wall lower than the eye, 0 for a face
+	int isWindow;      // 1 for the face of a window, composited over the surfaces behind it
+} RaySpan;
+
+/**
+ * Gets the frame buffer row a point of a wall face projects to. A full wall is centered on the horizon, so the eye is
+ * at half its height.
+ *
+ * @param height 	  the height of the point relative to a full wall, 0 on the floor and 1 at the ceiling
+ * @param distance 	  the perpendicular distance of the wall face
+ * @param frameHeight the height of the frame buffer
+ * @return the row, may lie outside the frame buffer
+ */
+static inline float GetWallRow(float height, float distance, float frameHeight)
+{
+	float wallHeight = RAY_HEIGHT_COEFFICIENT * frameHeight / distance;
+	return (frameHeight - wallHeight) / 2.0f + (1.0f - height) * wallHeight;
+}
+
+/**
+ * Casts one ray and calculates its intersection with a cell that represents a wall. The closer of the final horizontal
+ * and final vertical intersections is returned, with HORIZONTAL_WALL or VERTICAL_WALL in the z component. A door
+ * stops the ray in the middle of its cell where its panel is closed, the hit lies inside the door cell. The cells
+ * the ray passed through before it stopped, including the wall that was hit, can be listed as well.
+ *
+ * @param playerPosition 	the vector representing the player position
+ * @param rayCastedByPlayer the vector representing the ray casted by the player, this vector is a unit vector
+ * @param mapCellSize 		the size of each cell in the map grid
+ * @param map 				1D array representing the map, each element in the array represents a cell in the map grid
+ * @param mapSize 			the side length of the square map grid (mapSize * mapSize == map.size())
+ * @param wallDistances 	the Chebyshev distance from each cell to the nearest wall, used to skip empty space, NULL to
+ * 							step one cell at a time
+ * @param maxRayLength 		the length after which the traversal stops, RAY_UNLIMITED_LENGTH to only stop at walls
+ * @param crossedCells 		the array of RAY_MAX_CROSSED_CELLS cells receiving the cells the ray passed through, a cell
+ * 							may be listed twice, NULL to list none
+ * @param numCrossedCells 	receives the number of cells listed, may be NULL if crossedCells is NULL
+ * @return the intersection, with the wall side in the z component
+ */
+Vec3 CastRay(Vec2 playerPosition, Vec2 rayCastedByPlayer, float mapCellSize, const int map[], int mapSize,
+		const unsigned char wallDistances[], float maxRayLength, int crossedCells[], int* numCrossedCells);
+
+/**
+ * Casts the rays within the field of view into a caller-provided array, no memory is allocated.
+ *
+ * @param playerPosition  the vector representing the player position
+ * @param playerDirection the vector representing the direction that the player is facing, this vector is a unit
+ * 						  vector
+ * @param mapCellSize 	  the size of each cell in the map grid
+ * @param map 			  1D array representing the map, each element in the array represents a cell in the map grid
+ * @param mapSize 		  the side length of the square map grid (mapSize * mapSize == map.size())
+ * @param wallDistances   the Chebyshev distance from each cell to the nearest wall, used to skip empty space, NULL to
+ * 						  step one cell at a time
+ * @param fieldOfView 	  the angle in radians
+ * @param numOfRays 	  the number of rays casted by the player within the field of view
+ * @param maxRayLength 	  the length after which the traversal stops
+ * @param intersections   the array of numOfRays intersections to be written
+ * @param crossedCells 	  the array of numOfRays * RAY_MAX_CROSSED_CELLS cells receiving the cells each ray passed
+ * 						  through, starting at i * RAY_MAX_CROSSED_CELLS for ray i, NULL to list none
+ * @param numCrossedCells the array of numOfRays counts receiving the number of cells listed for each ray, may be NULL
+ * 						  if crossedCells is NULL
+ */
+void CastRays(Vec2 playerPosition, Vec2 playerDirection, float mapCellSize, const int map[], int mapSize,
+		const unsigned char wallDistances[], float fieldOfView, int numOfRays, float maxRayLength, Vec3 intersections[],
+		int crossedCells[], int numCrossedCells[]);
+
+/**
+ * Casts the rays [rayBegin, rayEnd) of the numOfRays rays within the field of view, so that disjoint ranges of one view
+ * can be cast by different threads. Every RAY_DIRECTION_ANCHOR_INTERVAL rays the direction is rotated from the player
+ * direction, the rays in between are rotated from their predecessor. The anchors do not depend on the range, so the
+ * result is the same however the rays are split between threads.
+ *
+ * @param playerPosition  the vector representing the player position
+ * @param playerDirection the vector representing the direction that the player is facing, this vector is a unit
+ * 						  vector
+ * @param mapCellSize 	  the size of each cell in the map grid
+ * @param map 			  1D array representing the map, each element in the array represents a cell in the map grid
+ * @param mapSize 		  the side length of the square map grid (mapSize * mapSize == map.size())
+ * @param wallDistances   the Chebyshev distance from each cell to the nearest wall, used to skip empty space, NULL to
+ * 						  step one cell at a time
+ * @param fieldOfView 	  the angle in radians
+ * @param numOfRays 	  the number of rays cast by player within the field of view
+ * @param rayBegin 		  the first ray to be cast
+ * @param rayEnd 		  one past the last ray to be cast
+ * @param maxRayLength 	  the length after which the traversal stops
+ * @param intersections   the array of numOfRays intersections, only [rayBegin, rayEnd) is written
+ * @param crossedCells 	  the array of numOfRays * RAY_MAX_CROSSED_CELLS cells receiving the cells each ray passed
+ * 						  through, starting at i * RAY_MAX_CROSSED_CELLS for ray i, NULL to list none
+ * @param numCrossedCells the array of numOfRays counts receiving the number of cells listed for each ray, may be NULL
+ * 						  if crossedCells is NULL
+ */
+void CastRaysInRange(Vec2 playerPosition, Vec2 playerDirection, float mapCellSize, const int map[], int mapSize,
+		const unsigned char wallDistances[], float fieldOfView, int numOfRays, int rayBegin, int rayEnd,
+		float maxRayLength, Vec3 intersections[], int crossedCells[], int numCrossedCells[]);
+
+/**
+ * Follows a ray that hit a low wall or a window to list the surfaces seen over or through it, from the nearest to the
+ * farthest: the face of the wall, the far edge of its top if it is lower than the eye, then the faces rising above the
+ * cell in front of them, the tops of the walls behind and the faces of the windows, until a full wall, a door panel or
+ * a window past the RAY_MAX_WINDOW_LAYERS first ones stops the ray. The cells entered past the wall that was hit are
+ * appended to the cells listed by CastRay().
+ *
+ * @param playerPosition  the vector representing the player position
+ * @param playerDirection the vector representing the direction that the player is facing, this vector is a unit vector
+ * @param intersection 	  the intersection returned by CastRay() for the ray
+ * @param distance 		  the perpendicular distance of the intersection
+ * @param mapCellSize 	  the size of each cell in the map grid
+ * @param map 			  the map
+ * @param maxRayLength 	  the length after which the ray is no longer followed
+ * @param spans 		  the array of RAY_MAX_SPANS spans to be written
+ * @param crossedCells 	  the array of RAY_MAX_CROSSED_CELLS cells listed for the ray by CastRay(), NULL to list none
+ * @param numCrossedCells the number of cells listed for the ray, updated, may be NULL if crossedCells is NULL
+ * @return the number of spans written, 0 if the ray did not hit a low wall or a window
+ */
+int TraceRaySpans(Vec2 playerPosition, Vec2 playerDirection, Vec3 intersection, float distance, float mapCellSize,
+		const Map* map, float maxRayLength, RaySpan spans[], int crossedCells[], int* numCrossedCells);
+
+/**
+ * Calculates the heights and perpendicular distances used for first-person view rendering into caller-provided
+ * arrays, no memory is allocated.
+ *
+ * @param allIntersections the vectors representing all the intersection points
+ * @param playerPosition   the vector representing the player position
+ * @param playerDirection  the vector representing the direction that the player is facing, this vector is a unit vector
+ * @param numOfRays 	   the number of rays casted by the player within the field of view
+ * @param windowHeight     the height of the first-person view in pixels
+ * @param heights 		   the array receiving the height of each ray, may be NULL
+ * @param distances 	   the array receiving the perpendicular distance of each ray, may be NULL
+ */
+void CalculateRayHeights(const Vec3 allIntersections[], Vec2 playerPosition, Vec2 playerDirection, int numOfRays,
+		float windowHeight, float heights[], float distances[]);
+
 /**
  * Calculates the final intersection between the ray cast by the player and a cell that represents a wall. If first
  * calculates the first horizontal and first vertical intersections, then calculates the euclidean distance between the
@@ -21,12 +174,13 @@
  * @param mapCellSize 		the size of each cell in the map grid
  * @param map 				1D array representing the map, each element in the array represents a cell in the map grid
  * @param mapSize 			the side length of the square map grid (mapSize * mapSize == map.size())
+ * @param maxRayLength 		the length after which the traversal stops, RAY_UNLIMITED_LENGTH to only stop at walls
  * @return the final vector representing the intersection between the ray cast by player and a map cell
  * that represents a wall
  */
 Vec3*
 CalculateFinalIntersection(const Vec3* playerPosition, const Vec3* playerDirection, float mapCellSize, const int map[],
-		int mapSize);
+		int mapSize, float maxRayLength);
 
 /**
  * Calculates all the intersections between the rays cast by the player and the cells that represent walls.
@@ -39,12 +193,14 @@ CalculateFinalIntersection(const Vec3* playerPosition, const Vec3* playerDirecti
  * @param mapSize 			the side length of the square map grid (mapSize * mapSize == map.size())
  * @param fieldOfView 		the angle in radians
  * @param numOfRays 		the number of rays casted by the player within the field of view
+ * @param maxRayLength 		the length after which the traversal stops, walls beyond the fog distance are invisible
+ * 							so the fog distance is passed here
  * @return an array of vector that represents all the intersections between the rays cast by player and the cells
  * that represent walls
  */
 Vec3*
 CalculateIntersections(const Vec3* playerPosition, const Vec3* playerDirection, float mapCellSize, const int map[],
-		int mapSize, float fieldOfView, int numOfRays);
+		int mapSize, float fieldOfView, int numOfRays, float maxRayLength);
 
 /**
 * Calculates the all the heights used for first-person view rendering based on the length of each ray vector.
@@ -53,11 +209,12 @@ CalculateIntersections(const Vec3* playerPosition, const Vec3* playerDirection,
  * @param playerPosition   the vector representing the player position
  * @param playerDirection  the vector representing the direction that the player is facing, this vector is a unit vector
  * @param numOfRays 	   the number of rays casted by the player within the field of view
- * @param windowHeight     the height of the SDL window
- * @return an array of float that represents the height used to render the rectangles in the SDL renderer
+ * @param windowHeight     the height of the first-person view in pixels
+ * @param distances 	   the array receiving the perpendicular distance of each ray, may be NULL
+ * @return an array of float that represents the height of each wall column in the first-person view
  */
 float* CalculateHeights(const Vec3* allIntersections, const Vec3* playerPosition, const Vec3* playerDirection,
-		int numOfRays, float windowHeight);
+		int numOfRays, float windowHeight, float* distances);
 
 /**
   * Gets the index of the cell whose wall is pointed by the player's crosshair.
@@ -73,4 +230,26 @@ float* CalculateHeights(const Vec3* allIntersections, const Vec3* playerPosition
 int GetPointedNonWallCellIndex(const Vec3* playerDirectionIntersection, const Vec3* playerDirection,
 		float mapCellSize, int mapSize);
 
+/**
+ * Gets the position of an intersection along the wall it hit, used as the horizontal texture coordinate. Vertical
+ * walls run along the y axis and horizontal walls along the x axis.
+ *
+ * @param intersection the intersection, the z component holds the wall side
+ * @param mapCellSize  the size of each cell in the map grid
+ * @return the offset along the wall in [0, 1)
+ */
+float GetWallHitOffset(const Vec3* intersection, float mapCellSize);
+
+/**
+ * Gets the index of the cell containing an intersection. For an intersection returned by CalculateFinalIntersection()
+ * this is the wall cell that was hit. Intersections of rays that stopped before hitting a wall may lie outside the map
+ * grid, in which case the index is out of range.
+ *
+ * @param intersection the intersection
+ * @param mapCellSize  the size of each cell in the map grid
+ * @param mapSize 	   the side length of the square map grid (mapSize * mapSize == map.size())
+ * @return the index of the cell containing the intersection
+ */
+int GetHitCellIndex(const Vec3* intersection, float mapCellSize, int mapSize);
+
 #endif
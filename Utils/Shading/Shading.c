@@ -0,0 +1,79 @@
+#include <stdlib.h>
+#include "Shading.h"
+#include "../ErrorHandler/ErrorHandler.h"
+#include "../RayCaster/RayCaster.h"
+
+/**
+ * Creates the shading lookup tables.
+ *
+ * @param fogStart 	  the distance at which the fog starts, in world units
+ * @param fogDistance the distance at which surfaces are fully fogged, in world units
+ * @param fogGray 	  the gray value of the fog
+ * @return the shading table
+ */
+ShadingTable* CreateShadingTable(float fogStart, float fogDistance, uint8_t fogGray)
+{
+	ShadingTable* shadingTable = (ShadingTable*)calloc(1, sizeof(ShadingTable));
+	if (shadingTable == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	shadingTable->fogStart = fogStart;
+	shadingTable->fogDistance = fogDistance;
+	shadingTable->levelsPerUnit = (float)(SHADE_DISTANCE_LEVELS - 1) / fogDistance;
+	shadingTable->fogGray = fogGray;
+	const float surfaceLight[SHADE_NUM_SURFACES] = {SHADE_HORIZONTAL_WALL_LIGHT, 1.0f, 1.0f};
+	for (int surface = 0; surface < SHADE_NUM_SURFACES; ++surface)
+	{
+		for (int level = 0; level < SHADE_DISTANCE_LEVELS; ++level)
+		{
+			// Distance at the start of the level, the last level is exactly the fog distance
+			float distance = (float)level / shadingTable->levelsPerUnit;
+			float light = surfaceLight[surface] / (1.0f + SHADE_ATTENUATION * distance);
+			float fog = (distance - fogStart) / (fogDistance - fogStart);
+			fog = fog < 0.0f ? 0.0f : (fog > 1.0f ? 1.0f : fog);
+			for (int value = 0; value < 256; ++value)
+			{
+				float shaded = (float)value * light * (1.0f - fog) + (float)fogGray * fog;
+				shadingTable->colorMap[surface][level][value] = (uint8_t)(shaded + 0.5f);
+			}
+		}
+	}
+	return shadingTable;
+}
+
+/**
+ * Frees the memory allocated for the given shading table.
+ *
+ * @param shadingTable the given shading table
+ */
+void DestroyShadingTable(ShadingTable* shadingTable)
+{
+	if (shadingTable == NULL)
+	{return;}
+	free(shadingTable);
+}
+
+/**
+ * Quantizes a distance into a level of the shading table.
+ *
+ * @param shadingTable the shading table
+ * @param distance 	   the perpendicular distance to the surface
+ * @return the distance level, clamped to the last level at and beyond the fog distance
+ */
+int GetShadeLevel(const ShadingTable* shadingTable, float distance)
+{
+	int level = (int)(distance * shadingTable->levelsPerUnit);
+	if (level < 0)
+	{return 0;}
+	return level < SHADE_DISTANCE_LEVELS ? level : SHADE_DISTANCE_LEVELS - 1;
+}
+
+/**
+ * Gets the surface index of a wall from the side stored in the z component of an intersection.
+ *
+ * @param wallSide HORIZONTAL_WALL or VERTICAL_WALL
+ * @return SHADE_SURFACE_HORIZONTAL or SHADE_SURFACE_VERTICAL
+ */
+int GetWallSurface(float wallSide)
+{
+	return wallSide == HORIZONTAL_WALL ? SHADE_SURFACE_HORIZONTAL : SHADE_SURFACE_VERTICAL;
+}
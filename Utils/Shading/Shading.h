@@ -0,0 +1,95 @@
+#ifndef RAY_CASTING_MAZE_SHADING_H_
+#define RAY_CASTING_MAZE_SHADING_H_
+
+#define SHADE_DISTANCE_LEVELS 64           // number of quantized distance levels in the lookup tables
+#define SHADE_SURFACE_HORIZONTAL 0         // surface index of horizontal walls
+#define SHADE_SURFACE_VERTICAL 1           // surface index of vertical walls
+#define SHADE_SURFACE_FLAT 2               // surface index of the floor and the ceiling
+#define SHADE_NUM_SURFACES 3               // number of surfaces in the lookup tables
+#define SHADE_HORIZONTAL_WALL_LIGHT 0.795f // light factor of horizontal walls relative to vertical walls
+#define SHADE_ATTENUATION 0.004f           // light falloff per world unit, light = 1 / (1 + SHADE_ATTENUATION * d)
+
+#include <stdint.h>
+
+/**
+ * Precomputed lighting tables. The distance to a surface is quantized into SHADE_DISTANCE_LEVELS levels up to the fog
+ * distance, and for every surface and level the color map stores the shaded value of every possible 8-bit channel
+ * value, including distance attenuation and the blend towards the fog color. Shading a pixel therefore costs three
+ * table lookups, and anything at or beyond the fog distance is fully fogged, so rays never need to travel further.
+ */
+typedef struct ShadingTable_struct
+{
+	float fogStart;       // distance at which the fog starts
+	float fogDistance;    // distance at which surfaces are fully fogged, also the maximum useful ray length
+	float levelsPerUnit;  // quantized distance levels per world unit
+	uint8_t fogGray;      // gray value of the fog
+	uint8_t colorMap[SHADE_NUM_SURFACES][SHADE_DISTANCE_LEVELS][256]; // shaded channel values
+} ShadingTable;
+
+/**
+ * Creates the shading lookup tables.
+ *
+ * @param fogStart 	  the distance at which the fog starts, in world units
+ * @param fogDistance the distance at which surfaces are fully fogged, in world units
+ * @param fogGray 	  the gray value of the fog
+ * @return the shading table
+ */
+ShadingTable* CreateShadingTable(float fogStart, float fogDistance, uint8_t fogGray);
+
+/**
+ * Frees the memory allocated for the given shading table.
+ *
+ * @param shadingTable the given shading table
+ */
+void DestroyShadingTable(ShadingTable* shadingTable);
+
+/**
+ * Quantizes a distance into a level of the shading table.
+ *
+ * @param shadingTable the shading table
+ * @param distance 	   the perpendicular distance to the surface
+ * @return the distance level, clamped to the last level at and beyond the fog distance
+ */
+int GetShadeLevel(const ShadingTable* shadingTable, float distance);
+
+/**
+ * Gets the surface index of a wall from the side stored in the z component of an intersection.
+ *
+ * @param wallSide HORIZONTAL_WALL or VERTICAL_WALL
+ * @return SHADE_SURFACE_HORIZONTAL or SHADE_SURFACE_VERTICAL
+ */
+int GetWallSurface(float wallSide);
+
+/**
+ * Shades an opaque ARGB8888 pixel using the color map of one surface and distance level. Defined in the header so the
+ * per-pixel loops of the floor caster and the column renderer can inline it.
+ *
+ * @param colorMap the color map of the surface and distance level
+ * @param pixel    the unshaded pixel
+ * @return the shaded pixel
+ */
+static inline uint32_t ShadePixel(const uint8_t colorMap[256], uint32_t pixel)
+{
+	return 0xFF000000u | ((uint32_t)colorMap[(pixel >> 16) & 0xFFu] << 16) |
+			((uint32_t)colorMap[(pixel >> 8) & 0xFFu] << 8) | (uint32_t)colorMap[pixel & 0xFFu];
+}
+
+/**
+ * Blends a translucent pixel over an opaque one. The red and blue channels are blended together in one product, which
+ * has room for the carries of both.
+ *
+ * @param background the opaque ARGB8888 pixel behind
+ * @param foreground the ARGB8888 pixel in front, its own alpha is ignored
+ * @param alpha 	 the opacity of the pixel in front, from 0 to 255
+ * @return the opaque blended pixel
+ */
+static inline uint32_t BlendPixel(uint32_t background, uint32_t foreground, uint32_t alpha)
+{
+	// Scales the alpha to [0, 256], so a shift replaces the division by 255
+	uint32_t weight = alpha + (alpha >> 7);
+	uint32_t redBlue = ((foreground & 0x00FF00FFu) * weight + (background & 0x00FF00FFu) * (256u - weight)) >> 8;
+	uint32_t green = ((foreground & 0x0000FF00u) * weight + (background & 0x0000FF00u) * (256u - weight)) >> 8;
+	return 0xFF000000u | (redBlue & 0x00FF00FFu) | (green & 0x0000FF00u);
+}
+
+#endif
@@ -0,0 +1,208 @@
+#include <stdlib.h>
+#include <math.h>
+#include "SpatialHash.h"
+#include "../ErrorHandler/ErrorHandler.h"
+#include "../Assert/Assert.h"
+
+/**
+ * Creates an empty spatial hash.
+ *
+ * @param gridSize the side length of the square grid in cells
+ * @param cellSize the size of each cell
+ * @param capacity the number of items the grid can hold
+ * @return the spatial hash
+ */
+SpatialHash* CreateSpatialHash(int gridSize, float cellSize, int capacity)
+{
+	RCM_ASSERT(gridSize > 0 && cellSize > 0.0f && capacity > 0, INVALID_CONFIGURATION_ERROR);
+	SpatialHash* spatialHash = (SpatialHash*)calloc(1, sizeof(SpatialHash));
+	if (spatialHash == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	spatialHash->gridSize = gridSize;
+	spatialHash->cellSize = cellSize;
+	spatialHash->capacity = capacity;
+	spatialHash->heads = (int*)calloc((size_t)gridSize * (size_t)gridSize, sizeof(int));
+	spatialHash->nodes = (SpatialHashNode*)calloc(capacity, sizeof(SpatialHashNode));
+	if (spatialHash->heads == NULL || spatialHash->nodes == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	ClearSpatialHash(spatialHash);
+	return spatialHash;
+}
+
+/**
+ * Frees the memory allocated for the given spatial hash.
+ *
+ * @param spatialHash the given spatial hash
+ */
+void DestroySpatialHash(SpatialHash* spatialHash)
+{
+	if (spatialHash == NULL)
+	{return;}
+	free(spatialHash->heads);
+	free(spatialHash->nodes);
+	free(spatialHash);
+}
+
+/**
+ * Removes all items of a spatial hash.
+ *
+ * @param spatialHash the spatial hash
+ */
+void ClearSpatialHash(SpatialHash* spatialHash)
+{
+	RCM_ASSERT_NOT_NULL(spatialHash);
+	for (int i = 0; i < spatialHash->gridSize * spatialHash->gridSize; ++i)
+	{spatialHash->heads[i] = SPATIAL_HASH_NONE;}
+	for (int i = 0; i < spatialHash->capacity; ++i)
+	{spatialHash->nodes[i].cell = SPATIAL_HASH_NONE;}
+	spatialHash->numItems = 0;
+}
+
+/**
+ * Gets the row or column of the grid containing a coordinate, clamped to the grid.
+ *
+ * @param spatialHash the spatial hash
+ * @param coordinate  the x or y coordinate
+ * @return the row or column
+ */
+static int GetSpatialHashLine(const SpatialHash* spatialHash, float coordinate)
+{
+	float line = floorf(coordinate / spatialHash->cellSize);
+	if (line < 0.0f)
+	{return 0;}
+	if (line >= (float)spatialHash->gridSize)
+	{return spatialHash->gridSize - 1;}
+	return (int)line;
+}
+
+/**
+ * Gets the cell of the grid containing a position. Positions outside the grid are clamped to its border cells.
+ *
+ * @param spatialHash the spatial hash
+ * @param position 	  the position
+ * @return the index of the cell
+ */
+int GetSpatialHashCell(const SpatialHash* spatialHash, Vec2 position)
+{
+	RCM_ASSERT_NOT_NULL(spatialHash);
+	return GetSpatialHashLine(spatialHash, position.y) * spatialHash->gridSize +
+			GetSpatialHashLine(spatialHash, position.x);
+}
+
+/**
+ * Links an item at the head of a cell.
+ *
+ * @param spatialHash the spatial hash
+ * @param item 		  the index of the item
+ * @param cell 		  the index of the cell
+ */
+static void LinkSpatialHashItem(SpatialHash* spatialHash, int item, int cell)
+{
+	SpatialHashNode* node = &spatialHash->nodes[item];
+	node->cell = cell;
+	node->prev = SPATIAL_HASH_NONE;
+	node->next = spatialHash->heads[cell];
+	if (node->next != SPATIAL_HASH_NONE)
+	{spatialHash->nodes[node->next].prev = item;}
+	spatialHash->heads[cell] = item;
+}
+
+/**
+ * Unlinks an item from its cell.
+ *
+ * @param spatialHash the spatial hash
+ * @param item 		  the index of the item
+ */
+static void UnlinkSpatialHashItem(SpatialHash* spatialHash, int item)
+{
+	SpatialHashNode* node = &spatialHash->nodes[item];
+	if (node->prev != SPATIAL_HASH_NONE)
+	{spatialHash->nodes[node->prev].next = node->next;}
+	else
+	{spatialHash->heads[node->cell] = node->next;}
+	if (node->next != SPATIAL_HASH_NONE)
+	{spatialHash->nodes[node->next].prev = node->prev;}
+	node->cell = SPATIAL_HASH_NONE;
+}
+
+/**
+ * Inserts an item into the cell containing its position.
+ *
+ * @param spatialHash the spatial hash
+ * @param item 		  the index of the item, must not be in the grid
+ * @param position 	  the position of the item
+ */
+void InsertSpatialHashItem(SpatialHash* spatialHash, int item, Vec2 position)
+{
+	RCM_ASSERT_NOT_NULL(spatialHash);
+	RCM_ASSERT(item >= 0 && item < spatialHash->capacity, INVALID_CONFIGURATION_ERROR);
+	RCM_ASSERT(spatialHash->nodes[item].cell == SPATIAL_HASH_NONE, UNKNOWN_ERROR);
+	LinkSpatialHashItem(spatialHash, item, GetSpatialHashCell(spatialHash, position));
+	++spatialHash->numItems;
+}
+
+/**
+ * Removes an item from the grid.
+ *
+ * @param spatialHash the spatial hash
+ * @param item 		  the index of the item, must be in the grid
+ */
+void RemoveSpatialHashItem(SpatialHash* spatialHash, int item)
+{
+	RCM_ASSERT_NOT_NULL(spatialHash);
+	RCM_ASSERT(item >= 0 && item < spatialHash->capacity, INVALID_CONFIGURATION_ERROR);
+	RCM_ASSERT(spatialHash->nodes[item].cell != SPATIAL_HASH_NONE, UNKNOWN_ERROR);
+	UnlinkSpatialHashItem(spatialHash, item);
+	--spatialHash->numItems;
+}
+
+/**
+ * Moves an item to the cell containing its new position. Nothing changes while the item stays in its cell.
+ *
+ * @param spatialHash the spatial hash
+ * @param item 		  the index of the item, must be in the grid
+ * @param position 	  the new position of the item
+ */
+void MoveSpatialHashItem(SpatialHash* spatialHash, int item, Vec2 position)
+{
+	RCM_ASSERT_NOT_NULL(spatialHash);
+	RCM_ASSERT(item >= 0 && item < spatialHash->capacity, INVALID_CONFIGURATION_ERROR);
+	RCM_ASSERT(spatialHash->nodes[item].cell != SPATIAL_HASH_NONE, UNKNOWN_ERROR);
+	int cell = GetSpatialHashCell(spatialHash, position);
+	if (cell == spatialHash->nodes[item].cell)
+	{return;}
+	UnlinkSpatialHashItem(spatialHash, item);
+	LinkSpatialHashItem(spatialHash, item, cell);
+}
+
+/**
+ * Lists the items of the cells overlapped by a square box. The items are candidates, the caller tests their exact
+ * extent.
+ *
+ * @param spatialHash the spatial hash
+ * @param center 	  the center of the box
+ * @param size 		  the side length of the box
+ * @param items 	  the array receiving the items
+ * @param maxItems 	  the number of items the array can hold, further items are left out
+ * @return the number of items listed
+ */
+int QuerySpatialHash(const SpatialHash* spatialHash, Vec2 center, float size, int items[], int maxItems)
+{
+	RCM_ASSERT_NOT_NULL(spatialHash);
+	RCM_ASSERT_NOT_NULL(items);
+	int xBegin = GetSpatialHashLine(spatialHash, center.x - size / 2.0f);
+	int xLast = GetSpatialHashLine(spatialHash, center.x + size / 2.0f);
+	int yBegin = GetSpatialHashLine(spatialHash, center.y - size / 2.0f);
+	int yLast = GetSpatialHashLine(spatialHash, center.y + size / 2.0f);
+	int numItems = 0;
+	for (int y = yBegin; y <= yLast; ++y)
+	{
+		for (int x = xBegin; x <= xLast; ++x)
+		{
+			int item = spatialHash->heads[y * spatialHash->gridSize + x];
+			for (; item != SPATIAL_HASH_NONE && numItems < maxItems; item = spatialHash->nodes[item].next)
+			{items[numItems++] = item;}
+		}
+	}
+	return numItems;
+}
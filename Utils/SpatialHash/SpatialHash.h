@@ -0,0 +1,130 @@
+#ifndef RAY_CASTING_MAZE_SPATIALHASH_H_
+#define RAY_CASTING_MAZE_SPATIALHASH_H_
+
+#define SPATIAL_HASH_NONE (-1) // marks the end of a bucket and an item that is not in the grid
+
+#include "../Vec2/Vec2.h"
+
+/**
+ * Struct for the bucket node of one item, linking it to the other items of its cell.
+ */
+typedef struct SpatialHashNode_struct
+{
+	int cell; // cell the item is in, SPATIAL_HASH_NONE if the item is not in the grid
+	int prev; // previous item of the cell, SPATIAL_HASH_NONE for the first one
+	int next; // next item of the cell, SPATIAL_HASH_NONE for the last one
+} SpatialHashNode;
+
+/**
+ * Struct for a uniform grid of buckets aligned to the cells of the map. Items are identified by an index below the
+ * capacity, such as the index of an entity in its list, and every item has one node in a pool allocated up front, so
+ * insertion, removal and moving an item to another cell take constant time and never allocate. The nodes of a cell
+ * form a doubly linked list starting at the head of the cell.
+ */
+typedef struct SpatialHash_struct
+{
+	int gridSize;           // side length of the square grid in cells
+	float cellSize;         // size of each cell, the same as the map cells
+	int capacity;           // number of items the grid can hold, item indices are in [0, capacity)
+	int numItems;           // number of items in the grid
+	int* heads;             // first item of each cell, SPATIAL_HASH_NONE if the cell is empty
+	SpatialHashNode* nodes; // the node of each item
+} SpatialHash;
+
+/**
+ * Creates an empty spatial hash.
+ *
+ * @param gridSize the side length of the square grid in cells
+ * @param cellSize the size of each cell
+ * @param capacity the number of items the grid can hold
+ * @return the spatial hash
+ */
+SpatialHash* CreateSpatialHash(int gridSize, float cellSize, int capacity);
+
+/**
+ * Frees the memory allocated for the given spatial hash.
+ *
+ * @param spatialHash the given spatial hash
+ */
+void DestroySpatialHash(SpatialHash* spatialHash);
+
+/**
+ * Removes all items of a spatial hash.
+ *
+ * @param spatialHash the spatial hash
+ */
+void ClearSpatialHash(SpatialHash* spatialHash);
+
+/**
+ * Gets the cell of the grid containing a position. Positions outside the grid are clamped to its border cells.
+ *
+ * @param spatialHash the spatial hash
+ * @param position 	  the position
+ * @return the index of the cell
+ */
+int GetSpatialHashCell(const SpatialHash* spatialHash, Vec2 position);
+
+/**
+ * Inserts an item into the cell containing its position.
+ *
+ * @param spatialHash the spatial hash
+ * @param item 		  the index of the item, must not be in the grid
+ * @param position 	  the position of the item
+ */
+void InsertSpatialHashItem(SpatialHash* spatialHash, int item, Vec2 position);
+
+/**
+ * Removes an item from the grid.
+ *
+ * @param spatialHash the spatial hash
+ * @param item 		  the index of the item, must be in the grid
+ */
+void RemoveSpatialHashItem(SpatialHash* spatialHash, int item);
+
+/**
+ * Moves an item to the cell containing its new position. Nothing changes while the item stays in its cell.
+ *
+ * @param spatialHash the spatial hash
+ * @param item 		  the index of the item, must be in the grid
+ * @param position 	  the new position of the item
+ */
+void MoveSpatialHashItem(SpatialHash* spatialHash, int item, Vec2 position);
+
+/**
+ * Lists the items of the cells overlapped by a square box. The items are candidates, the caller tests their exact
+ * extent.
+ *
+ * @param spatialHash the spatial hash
+ * @param center 	  the center of the box
+ * @param size 		  the side length of the box
+ * @param items 	  the array receiving the items
+ * @param maxItems 	  the number of items the array can hold, further items are left out
+ * @return the number of items listed
+ */
+int QuerySpatialHash(const SpatialHash* spatialHash, Vec2 center, float size, int items[], int maxItems);
+
+/**
+ * Gets the first item of a cell. Defined in the header so loops over the items of many cells can inline it.
+ *
+ * @param spatialHash the spatial hash
+ * @param cell 		  the index of the cell
+ * @return the first item, SPATIAL_HASH_NONE if the cell is empty
+ */
+static inline int GetFirstSpatialHashItem(const SpatialHash* spatialHash, int cell)
+{
+	return spatialHash->heads[cell];
+}
+
+/**
+ * Gets the item following an item in its cell.
+ *
+ * @param spatialHash the spatial hash
+ * @param item 		  the index of the item
+ * @return the next item, SPATIAL_HASH_NONE after the last item of the cell
+ */
+static inline int GetNextSpatialHashItem(const SpatialHash* spatialHash, int item)
+{
+	return spatialHash->nodes[item].next;
+}
+
+#endif
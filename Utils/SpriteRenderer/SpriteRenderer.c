@@ -0,0 +1,205 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <math.h>
+#include "SpriteRenderer.h"
+#include "../Comparator/Comparator.h"
+#include "../ErrorHandler/ErrorHandler.h"
+#include "../Assert/Assert.h"
+
+/**
+ * Empties the projected sprites of a sprite render frame and makes room for the given number of sprites. The array is
+ * only reallocated when it is too small.
+ *
+ * @param spriteRenderFrame the sprite render frame
+ * @param maxSprites 		the number of sprites that may be projected
+ */
+void ReserveSprites(SpriteRenderFrame* spriteRenderFrame, int maxSprites)
+{
+	RCM_ASSERT_NOT_NULL(spriteRenderFrame);
+	if (maxSprites > spriteRenderFrame->capacity)
+	{
+		free(spriteRenderFrame->sprites);
+		spriteRenderFrame->sprites = (ProjectedSprite*)calloc(maxSprites, sizeof(ProjectedSprite));
+		if (spriteRenderFrame->sprites == NULL)
+		{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+		spriteRenderFrame->capacity = maxSprites;
+	}
+	spriteRenderFrame->numSprites = 0;
+}
+
+/**
+ * Frees the projected sprites of a sprite render frame.
+ *
+ * @param spriteRenderFrame the sprite render frame
+ */
+void ReleaseSprites(SpriteRenderFrame* spriteRenderFrame)
+{
+	if (spriteRenderFrame == NULL)
+	{return;}
+	free(spriteRenderFrame->sprites);
+	spriteRenderFrame->sprites = NULL;
+	spriteRenderFrame->numSprites = 0;
+	spriteRenderFrame->capacity = 0;
+}
+
+/**
+ * Projects a billboard sprite standing on the floor into the frame buffer. The horizontal position follows the angle
+ * of the sprite from the camera direction, the same way rays are spread over the field of view. Sprites behind the
+ * camera, beyond the fog distance or outside the frame buffer are skipped.
+ *
+ * @param spriteRenderFrame the sprite render frame, with room for one more sprite
+ * @param cameraPosition 	the position of the camera
+ * @param cameraDirection 	the direction of the camera, this vector is a unit vector
+ * @param position 			the position of the sprite
+ * @param texture 			the index of the sprite texture
+ * @param scale 			the size of the sprite relative to a wall face at the same distance
+ */
+void ProjectSprite(SpriteRenderFrame* spriteRenderFrame, Vec2 cameraPosition, Vec2 cameraDirection, Vec2 position,
+		int texture, float scale)
+{
+	RCM_ASSERT_NOT_NULL(spriteRenderFrame);
+	RCM_ASSERT(spriteRenderFrame->numSprites < spriteRenderFrame->capacity, INVALID_CONFIGURATION_ERROR);
+	float dx = position.x - cameraPosition.x;
+	float dy = position.y - cameraPosition.y;
+	// Perpendicular distance, the same measure as the wall distances of the rays
+	float depth = cameraDirection.x * dx + cameraDirection.y * dy;
+	if (depth < SPRITE_MIN_DEPTH || depth >= spriteRenderFrame->shadingTable->fogDistance)
+	{return;}
+
+	const float width = (float)spriteRenderFrame->target->width;
+	const float height = (float)spriteRenderFrame->target->height;
+	const float columnsPerRay = width / (float)spriteRenderFrame->numRays;
+	const float angleIncrement = spriteRenderFrame->fieldOfView / (float)spriteRenderFrame->numRays;
+	// Ray i points at -fieldOfView / 2 + (i + 1) * angleIncrement, so this is the fractional ray through the sprite
+	float angle = atan2f(cameraDirection.x * dy - cameraDirection.y * dx, depth);
+	float center = ((angle + spriteRenderFrame->fieldOfView / 2.0f) / angleIncrement - 0.5f) * columnsPerRay;
+	float halfAngle = atanf(0.5f * scale * spriteRenderFrame->mapCellSize / sqrtf(dx * dx + dy * dy));
+	float halfWidth = halfAngle / angleIncrement * columnsPerRay;
+	if (center + halfWidth <= 0.0f || center - halfWidth >= width)
+	{return;}
+
+	// The sprite stands on the floor, whose edge is the bottom of a wall at the same distance
+	float wallHeight = RAY_HEIGHT_COEFFICIENT * height / depth;
+	float spriteHeight = scale * wallHeight;
+	ProjectedSprite* sprite = &spriteRenderFrame->sprites[spriteRenderFrame->numSprites++];
+	sprite->depth = depth;
+	sprite->left = center - halfWidth;
+	sprite->width = 2.0f * halfWidth;
+	sprite->top = (height + wallHeight) / 2.0f - spriteHeight;
+	sprite->height = spriteHeight;
+	sprite->texture = texture;
+}
+
+/**
+ * Orders projected sprites from the farthest to the nearest, used with qsort().
+ *
+ * @param a the first projected sprite
+ * @param b the second projected sprite
+ * @return a negative value if the first sprite is farther, a positive value if it is nearer, 0 otherwise
+ */
+static int CompareSpriteDepths(const void* a, const void* b)
+{
+	return CompareFloats(((const ProjectedSprite*)b)->depth, ((const ProjectedSprite*)a)->depth);
+}
+
+/**
+ * Sorts the projected sprites from the farthest to the nearest, so nearer sprites are drawn over farther ones.
+ *
+ * @param spriteRenderFrame the sprite render frame
+ */
+void SortSprites(SpriteRenderFrame* spriteRenderFrame)
+{
+	RCM_ASSERT_NOT_NULL(spriteRenderFrame);
+	if (spriteRenderFrame->numSprites > 1)
+	{
+		qsort(spriteRenderFrame->sprites, (size_t)spriteRenderFrame->numSprites, sizeof(ProjectedSprite),
+				CompareSpriteDepths);
+	}
+}
+
+/**
+ * Gets the rows of a frame buffer column seen over low walls that a sprite at the given depth may be drawn in: the
+ * rows above every surface in front of the sprite.
+ *
+ * @param spans 	  the spans of the ray of the column, from the nearest to the farthest
+ * @param numSpans 	  the number of spans
+ * @param depth 	  the perpendicular distance of the sprite
+ * @param frameHeight the height of the frame buffer
+ * @return one past the last row the sprite may be drawn in, 0 if a full wall, a window or a door hides the sprite
+ */
+static int GetSpriteClipRow(const RaySpan spans[], int numSpans, float depth, float frameHeight)
+{
+	float clipRow = frameHeight;
+	for (int i = 0; i < numSpans && spans[i].distance < depth; ++i)
+	{
+		if (!spans[i].isTop && spans[i].topHeight >= 1.0f)
+		{return 0;}
+		float top = GetWallRow(spans[i].topHeight, spans[i].distance, frameHeight);
+		if (top < clipRow)
+		{clipRow = top;}
+	}
+	return clipRow <= 0.0f ? 0 : (int)ceilf(clipRow);
+}
+
+/**
+ * Draws the projected sprites over the frame buffer columns [columnBegin, columnEnd). Sprite texels are drawn where
+ * they are opaque and the sprite is nearer than the wall of the column. In a column seen over low walls, the sprite
+ * is drawn above the rows covered by the walls in front of it. A window hides the sprites behind it, which would
+ * otherwise be drawn over the window composited in front of them. Disjoint column ranges can be drawn concurrently,
+ * the signature matches WorkerTask.
+ *
+ * @param columnBegin 		the first frame buffer column
+ * @param columnEnd 		one past the last frame buffer column
+ * @param spriteRenderFrame the sprite render frame, passed as void* so the function can be used as a WorkerTask
+ */
+void DrawSpriteColumns(int columnBegin, int columnEnd, void* spriteRenderFrame)
+{
+	const SpriteRenderFrame* frame = (const SpriteRenderFrame*)spriteRenderFrame;
+	const int width = frame->target->width;
+	const int height = frame->target->height;
+	uint32_t* pixels = frame->target->pixels;
+	for (int i = 0; i < frame->numSprites; ++i)
+	{
+		const ProjectedSprite* sprite = &frame->sprites[i];
+		int xBegin = sprite->left > (float)columnBegin ? (int)ceilf(sprite->left) : columnBegin;
+		int xEnd = sprite->left + sprite->width < (float)columnEnd ? (int)ceilf(sprite->left + sprite->width) :
+				columnEnd;
+		if (xBegin >= xEnd)
+		{continue;}
+		int yBegin = sprite->top > 0.0f ? (int)ceilf(sprite->top) : 0;
+		int yEnd = sprite->top + sprite->height < (float)height ? (int)ceilf(sprite->top + sprite->height) : height;
+
+		int mipLevel = SelectMipLevel(sprite->height);
+		int mipSize = TEXTURE_SIZE >> mipLevel;
+		const uint8_t* colorMap = frame->shadingTable->colorMap[SHADE_SURFACE_VERTICAL]
+				[GetShadeLevel(frame->shadingTable, sprite->depth)];
+		float textureStep = (float)mipSize / sprite->height;
+		float textureYBegin = ((float)yBegin + 0.5f - sprite->top) * textureStep;
+		for (int x = xBegin; x < xEnd; ++x)
+		{
+			// The wall distances are the depth buffer, one entry per ray
+			int ray = (int)((long long)x * frame->numRays / width);
+			int yClip = yEnd;
+			if (frame->numSpans != NULL && frame->numSpans[ray] > 0)
+			{
+				int clipRow = GetSpriteClipRow(frame->spans + (size_t)ray * RAY_MAX_SPANS, frame->numSpans[ray],
+						sprite->depth, (float)height);
+				yClip = clipRow < yEnd ? clipRow : yEnd;
+			}
+			else if (frame->distances[ray] <= sprite->depth)
+			{continue;}
+			const uint32_t* textureColumn = GetTextureColumn(frame->atlas, sprite->texture, mipLevel,
+					((float)x + 0.5f - sprite->left) / sprite->width);
+			float textureY = textureYBegin;
+			uint32_t* pixel = pixels + (size_t)yBegin * width + x;
+			for (int y = yBegin; y < yClip; ++y)
+			{
+				uint32_t texel = textureColumn[(int)textureY & (mipSize - 1)];
+				if (texel >> 24 != 0)
+				{*pixel = ShadePixel(colorMap, texel);}
+				pixel += width;
+				textureY += textureStep;
+			}
+		}
+	}
+}
@@ -0,0 +1,97 @@
+#ifndef RAY_CASTING_MAZE_SPRITERENDERER_H_
+#define RAY_CASTING_MAZE_SPRITERENDERER_H_
+
+#define SPRITE_MIN_DEPTH 1.0f // sprites closer than this to the camera plane are not drawn
+
+#include "../Vec2/Vec2.h"
+#include "../FrameBuffer/FrameBuffer.h"
+#include "../Shading/Shading.h"
+#include "../TextureAtlas/TextureAtlas.h"
+#include "../RayCaster/RayCaster.h"
+
+/**
+ * Struct for a sprite projected into the frame buffer of one camera.
+ */
+typedef struct ProjectedSprite_struct
+{
+	float depth;  // perpendicular distance from the camera, compared against the wall distance of each column
+	float left;   // left edge in frame buffer columns, may lie outside the frame buffer
+	float width;  // width in frame buffer columns
+	float top;    // top edge in frame buffer rows, may lie outside the frame buffer
+	float height; // unclipped height in frame buffer rows
+	int texture;  // index of the sprite texture
+} ProjectedSprite;
+
+/**
+ * Everything needed to draw the sprites of one frame. The projected sprites are kept in an array that only grows, so
+ * projecting sprites does not allocate once the array is large enough.
+ */
+typedef struct SpriteRenderFrame_struct
+{
+	FrameBuffer* target;              // frame buffer to be written
+	const float* distances;           // perpendicular distance of each ray, the depth buffer of the walls
+	const RaySpan* spans;             // RAY_MAX_SPANS spans per ray followed past low walls and through windows
+	const int* numSpans;              // number of spans of each ray, 0 for a ray whose wall is its only surface, NULL
+									  // if every wall is full and opaque
+	int numRays;                      // number of rays, frame buffer columns are mapped onto rays
+	float fieldOfView;                // field of view of the camera in radians
+	float mapCellSize;                // size of each cell in the map grid, the width of a sprite of scale 1
+	const TextureAtlas* atlas;        // sprite textures
+	const ShadingTable* shadingTable; // lighting and fog lookup tables
+	ProjectedSprite* sprites;         // the projected sprites, from the farthest to the nearest once sorted
+	int numSprites;                   // number of projected sprites
+	int capacity;                     // number of sprites the array can hold
+} SpriteRenderFrame;
+
+/**
+ * Empties the projected sprites of a sprite render frame and makes room for the given number of sprites. The array is
+ * only reallocated when it is too small.
+ *
+ * @param spriteRenderFrame the sprite render frame
+ * @param maxSprites 		the number of sprites that may be projected
+ */
+void ReserveSprites(SpriteRenderFrame* spriteRenderFrame, int maxSprites);
+
+/**
+ * Frees the projected sprites of a sprite render frame.
+ *
+ * @param spriteRenderFrame the sprite render frame
+ */
+void ReleaseSprites(SpriteRenderFrame* spriteRenderFrame);
+
+/**
+ * Projects a billboard sprite standing on the floor into the frame buffer. The horizontal position follows the angle
+ * of the sprite from the camera direction, the same way rays are spread over the field of view. Sprites behind the
+ * camera, beyond the fog distance or outside the frame buffer are skipped.
+ *
+ * @param spriteRenderFrame the sprite render frame, with room for one more sprite
+ * @param cameraPosition 	the position of the camera
+ * @param cameraDirection 	the direction of the camera, this vector is a unit vector
+ * @param position 			the position of the sprite
+ * @param texture 			the index of the sprite texture
+ * @param scale 			the size of the sprite relative to a wall face at the same distance
+ */
+void ProjectSprite(SpriteRenderFrame* spriteRenderFrame, Vec2 cameraPosition, Vec2 cameraDirection, Vec2 position,
+		int texture, float scale);
+
+/**
+ * Sorts the projected sprites from the farthest to the nearest, so nearer sprites are drawn over farther ones.
+ *
+ * @param spriteRenderFrame the sprite render frame
+ */
+void SortSprites(SpriteRenderFrame* spriteRenderFrame);
+
+/**
+ * Draws the projected sprites over the frame buffer columns [columnBegin, columnEnd). Sprite texels are drawn where
+ * they are opaque and the sprite is nearer than the wall of the column. In a column seen over low walls, the sprite
+ * is drawn above the rows covered by the walls in front of it. A window hides the sprites behind it, which would
+ * otherwise be drawn over the window composited in front of them. Disjoint column ranges can be drawn concurrently,
+ * the signature matches WorkerTask.
+ *
+ * @param columnBegin 		the first frame buffer column
+ * @param columnEnd 		one past the last frame buffer column
+ * @param spriteRenderFrame the sprite render frame, passed as void* so the function can be used as a WorkerTask
+ */
+void DrawSpriteColumns(int columnBegin, int columnEnd, void* spriteRenderFrame);
+
+#endif
@@ -1,7 +1,9 @@
 #include <stdlib.h>
+#include <stdint.h>
 #include <stdio.h>
 #include "Stack.h"
 #include "../ErrorHandler/ErrorHandler.h"
+#include "../Assert/Assert.h"
 
 /**
  * Creates an empty stack of integer.
@@ -27,7 +29,7 @@ Stack* CreateStack()
 void DestroyStack(Stack* stack)
 {
 	if (stack == NULL)
-	{ ErrorHandler(ACCESSING_NULL_POINTER_ERROR); }
+	{return;}
 	free(stack->array);
 	free(stack);
 }
@@ -40,8 +42,7 @@ void DestroyStack(Stack* stack)
  */
 int IsEmpty(Stack* stack)
 {
-	if (stack == NULL)
-	{ ErrorHandler(ACCESSING_NULL_POINTER_ERROR); }
+	RCM_ASSERT_NOT_NULL(stack);
 	return stack->length == 0;
 }
 
@@ -53,8 +54,7 @@ int IsEmpty(Stack* stack)
  */
 int IsFull(Stack* stack)
 {
-	if (stack == NULL)
-	{ ErrorHandler(ACCESSING_NULL_POINTER_ERROR); }
+	RCM_ASSERT_NOT_NULL(stack);
 	return stack->length == stack->size;
 }
 
@@ -66,8 +66,7 @@ int IsFull(Stack* stack)
  */
 void Resize(Stack* stack)
 {
-	if (stack == NULL)
-	{ ErrorHandler(ACCESSING_NULL_POINTER_ERROR); }
+	RCM_ASSERT_NOT_NULL(stack);
 	int* newArray = (int*)calloc((stack->size) * RESIZE_FACTOR, sizeof(int));
 	for (int i = 0; i < stack->length; ++i)
 	{ newArray[i] = (stack->array)[i]; }
@@ -84,8 +83,7 @@ void Resize(Stack* stack)
  */
 void Push(Stack* stack, int num)
 {
-	if (stack == NULL)
-	{ ErrorHandler(ACCESSING_NULL_POINTER_ERROR); }
+	RCM_ASSERT_NOT_NULL(stack);
 	// Resizes the stack if necessary
 	if (IsFull(stack))
 	{ Resize(stack); }
@@ -100,8 +98,7 @@ void Push(Stack* stack, int num)
  */
 void Pop(Stack* stack)
 {
-	if (stack == NULL)
-	{ ErrorHandler(ACCESSING_NULL_POINTER_ERROR); }
+	RCM_ASSERT_NOT_NULL(stack);
 	if (!IsEmpty(stack))
 	{ (stack->array)[--(stack->length)] = 0; }
 	else
@@ -0,0 +1,303 @@
+#include <SDL.h>
+#include "TextureAtlas.h"
+#include "../ErrorHandler/ErrorHandler.h"
+
+/**
+ * Generates a brick texture at mip level 0, used when a texture file can not be loaded.
+ *
+ * @param columns the TEXTURE_SIZE * TEXTURE_SIZE column-major texels to be written
+ */
+static void GenerateFallbackTexture(uint32_t* columns)
+{
+	for (int x = 0; x < TEXTURE_SIZE; ++x)
+	{
+		for (int y = 0; y < TEXTURE_SIZE; ++y)
+		{
+			int rowOffset = (y / (TEXTURE_SIZE / 4)) % 2 ? TEXTURE_SIZE / 4 : 0;
+			int isMortar = y % (TEXTURE_SIZE / 4) == 0 || (x + rowOffset) % (TEXTURE_SIZE / 2) == 0;
+			columns[x * TEXTURE_SIZE + y] = isMortar ? 0xFF969696u : 0xFF963E30u;
+		}
+	}
+}
+
+/**
+ * Loads a BMP file and writes it column-major into mip level 0 of a texture. Images of a different size are resampled
+ * with nearest-neighbor filtering.
+ *
+ * @param path    the path of the BMP file
+ * @param columns the TEXTURE_SIZE * TEXTURE_SIZE column-major texels to be written
+ * @return 1 if the file was loaded, 0 otherwise
+ */
+static int LoadTextureFile(const char* path, uint32_t* columns)
+{
+	SDL_Surface* loaded = SDL_LoadBMP(path);
+	if (loaded == NULL)
+	{return 0;}
+	SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+	SDL_FreeSurface(loaded);
+	if (converted == NULL)
+	{return 0;}
+	SDL_LockSurface(converted);
+	for (int x = 0; x < TEXTURE_SIZE; ++x)
+	{
+		int sourceX = x * converted->w / TEXTURE_SIZE;
+		for (int y = 0; y < TEXTURE_SIZE; ++y)
+		{
+			int sourceY = y * converted->h / TEXTURE_SIZE;
+			const Uint8* sourceRow = (const Uint8*)converted->pixels + sourceY * converted->pitch;
+			columns[x * TEXTURE_SIZE + y] = ((const Uint32*)sourceRow)[sourceX] | 0xFF000000u;
+		}
+	}
+	SDL_UnlockSurface(converted);
+	SDL_FreeSurface(converted);
+	return 1;
+}
+
+/**
+ * Generates a sprite texture at mip level 0. The shapes stand on the bottom edge of the texture, everything around
+ * them is transparent. The door texture is opaque, its left edge is the edge of the panel that slides into the wall.
+ * The window and grate textures cover the whole face of a wall, the panes of the window are translucent and the gaps
+ * of the grate are transparent.
+ *
+ * @param texture the SPRITE_TEXTURE_* index of the texture
+ * @param columns the TEXTURE_SIZE * TEXTURE_SIZE column-major texels to be written
+ */
+static void GenerateSpriteTexture(int texture, uint32_t* columns)
+{
+	const int half = TEXTURE_SIZE / 2;
+	for (int x = 0; x < TEXTURE_SIZE; ++x)
+	{
+		for (int y = 0; y < TEXTURE_SIZE; ++y)
+		{
+			int dx = x - half;
+			uint32_t texel = 0x00000000u;
+			if (texture == SPRITE_TEXTURE_DOOR)
+			{
+				// Vertical planks in a dark frame, with a handle near the leading edge
+				int isFrame = x < TEXTURE_SIZE / 16 || x >= TEXTURE_SIZE - TEXTURE_SIZE / 16 || y < TEXTURE_SIZE / 16 ||
+						y >= TEXTURE_SIZE - TEXTURE_SIZE / 16;
+				int isSeam = x % (TEXTURE_SIZE / 4) == 0;
+				int isHandle = abs(x - TEXTURE_SIZE / 8) < TEXTURE_SIZE / 32 + 1 && abs(y - half) < TEXTURE_SIZE / 16;
+				texel = isHandle ? 0xFFC8B060u : isFrame ? 0xFF3A2818u : isSeam ? 0xFF5A3E22u : 0xFF7A5630u;
+			}
+			else if (texture == SPRITE_TEXTURE_WINDOW)
+			{
+				// Four tinted panes in a metal frame, with a brighter streak of reflected light across them
+				int isFrame = x < TEXTURE_SIZE / 16 || x >= TEXTURE_SIZE - TEXTURE_SIZE / 16 || y < TEXTURE_SIZE / 16 ||
+						y >= TEXTURE_SIZE - TEXTURE_SIZE / 16 || abs(x - half) < TEXTURE_SIZE / 32 ||
+						abs(y - half) < TEXTURE_SIZE / 32;
+				int isStreak = ((x + y) / (TEXTURE_SIZE / 16)) % 6 == 0;
+				texel = isFrame ? 0xFF40444Cu : isStreak ? 0x80D8F0F8u : 0x4890C0D0u;
+			}
+			else if (texture == SPRITE_TEXTURE_GRATE)
+			{
+				// Vertical bars held by a frame and two cross bars, open in between
+				int isFrame = x < TEXTURE_SIZE / 16 || x >= TEXTURE_SIZE - TEXTURE_SIZE / 16 || y < TEXTURE_SIZE / 16 ||
+						y >= TEXTURE_SIZE - TEXTURE_SIZE / 16;
+				int isBar = x % (TEXTURE_SIZE / 8) < TEXTURE_SIZE / 32 ||
+						abs(y % (TEXTURE_SIZE / 3) - TEXTURE_SIZE / 6) < TEXTURE_SIZE / 64 + 1;
+				if (isFrame || isBar)
+				{texel = isFrame ? 0xFF3A302Au : 0xFF5C4A3Eu;}
+			}
+			else if (texture == SPRITE_TEXTURE_GEM)
+			{
+				// A diamond in the lower half, lit from the top left
+				int dy = y - TEXTURE_SIZE * 3 / 4;
+				int radius = TEXTURE_SIZE / 5;
+				if (abs(dx) + abs(dy) <= radius)
+				{texel = dx + dy < 0 ? 0xFF7FF0FFu : 0xFF1FA8C8u;}
+			}
+			else
+			{
+				// A round head on a body with a wavy hem and two dark eyes
+				int dy = y - half + TEXTURE_SIZE / 8;
+				int radius = TEXTURE_SIZE * 3 / 8;
+				int isHead = dx * dx + dy * dy <= radius * radius && dy <= 0;
+				int hem = TEXTURE_SIZE - 2 - ((x / (TEXTURE_SIZE / 8)) % 2) * (TEXTURE_SIZE / 16);
+				int isBody = abs(dx) <= radius && dy > 0 && y < hem;
+				int isEye = (abs(dx - TEXTURE_SIZE / 8) < TEXTURE_SIZE / 16 || abs(dx + TEXTURE_SIZE / 8) <
+						TEXTURE_SIZE / 16) && abs(dy + TEXTURE_SIZE / 16) < TEXTURE_SIZE / 12;
+				if (isHead || isBody)
+				{texel = isEye ? 0xFF202040u : 0xFFE8E8F0u;}
+			}
+			columns[x * TEXTURE_SIZE + y] = texel;
+		}
+	}
+}
+
+/**
+ * Averages four ARGB8888 texels channel by channel. Transparent texels are left out, the result is transparent when
+ * fewer than two of the texels are visible, so the outline of a sprite stays sharp at every mip level. The alpha of the
+ * visible texels is averaged as well, which keeps opaque texels opaque and translucent ones translucent.
+ *
+ * @param a the first texel
+ * @param b the second texel
+ * @param c the third texel
+ * @param d the fourth texel
+ * @return the averaged texel
+ */
+static uint32_t AverageTexels(uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+{
+	const uint32_t texels[4] = {a, b, c, d};
+	uint32_t sums[4] = {0, 0, 0, 0};
+	uint32_t numVisible = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		if ((texels[i] >> 24) == 0)
+		{continue;}
+		++numVisible;
+		for (int channel = 0; channel < 4; ++channel)
+		{sums[channel] += (texels[i] >> (8 * channel)) & 0xFFu;}
+	}
+	if (numVisible < 2)
+	{return 0x00000000u;}
+	uint32_t result = 0;
+	for (int channel = 0; channel < 4; ++channel)
+	{result |= ((sums[channel] + numVisible / 2) / numVisible) << (8 * channel);}
+	return result;
+}
+
+/**
+ * Builds mip levels 1 to TEXTURE_MIP_LEVELS - 1 of a texture with a 2x2 box filter.
+ *
+ * @param atlas   the texture atlas
+ * @param texture the texture index
+ */
+static void BuildMipLevels(TextureAtlas* atlas, int texture)
+{
+	for (int level = 1; level < TEXTURE_MIP_LEVELS; ++level)
+	{
+		const uint32_t* source = atlas->texels + atlas->mipOffsets[texture * TEXTURE_MIP_LEVELS + level - 1];
+		uint32_t* destination = atlas->texels + atlas->mipOffsets[texture * TEXTURE_MIP_LEVELS + level];
+		int sourceSize = TEXTURE_SIZE >> (level - 1);
+		int size = TEXTURE_SIZE >> level;
+		for (int x = 0; x < size; ++x)
+		{
+			const uint32_t* left = source + (2 * x) * sourceSize;
+			const uint32_t* right = source + (2 * x + 1) * sourceSize;
+			for (int y = 0; y < size; ++y)
+			{
+				destination[x * size + y] = AverageTexels(left[2 * y], left[2 * y + 1], right[2 * y],
+						right[2 * y + 1]);
+			}
+		}
+	}
+}
+
+/**
+ * Allocates an atlas for the given number of textures with all texels transparent.
+ *
+ * @param numTextures the number of textures
+ * @return the texture atlas
+ */
+static TextureAtlas* AllocateTextureAtlas(int numTextures)
+{
+	TextureAtlas* atlas = (TextureAtlas*)calloc(1, sizeof(TextureAtlas));
+	if (atlas == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	atlas->numTextures = numTextures;
+	atlas->mipOffsets = (int*)calloc(numTextures * TEXTURE_MIP_LEVELS, sizeof(int));
+	if (atlas->mipOffsets == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	// Mip levels of one texture are stored next to each other
+	int totalTexels = 0;
+	for (int texture = 0; texture < numTextures; ++texture)
+	{
+		for (int level = 0; level < TEXTURE_MIP_LEVELS; ++level)
+		{
+			atlas->mipOffsets[texture * TEXTURE_MIP_LEVELS + level] = totalTexels;
+			totalTexels += (TEXTURE_SIZE >> level) * (TEXTURE_SIZE >> level);
+		}
+	}
+	atlas->texels = (uint32_t*)calloc(totalTexels, sizeof(uint32_t));
+	if (atlas->texels == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	return atlas;
+}
+
+/**
+ * Loads wall textures from BMP files into an atlas and builds their mip levels. Textures that can not be loaded are
+ * replaced with a generated brick texture, so the atlas always holds numPaths textures.
+ *
+ * @param paths    the paths of the BMP files
+ * @param numPaths the number of paths
+ * @return the texture atlas
+ */
+TextureAtlas* LoadTextureAtlas(const char* const paths[], int numPaths)
+{
+	if (paths == NULL)
+	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
+	TextureAtlas* atlas = AllocateTextureAtlas(numPaths);
+	for (int texture = 0; texture < numPaths; ++texture)
+	{
+		uint32_t* columns = atlas->texels + atlas->mipOffsets[texture * TEXTURE_MIP_LEVELS];
+		if (!LoadTextureFile(paths[texture], columns))
+		{
+			printf("Texture %s could not be loaded, using a generated texture.\n", paths[texture]);
+			GenerateFallbackTexture(columns);
+		}
+		BuildMipLevels(atlas, texture);
+	}
+	return atlas;
+}
+
+/**
+ * Generates the sprite textures into an atlas and builds their mip levels, the texture indices are the
+ * SPRITE_TEXTURE_* constants.
+ *
+ * @return the texture atlas of SPRITE_TEXTURE_COUNT textures
+ */
+TextureAtlas* CreateSpriteAtlas(void)
+{
+	TextureAtlas* atlas = AllocateTextureAtlas(SPRITE_TEXTURE_COUNT);
+	for (int texture = 0; texture < SPRITE_TEXTURE_COUNT; ++texture)
+	{
+		GenerateSpriteTexture(texture, atlas->texels + atlas->mipOffsets[texture * TEXTURE_MIP_LEVELS]);
+		BuildMipLevels(atlas, texture);
+	}
+	return atlas;
+}
+
+/**
+ * Frees the memory allocated for the given texture atlas.
+ *
+ * @param atlas the given texture atlas
+ */
+void DestroyTextureAtlas(TextureAtlas* atlas)
+{
+	if (atlas == NULL)
+	{return;}
+	free(atlas->texels);
+	free(atlas->mipOffsets);
+	free(atlas);
+}
+
+/**
+ * Selects the mip level for a wall column so that roughly one texel is sampled per pixel.
+ *
+ * @param projectedHeight the unclipped projected height of the wall column in pixels
+ * @return the mip level
+ */
+int SelectMipLevel(float projectedHeight)
+{
+	int level = 0;
+	while (level < TEXTURE_MIP_LEVELS - 1 && (float)(TEXTURE_SIZE >> (level + 1)) >= projectedHeight)
+	{++level;}
+	return level;
+}
+
+/**
+ * Gets the texels of one column of a texture at a mip level.
+ *
+ * @param atlas    the texture atlas
+ * @param texture  the texture index
+ * @param mipLevel the mip level
+ * @param offset   the horizontal texture coordinate in [0, 1)
+ * @return the (TEXTURE_SIZE >> mipLevel) texels of the column, from top to bottom
+ */
+const uint32_t* GetTextureColumn(const TextureAtlas* atlas, int texture, int mipLevel, float offset)
+{
+	int size = TEXTURE_SIZE >> mipLevel;
+	int column = (int)(offset * (float)size) & (size - 1);
+	return atlas->texels + atlas->mipOffsets[texture * TEXTURE_MIP_LEVELS + mipLevel] + column * size;
+}
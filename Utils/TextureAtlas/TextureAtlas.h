@@ -0,0 +1,72 @@
+#ifndef RAY_CASTING_MAZE_TEXTUREATLAS_H_
+#define RAY_CASTING_MAZE_TEXTUREATLAS_H_
+
+#define TEXTURE_SIZE 64         // side length of every wall texture, must be a power of two
+#define TEXTURE_MIP_LEVELS 7    // number of mip levels, from TEXTURE_SIZE down to 1 texel
+#define SPRITE_TEXTURE_GEM 0    // sprite texture of the items
+#define SPRITE_TEXTURE_GHOST 1  // sprite texture of the enemies
+#define SPRITE_TEXTURE_DOOR 2   // opaque texture of the door panels, drawn by the wall renderer
+#define SPRITE_TEXTURE_WINDOW 3 // glazed window texture, translucent, drawn by the wall renderer
+#define SPRITE_TEXTURE_GRATE 4  // iron grate texture with open gaps, drawn by the wall renderer
+#define SPRITE_TEXTURE_COUNT 5  // number of generated sprite textures
+
+#include <stdint.h>
+
+/**
+ * Atlas holding every wall texture and all of their mip levels in one allocation. Texels are stored column-major, so
+ * the texels sampled while drawing one vertical wall column are contiguous in memory. Level m of a texture is
+ * (TEXTURE_SIZE >> m) columns of (TEXTURE_SIZE >> m) texels each. Sprite textures use the same layout, texels with an
+ * alpha of 0 are transparent. Only the window texture has translucent texels, with an alpha between 0 and 255.
+ */
+typedef struct TextureAtlas_struct
+{
+	int numTextures;
+	uint32_t* texels;  // ARGB8888 texels of every texture and mip level, column-major
+	int* mipOffsets;   // offset into texels of level m of texture t, at index t * TEXTURE_MIP_LEVELS + m
+} TextureAtlas;
+
+/**
+ * Loads wall textures from BMP files into an atlas and builds their mip levels. Textures that can not be loaded are
+ * replaced with a generated brick texture, so the atlas always holds numPaths textures.
+ *
+ * @param paths    the paths of the BMP files
+ * @param numPaths the number of paths
+ * @return the texture atlas
+ */
+TextureAtlas* LoadTextureAtlas(const char* const paths[], int numPaths);
+
+/**
+ * Generates the sprite textures into an atlas and builds their mip levels, the texture indices are the
+ * SPRITE_TEXTURE_* constants.
+ *
+ * @return the texture atlas of SPRITE_TEXTURE_COUNT textures
+ */
+TextureAtlas* CreateSpriteAtlas(void);
+
+/**
+ * Frees the memory allocated for the given texture atlas.
+ *
+ * @param atlas the given texture atlas
+ */
+void DestroyTextureAtlas(TextureAtlas* atlas);
+
+/**
+ * Selects the mip level for a wall column so that roughly one texel is sampled per pixel.
+ *
+ * @param projectedHeight the unclipped projected height of the wall column in pixels
+ * @return the mip level
+ */
+int SelectMipLevel(float projectedHeight);
+
+/**
+ * Gets the texels of one column of a texture at a mip level.
+ *
+ * @param atlas    the texture atlas
+ * @param texture  the texture index
+ * @param mipLevel the mip level
+ * @param offset   the horizontal texture coordinate in [0, 1)
+ * @return the (TEXTURE_SIZE >> mipLevel) texels of the column, from top to bottom
+ */
+const uint32_t* GetTextureColumn(const TextureAtlas* atlas, int texture, int mipLevel, float offset);
+
+#endif
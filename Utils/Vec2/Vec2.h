@@ -0,0 +1,240 @@
+#ifndef RAY_CASTING_MAZE_VEC2_H_
+#define RAY_CASTING_MAZE_VEC2_H_
+
+#include <math.h>
+#ifdef RCM_VEC_SSE
+#include <xmmintrin.h>
+#endif
+
+/**
+ * Struct for vector in R2. Vec2 is a value type: every operation takes and returns vectors by value and is defined
+ * inline in this header, so the compiler can keep the components in registers and vectorize loops using them. When
+ * RCM_VEC_SSE is defined the arithmetic is done in the two low lanes of SSE registers, otherwise plain scalar code is
+ * used. Both give the same results bit for bit.
+ */
+typedef struct Vec2_struct
+{
+	float x;
+	float y;
+} Vec2;
+
+/**
+ * Creates a 2D vector.
+ *
+ * @param x the x component of the vector
+ * @param y the y component of the vector
+ * @return the vector
+ */
+static inline Vec2 V2(float x, float y)
+{
+	Vec2 result = {x, y};
+	return result;
+}
+
+#ifdef RCM_VEC_SSE
+/**
+ * Loads a vector into the two low lanes of an SSE register with one 64-bit load, the high lanes are zero.
+ *
+ * @param a the vector
+ * @return the SSE register
+ */
+static inline __m128 V2Load(Vec2 a)
+{
+	return _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&a);
+}
+
+/**
+ * Stores the two low lanes of an SSE register into a vector with one 64-bit store.
+ *
+ * @param a the SSE register
+ * @return the vector
+ */
+static inline Vec2 V2Store(__m128 a)
+{
+	Vec2 result;
+	_mm_storel_pi((__m64*)&result, a);
+	return result;
+}
+#endif
+
+/**
+ * Adds two vectors.
+ *
+ * @param a vector a
+ * @param b vector b
+ * @return a + b
+ */
+static inline Vec2 V2Add(Vec2 a, Vec2 b)
+{
+#ifdef RCM_VEC_SSE
+	return V2Store(_mm_add_ps(V2Load(a), V2Load(b)));
+#else
+	return V2(a.x + b.x, a.y + b.y);
+#endif
+}
+
+/**
+ * Subtracts two vectors.
+ *
+ * @param a vector a
+ * @param b vector b
+ * @return a - b
+ */
+static inline Vec2 V2Sub(Vec2 a, Vec2 b)
+{
+#ifdef RCM_VEC_SSE
+	return V2Store(_mm_sub_ps(V2Load(a), V2Load(b)));
+#else
+	return V2(a.x - b.x, a.y - b.y);
+#endif
+}
+
+/**
+ * Scales a vector.
+ *
+ * @param a 	 the vector
+ * @param scalar the scalar
+ * @return scalar * a
+ */
+static inline Vec2 V2Scale(Vec2 a, float scalar)
+{
+#ifdef RCM_VEC_SSE
+	return V2Store(_mm_mul_ps(V2Load(a), _mm_set1_ps(scalar)));
+#else
+	return V2(a.x * scalar, a.y * scalar);
+#endif
+}
+
+/**
+ * Inverts the direction of a vector.
+ *
+ * @param a the vector
+ * @return -a
+ */
+static inline Vec2 V2Negate(Vec2 a)
+{
+#ifdef RCM_VEC_SSE
+	// Flips the sign bits, which is what the scalar negation does, also for zeros
+	return V2Store(_mm_xor_ps(V2Load(a), _mm_set1_ps(-0.0f)));
+#else
+	return V2(-a.x, -a.y);
+#endif
+}
+
+/**
+ * Calculates the dot product of two vectors.
+ *
+ * @param a vector a
+ * @param b vector b
+ * @return the dot product
+ */
+static inline float V2Dot(Vec2 a, Vec2 b)
+{
+#ifdef RCM_VEC_SSE
+	__m128 product = _mm_mul_ps(V2Load(a), V2Load(b));
+	return _mm_cvtss_f32(_mm_add_ss(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 1, 1, 1))));
+#else
+	return a.x * b.x + a.y * b.y;
+#endif
+}
+
+/**
+ * Rotates a vector by an angle whose cosine and sine are already known, using the rotation matrix:
+ * [[cos(theta), - sin(theta)],
+ *  [sin(theta),   cos(theta)]]
+ * Rotating many vectors by the same angle this way evaluates cosf and sinf only once.
+ *
+ * @param a 		the vector
+ * @param cosAngle  the cosine of the angle
+ * @param sinAngle  the sine of the angle
+ * @return the rotated vector
+ */
+static inline Vec2 V2RotateCosSin(Vec2 a, float cosAngle, float sinAngle)
+{
+#ifdef RCM_VEC_SSE
+	// (x, y) * cos + (y, x) * (-sin, sin), subtracting a product equals adding its negation exactly
+	__m128 xy = V2Load(a);
+	__m128 yx = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(3, 2, 0, 1));
+	__m128 sines = _mm_setr_ps(-sinAngle, sinAngle, 0.0f, 0.0f);
+	return V2Store(_mm_add_ps(_mm_mul_ps(xy, _mm_set1_ps(cosAngle)), _mm_mul_ps(yx, sines)));
+#else
+	return V2(cosAngle * a.x - sinAngle * a.y, sinAngle * a.x + cosAngle * a.y);
+#endif
+}
+
+/**
+ * Rotates a vector by an angle.
+ *
+ * @param a 	the vector
+ * @param angle the angle of rotation, in radians
+ * @return the rotated vector
+ */
+static inline Vec2 V2Rotate(Vec2 a, float angle)
+{
+	return V2RotateCosSin(a, cosf(angle), sinf(angle));
+}
+
+/**
+ * Gets the vector perpendicular to a vector, rotated by 90 degrees in the direction of positive angles.
+ *
+ * @param a the vector
+ * @return the perpendicular vector
+ */
+static inline Vec2 V2Perpendicular(Vec2 a)
+{
+	return V2(-a.y, a.x);
+}
+
+/**
+ * Calculates the length of a vector.
+ *
+ * @param a the vector
+ * @return the length
+ */
+static inline float V2Length(Vec2 a)
+{
+#ifdef RCM_VEC_SSE
+	return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(V2Dot(a, a))));
+#else
+	return sqrtf(a.x * a.x + a.y * a.y);
+#endif
+}
+
+/**
+ * Calculates the euclidean distance between two vectors.
+ *
+ * @param a the first vector
+ * @param b the second vector
+ * @return the euclidean distance
+ */
+static inline float V2Distance(Vec2 a, Vec2 b)
+{
+	return V2Length(V2Sub(a, b));
+}
+
+/**
+ * Calculates the squared euclidean distance between two vectors, which orders distances without a square root.
+ *
+ * @param a the first vector
+ * @param b the second vector
+ * @return the squared euclidean distance
+ */
+static inline float V2DistanceSquared(Vec2 a, Vec2 b)
+{
+	Vec2 d = V2Sub(a, b);
+	return V2Dot(d, d);
+}
+
+/**
+ * Normalizes a vector. Vectors too short to be normalized are returned unchanged.
+ *
+ * @param a the vector
+ * @return the unit vector pointing in the direction of a
+ */
+static inline Vec2 V2Normalize(Vec2 a)
+{
+	float length = V2Length(a);
+	return length > 1e-6f ? V2Scale(a, 1.0f / length) : a;
+}
+
+#endif
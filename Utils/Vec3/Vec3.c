@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include "Vec3.h"
 #include "../ErrorHandler/ErrorHandler.h"
+#include "../Assert/Assert.h"
 #include "../Comparator/Comparator.h"
 
 /**
@@ -33,8 +34,8 @@ Vec3* Vec3D(float x, float y, float z)
  */
 float Dot3D(const Vec3* a, const Vec3* b)
 {
-	if (a == NULL || b == NULL)
-	{ ErrorHandler(ACCESSING_NULL_POINTER_ERROR); }
+	RCM_ASSERT_NOT_NULL(a);
+	RCM_ASSERT_NOT_NULL(b);
 	return (a->x) * (b->x) + (a->y) * (b->y) + (a->z) * (b->z);
 }
 
@@ -46,8 +47,8 @@ float Dot3D(const Vec3* a, const Vec3* b)
  */
 void Translate3D(Vec3* a, const Vec3* b)
 {
-	if (a == NULL || b == NULL)
-	{ ErrorHandler(ACCESSING_NULL_POINTER_ERROR); }
+	RCM_ASSERT_NOT_NULL(a);
+	RCM_ASSERT_NOT_NULL(b);
 	a->x += b->x;
 	a->y += b->y;
 	a->z += b->z;
@@ -65,8 +66,7 @@ void Translate3D(Vec3* a, const Vec3* b)
  */
 void Rotate3D(Vec3* a, float angle)
 {
-	if (a == NULL)
-	{ ErrorHandler(ACCESSING_NULL_POINTER_ERROR); }
+	RCM_ASSERT_NOT_NULL(a);
 	float temp = a->x;
 	a->x = cosf(angle) * temp - sinf(angle) * a->y;
 	a->y = sinf(angle) * temp + cosf(angle) * a->y;
@@ -80,8 +80,7 @@ void Rotate3D(Vec3* a, float angle)
  */
 void Scale3D(Vec3* a, float scalar)
 {
-	if (a == NULL)
-	{ ErrorHandler(ACCESSING_NULL_POINTER_ERROR); }
+	RCM_ASSERT_NOT_NULL(a);
 	a->x *= scalar;
 	a->y *= scalar;
 	a->z *= scalar;
@@ -94,8 +93,7 @@ void Scale3D(Vec3* a, float scalar)
  */
 void Invert3D(Vec3* a)
 {
-	if (a == NULL)
-	{ ErrorHandler(ACCESSING_NULL_POINTER_ERROR); }
+	RCM_ASSERT_NOT_NULL(a);
 	a->x = -a->x;
 	a->y = -a->y;
 	a->z = -a->z;
@@ -108,8 +106,7 @@ void Invert3D(Vec3* a)
  */
 void Normalize3D(Vec3* a)
 {
-	if (a == NULL)
-	{ ErrorHandler(ACCESSING_NULL_POINTER_ERROR); }
+	RCM_ASSERT_NOT_NULL(a);
 	float vecLength = sqrtf((a->x) * (a->x) + (a->y) * (a->y) + (a->z) * (a->z));
 	if (!(CompareFloats(vecLength, ZERO) == 0))
 	{
@@ -128,8 +125,8 @@ void Normalize3D(Vec3* a)
  */
 float EuclideanDistance3D(const Vec3* a, const Vec3* b)
 {
-	if (a == NULL || b == NULL)
-	{ ErrorHandler(ACCESSING_NULL_POINTER_ERROR); }
+	RCM_ASSERT_NOT_NULL(a);
+	RCM_ASSERT_NOT_NULL(b);
 	float dx = a->x - b->x;
 	float dy = a->y - b->y;
 	float dz = a->z - b->z;
@@ -1,6 +1,9 @@
 #ifndef RAY_CASTING_MAZE_VEC3_H_
 #define RAY_CASTING_MAZE_VEC3_H_
 
+#include <math.h>
+#include "../Vec2/Vec2.h"
+
 /**
  * Struct for vector in R3.
  */
@@ -81,4 +84,168 @@ void Normalize3D(Vec3* a);
  */
 float EuclideanDistance3D(const Vec3* a, const Vec3* b);
 
+// ------------------------------------------- VALUE API -------------------------------------------
+// The functions below take and return vectors by value and are defined inline, so they can be inlined and vectorized
+// by the compiler. The world is 2D and the z component is used as a tag, e.g. the wall side of an intersection. When
+// RCM_VEC_SSE is defined the arithmetic is done in SSE registers, otherwise plain scalar code is used, which the
+// compiler vectorizes across loop iterations on its own.
+
+/**
+ * Creates a 3D vector by value.
+ *
+ * @param x the x component of the vector
+ * @param y the y component of the vector
+ * @param z the z component of the vector
+ * @return the vector
+ */
+static inline Vec3 V3(float x, float y, float z)
+{
+	Vec3 result = {x, y, z};
+	return result;
+}
+
+/**
+ * Creates a 3D vector from a 2D vector and a z component.
+ *
+ * @param a the 2D vector
+ * @param z the z component
+ * @return the vector
+ */
+static inline Vec3 V3FromVec2(Vec2 a, float z)
+{
+	return V3(a.x, a.y, z);
+}
+
+/**
+ * Gets the x and y components of a 3D vector.
+ *
+ * @param a the vector
+ * @return the 2D vector
+ */
+static inline Vec2 V3XY(Vec3 a)
+{
+	return V2(a.x, a.y);
+}
+
+#ifdef RCM_VEC_SSE
+/**
+ * Loads a vector into an SSE register with a 64-bit load of x and y and a 32-bit load of z, the fourth lane is zero.
+ *
+ * @param a the vector
+ * @return the SSE register
+ */
+static inline __m128 V3Load(Vec3 a)
+{
+	return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&a.x), _mm_load_ss(&a.z));
+}
+
+/**
+ * Stores the first three lanes of an SSE register into a vector with a 64-bit store of x and y and a 32-bit store of
+ * z.
+ *
+ * @param a the SSE register
+ * @return the vector
+ */
+static inline Vec3 V3Store(__m128 a)
+{
+	Vec3 result;
+	_mm_storel_pi((__m64*)&result.x, a);
+	_mm_store_ss(&result.z, _mm_movehl_ps(a, a));
+	return result;
+}
+#endif
+
+/**
+ * Adds two vectors.
+ *
+ * @param a vector a
+ * @param b vector b
+ * @return a + b
+ */
+static inline Vec3 V3Add(Vec3 a, Vec3 b)
+{
+#ifdef RCM_VEC_SSE
+	return V3Store(_mm_add_ps(V3Load(a), V3Load(b)));
+#else
+	return V3(a.x + b.x, a.y + b.y, a.z + b.z);
+#endif
+}
+
+/**
+ * Subtracts two vectors.
+ *
+ * @param a vector a
+ * @param b vector b
+ * @return a - b
+ */
+static inline Vec3 V3Sub(Vec3 a, Vec3 b)
+{
+#ifdef RCM_VEC_SSE
+	return V3Store(_mm_sub_ps(V3Load(a), V3Load(b)));
+#else
+	return V3(a.x - b.x, a.y - b.y, a.z - b.z);
+#endif
+}
+
+/**
+ * Scales a vector.
+ *
+ * @param a 	 the vector
+ * @param scalar the scalar
+ * @return scalar * a
+ */
+static inline Vec3 V3Scale(Vec3 a, float scalar)
+{
+#ifdef RCM_VEC_SSE
+	return V3Store(_mm_mul_ps(V3Load(a), _mm_set1_ps(scalar)));
+#else
+	return V3(a.x * scalar, a.y * scalar, a.z * scalar);
+#endif
+}
+
+/**
+ * Calculates the dot product of two vectors.
+ *
+ * @param a vector a
+ * @param b vector b
+ * @return the dot product
+ */
+static inline float V3Dot(Vec3 a, Vec3 b)
+{
+#ifdef RCM_VEC_SSE
+	__m128 product = _mm_mul_ps(V3Load(a), V3Load(b));
+	__m128 shuffled = _mm_movehl_ps(product, product);
+	__m128 sum = _mm_add_ps(product, shuffled);
+	sum = _mm_add_ss(sum, _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 1, 1, 1)));
+	return _mm_cvtss_f32(sum);
+#else
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+#endif
+}
+
+/**
+ * Rotates the x and y components of a vector by an angle, the z component is kept.
+ *
+ * @param a 	the vector
+ * @param angle the angle of rotation, in radians
+ * @return the rotated vector
+ */
+static inline Vec3 V3Rotate(Vec3 a, float angle)
+{
+	return V3FromVec2(V2Rotate(V3XY(a), angle), a.z);
+}
+
+/**
+ * Calculates the euclidean distance between two vectors.
+ *
+ * @param a the first vector
+ * @param b the second vector
+ * @return the euclidean distance
+ */
+static inline float V3Distance(Vec3 a, Vec3 b)
+{
+	Vec3 d = V3Sub(a, b);
+	return sqrtf(V3Dot(d, d));
+}
+
 #endif
@@ -0,0 +1,59 @@
+#include <stdlib.h>
+#include <string.h>
+#include "VisibilitySet.h"
+#include "../ErrorHandler/ErrorHandler.h"
+#include "../Assert/Assert.h"
+
+/**
+ * Creates an empty visibility set.
+ *
+ * @param numCells the number of cells the set can hold
+ * @return the visibility set
+ */
+VisibilitySet* CreateVisibilitySet(int numCells)
+{
+	RCM_ASSERT(numCells > 0, UNKNOWN_ERROR);
+	VisibilitySet* visibilitySet = (VisibilitySet*)calloc(1, sizeof(VisibilitySet));
+	if (visibilitySet == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	visibilitySet->numCells = numCells;
+	visibilitySet->stamps = (unsigned*)calloc(numCells, sizeof(unsigned));
+	visibilitySet->cells = (int*)calloc(numCells, sizeof(int));
+	if (visibilitySet->stamps == NULL || visibilitySet->cells == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	// The stamps start at 0, so no cell is in the first generation
+	visibilitySet->generation = 1;
+	visibilitySet->numVisible = 0;
+	return visibilitySet;
+}
+
+/**
+ * Frees the memory allocated for the given visibility set.
+ *
+ * @param visibilitySet the given visibility set
+ */
+void DestroyVisibilitySet(VisibilitySet* visibilitySet)
+{
+	if (visibilitySet == NULL)
+	{return;}
+	free(visibilitySet->stamps);
+	free(visibilitySet->cells);
+	free(visibilitySet);
+}
+
+/**
+ * Empties a visibility set by starting a new generation. The stamps are only cleared when the generation counter
+ * wraps around.
+ *
+ * @param visibilitySet the visibility set
+ */
+void ClearVisibilitySet(VisibilitySet* visibilitySet)
+{
+	RCM_ASSERT_NOT_NULL(visibilitySet);
+	if (++visibilitySet->generation == 0)
+	{
+		memset(visibilitySet->stamps, 0, (size_t)visibilitySet->numCells * sizeof(unsigned));
+		visibilitySet->generation = 1;
+	}
+	visibilitySet->numVisible = 0;
+}
@@ -0,0 +1,69 @@
+#ifndef RAY_CASTING_MAZE_VISIBILITYSET_H_
+#define RAY_CASTING_MAZE_VISIBILITYSET_H_
+
+/**
+ * Struct for the set of cells visible in one frame. Each cell holds the generation in which it was last added, so the
+ * set is emptied by starting a new generation instead of clearing every cell. The cells added in the current
+ * generation are also listed without repetition.
+ */
+typedef struct VisibilitySet_struct
+{
+	int numCells;        // number of cells the set can hold, cells are indexed from 0
+	unsigned* stamps;    // generation in which each cell was last added
+	unsigned generation; // current generation, never 0 so that no cell is in a new set
+	int* cells;          // the cells added in the current generation, in the order they were added
+	int numVisible;      // number of cells added in the current generation
+} VisibilitySet;
+
+/**
+ * Creates an empty visibility set.
+ *
+ * @param numCells the number of cells the set can hold
+ * @return the visibility set
+ */
+VisibilitySet* CreateVisibilitySet(int numCells);
+
+/**
+ * Frees the memory allocated for the given visibility set.
+ *
+ * @param visibilitySet the given visibility set
+ */
+void DestroyVisibilitySet(VisibilitySet* visibilitySet);
+
+/**
+ * Empties a visibility set by starting a new generation. The stamps are only cleared when the generation counter
+ * wraps around.
+ *
+ * @param visibilitySet the visibility set
+ */
+void ClearVisibilitySet(VisibilitySet* visibilitySet);
+
+/**
+ * Adds a cell to a visibility set.
+ *
+ * @param visibilitySet the visibility set
+ * @param cell 			the index of the cell
+ * @return 1 if the cell was not in the set before, 0 otherwise
+ */
+static inline int AddVisibleCell(VisibilitySet* visibilitySet, int cell)
+{
+	if (visibilitySet->stamps[cell] == visibilitySet->generation)
+	{return 0;}
+	visibilitySet->stamps[cell] = visibilitySet->generation;
+	visibilitySet->cells[visibilitySet->numVisible++] = cell;
+	return 1;
+}
+
+/**
+ * Checks if a cell is in a visibility set.
+ *
+ * @param visibilitySet the visibility set
+ * @param cell 			the index of the cell
+ * @return 1 if the cell is in the set, 0 otherwise
+ */
+static inline int IsCellVisible(const VisibilitySet* visibilitySet, int cell)
+{
+	return visibilitySet->stamps[cell] == visibilitySet->generation;
+}
+
+#endif
@@ -0,0 +1,215 @@
+#include <stddef.h>
+#include <math.h>
+#include "WallRenderer.h"
+
+/**
+ * Picks the texture of a wall cell. The cell index is hashed so neighboring walls use different textures.
+ *
+ * @param cellIndex   the index of the wall cell
+ * @param numTextures the number of textures in the atlas
+ * @return the texture index
+ */
+static int GetWallTexture(int cellIndex, int numTextures)
+{
+	return (int)(((uint32_t)cellIndex * 2654435761u) >> 16) % numTextures;
+}
+
+/**
+ * Picks the texture of a window cell, hashed like the wall textures so neighboring windows differ.
+ *
+ * @param cellIndex the index of the window cell
+ * @return SPRITE_TEXTURE_WINDOW or SPRITE_TEXTURE_GRATE
+ */
+static int GetWindowTexture(int cellIndex)
+{
+	return GetWallTexture(cellIndex, 2) == 0 ? SPRITE_TEXTURE_WINDOW : SPRITE_TEXTURE_GRATE;
+}
+
+/**
+ * Gets the first frame buffer row at or below a projected row, clamped to the frame buffer.
+ *
+ * @param row 	 the projected row
+ * @param height the height of the frame buffer
+ * @return the row in [0, height]
+ */
+static inline int ClampRow(float row, int height)
+{
+	return row <= 0.0f ? 0 : row >= (float)height ? height : (int)ceilf(row);
+}
+
+/**
+ * Draws the part of a wall face between two heights into one frame buffer column, above the clip row. The texture
+ * covers a full wall standing on the floor, so a low wall shows the bottom part of it. The face of a window is
+ * composited over the pixels already in the column, which must hold the surfaces behind it. Below an opaque face, the
+ * floor seen between it and the clip row is cast when the frame has a floor caster.
+ *
+ * @param frame 	   the wall render frame
+ * @param x 		   the frame buffer column
+ * @param intersection the point where the ray meets the face, the z component holds the wall side
+ * @param cell 		   the index of the wall or door cell, may be out of range for a ray stopped by the fog distance
+ * @param distance 	   the perpendicular distance of the face
+ * @param baseHeight   the height of the bottom of the drawn part, relative to a full wall
+ * @param topHeight    the height of the top of the drawn part, relative to a full wall
+ * @param clipRow 	   one past the last row that may be written
+ * @param isWindow 	   1 to composite the window texture of the cell, 0 to draw an opaque face
+ * @return the first row of the face, the clip row of the spans behind it
+ */
+static inline int DrawWallFace(const WallRenderFrame* frame, int x, const Vec3* intersection, int cell, float distance,
+		float baseHeight, float topHeight, int clipRow, int isWindow)
+{
+	const int width = frame->target->width;
+	const int height = frame->target->height;
+	distance = distance > COORDINATE_OFFSET ? distance : COORDINATE_OFFSET;
+	// The unclipped height keeps the texture scale correct when the wall is taller than the frame buffer
+	float wallHeight = RAY_HEIGHT_COEFFICIENT * (float)height / distance;
+	float wallTop = ((float)height - wallHeight) / 2.0f;
+	int yBegin = ClampRow(wallTop + (1.0f - topHeight) * wallHeight, height);
+	int yEnd = ClampRow(wallTop + (1.0f - baseHeight) * wallHeight, height);
+	if (yEnd > clipRow)
+	{yEnd = clipRow;}
+	if (!isWindow && frame->floorCaster != NULL && yBegin < clipRow)
+	{CastFloorAndCeilingColumn(frame->floorCaster, x, yEnd, clipRow);}
+
+	int mipLevel = SelectMipLevel(wallHeight);
+	int mipSize = TEXTURE_SIZE >> mipLevel;
+	float hitOffset = GetWallHitOffset(intersection, frame->mapCellSize);
+	const uint32_t* textureColumn;
+	if (isWindow)
+	{textureColumn = GetTextureColumn(frame->doorAtlas, GetWindowTexture(cell), mipLevel, hitOffset);}
+	// Rays stopped by the fog distance may end outside the map
+	else if (cell >= 0 && cell < frame->mapSize * frame->mapSize && IsDoor(frame->cells[cell]))
+	{
+		textureColumn = GetTextureColumn(frame->doorAtlas, SPRITE_TEXTURE_DOOR, mipLevel,
+				hitOffset - (float)GetDoorOpening(frame->cells[cell]) / (float)DOOR_OPENING_MAX);
+	}
+	else
+	{
+		textureColumn = GetTextureColumn(frame->atlas, GetWallTexture(cell, frame->atlas->numTextures), mipLevel,
+				hitOffset);
+	}
+	const uint8_t* colorMap = frame->shadingTable->colorMap[GetWallSurface(intersection->z)]
+			[GetShadeLevel(frame->shadingTable, distance)];
+
+	float textureStep = (float)mipSize / wallHeight;
+	float textureY = ((float)yBegin + 0.5f - wallTop) * textureStep;
+	uint32_t* pixel = frame->target->pixels + (size_t)yBegin * width + x;
+	if (isWindow)
+	{
+		for (int y = yBegin; y < yEnd; ++y)
+		{
+			uint32_t texel = textureColumn[(int)textureY & (mipSize - 1)];
+			uint32_t alpha = texel >> 24;
+			// The gaps of a grate leave the pixel alone, its bars and the frame of a window are opaque
+			if (alpha == 0xFFu)
+			{*pixel = ShadePixel(colorMap, texel);}
+			else if (alpha != 0)
+			{*pixel = BlendPixel(*pixel, ShadePixel(colorMap, texel), alpha);}
+			pixel += width;
+			textureY += textureStep;
+		}
+		return yBegin;
+	}
+	for (int y = yBegin; y < yEnd; ++y)
+	{
+		*pixel = ShadePixel(colorMap, textureColumn[(int)textureY & (mipSize - 1)]);
+		pixel += width;
+		textureY += textureStep;
+	}
+	return yBegin;
+}
+
+/**
+ * Draws the top of a wall lower than the eye into one frame buffer column, from the clip row, where the face of the wall
+ * or the previous top ended, up to the far edge of the top. The top is filled with the average color of the wall
+ * texture, lit as a flat surface.
+ *
+ * @param frame 	the wall render frame
+ * @param x 		the frame buffer column
+ * @param span 		the span of the far edge of the top
+ * @param clipRow 	one past the last row that may be written
+ * @return the row of the far edge, the clip row of the spans behind it
+ */
+static inline int DrawWallTop(const WallRenderFrame* frame, int x, const RaySpan* span, int clipRow)
+{
+	const int width = frame->target->width;
+	const int height = frame->target->height;
+	int yBegin = ClampRow(GetWallRow(span->topHeight, span->distance, (float)height), height);
+	// The single texel of the last mip level is the average color of the texture
+	uint32_t texel = GetTextureColumn(frame->atlas, GetWallTexture(span->cell, frame->atlas->numTextures),
+			TEXTURE_MIP_LEVELS - 1, 0.0f)[0];
+	uint32_t color = ShadePixel(frame->shadingTable->colorMap[SHADE_SURFACE_FLAT]
+			[GetShadeLevel(frame->shadingTable, span->distance)], texel);
+	uint32_t* pixel = frame->target->pixels + (size_t)yBegin * width + x;
+	for (int y = yBegin; y < clipRow; ++y)
+	{
+		*pixel = color;
+		pixel += width;
+	}
+	return yBegin;
+}
+
+/**
+ * Draws the textured and shaded wall spans of the frame buffer columns [columnBegin, columnEnd). The texture column is
+ * chosen from the hit offset along the wall and the mip level from the projected wall height. Door panels use the door
+ * texture, shifted by the opening so it slides with the panel. A ray followed past low walls draws its opaque spans from
+ * the nearest to the farthest, each one clipped to the rows above everything drawn before it in the column, so every
+ * pixel is written at most once. The windows among them, at most RAY_MAX_WINDOW_LAYERS, are composited afterwards from
+ * the farthest to the nearest, each one clipped like the span it was listed as. With a floor caster, the rows of the
+ * column between and around the opaque spans are filled with the floor and the ceiling as the spans are drawn, so the
+ * column is complete without a separate floor pass and no pixel is written twice. Disjoint column ranges can be drawn
+ * concurrently, the signature matches WorkerTask.
+ *
+ * @param columnBegin 	  the first frame buffer column
+ * @param columnEnd 	  one past the last frame buffer column
+ * @param wallRenderFrame the wall render frame, passed as void* so the function can be used as a WorkerTask
+ */
+void DrawWallColumns(int columnBegin, int columnEnd, void* wallRenderFrame)
+{
+	const WallRenderFrame* frame = (const WallRenderFrame*)wallRenderFrame;
+	const int width = frame->target->width;
+	const int height = frame->target->height;
+	for (int x = columnBegin; x < columnEnd; ++x)
+	{
+		int ray = (int)((long long)x * frame->numRays / width);
+		if (frame->numSpans == NULL || frame->numSpans[ray] == 0)
+		{
+			const Vec3* intersection = &frame->intersections[ray];
+			int top = DrawWallFace(frame, x, intersection,
+					GetHitCellIndex(intersection, frame->mapCellSize, frame->mapSize), frame->distances[ray], 0.0f,
+					1.0f, height, 0);
+			if (frame->floorCaster != NULL)
+			{CastFloorAndCeilingColumn(frame->floorCaster, x, 0, top);}
+			continue;
+		}
+		// Spans are ordered from the nearest, the rows of a span below the clip row are hidden by nearer ones
+		const RaySpan* spans = frame->spans + (size_t)ray * RAY_MAX_SPANS;
+		int clipRow = height;
+		int windowSpans[RAY_MAX_WINDOW_LAYERS];
+		int windowClipRows[RAY_MAX_WINDOW_LAYERS];
+		int numWindows = 0;
+		for (int i = 0; i < frame->numSpans[ray] && clipRow > 0; ++i)
+		{
+			// A window hides nothing behind it, it is kept to be composited once they are drawn
+			if (spans[i].isWindow)
+			{
+				windowSpans[numWindows] = i;
+				windowClipRows[numWindows++] = clipRow;
+				continue;
+			}
+			int top = spans[i].isTop ? DrawWallTop(frame, x, &spans[i], clipRow) :
+					DrawWallFace(frame, x, &spans[i].intersection, spans[i].cell, spans[i].distance,
+							spans[i].baseHeight, spans[i].topHeight, clipRow, 0);
+			if (top < clipRow)
+			{clipRow = top;}
+		}
+		// Above the farthest opaque span only the floor and the ceiling are left, the windows are composited over them
+		if (frame->floorCaster != NULL)
+		{CastFloorAndCeilingColumn(frame->floorCaster, x, 0, clipRow);}
+		while (numWindows > 0)
+		{
+			const RaySpan* span = &spans[windowSpans[--numWindows]];
+			DrawWallFace(frame, x, &span->intersection, span->cell, span->distance, span->baseHeight, span->topHeight,
+					windowClipRows[numWindows], 1);
+		}
+	}
+}
@@ -0,0 +1,50 @@
+#ifndef RAY_CASTING_MAZE_WALLRENDERER_H_
+#define RAY_CASTING_MAZE_WALLRENDERER_H_
+
+#include "../Vec3/Vec3.h"
+#include "../FrameBuffer/FrameBuffer.h"
+#include "../Shading/Shading.h"
+#include "../TextureAtlas/TextureAtlas.h"
+#include "../RayCaster/RayCaster.h"
+#include "../FloorCaster/FloorCaster.h"
+
+/**
+ * Everything needed to draw the textured wall columns of one frame.
+ */
+typedef struct WallRenderFrame_struct
+{
+	FrameBuffer* target;               // frame buffer to be written
+	const Vec3* intersections;         // intersection of each ray, the z component holds the wall side
+	const float* distances;            // perpendicular distance of each ray
+	const RaySpan* spans;              // RAY_MAX_SPANS spans per ray followed past low walls and through windows
+	const int* numSpans;               // number of spans of each ray, 0 for a ray drawn from its intersection alone,
+									   // NULL if every wall is full and opaque
+	int numRays;                       // number of rays, frame buffer columns are mapped onto rays
+	float mapCellSize;                 // size of each cell in the map grid
+	int mapSize;                       // side length of the square map grid
+	const int* cells;                  // cells of the map, telling doors from walls
+	const TextureAtlas* atlas;         // wall textures
+	const TextureAtlas* doorAtlas;     // atlas holding the door, window and grate textures at SPRITE_TEXTURE_*
+	const ShadingTable* shadingTable;  // lighting and fog lookup tables
+	const FloorCaster* floorCaster;    // floor and ceiling caster prepared for the target, filling the rows no wall
+									   // covers, NULL to leave them untouched
+} WallRenderFrame;
+
+/**
+ * Draws the textured and shaded wall spans of the frame buffer columns [columnBegin, columnEnd). The texture column is
+ * chosen from the hit offset along the wall and the mip level from the projected wall height. Door panels use the door
+ * texture, shifted by the opening so it slides with the panel. A ray followed past low walls draws its opaque spans from
+ * the nearest to the farthest, each one clipped to the rows above everything drawn before it in the column, so every
+ * pixel is written at most once. The windows among them, at most RAY_MAX_WINDOW_LAYERS, are composited afterwards from
+ * the farthest to the nearest, each one clipped like the span it was listed as. With a floor caster, the rows of the
+ * column between and around the opaque spans are filled with the floor and the ceiling as the spans are drawn, so the
+ * column is complete without a separate floor pass and no pixel is written twice. Disjoint column ranges can be drawn
+ * concurrently, the signature matches WorkerTask.
+ *
+ * @param columnBegin 	  the first frame buffer column
+ * @param columnEnd 	  one past the last frame buffer column
+ * @param wallRenderFrame the wall render frame, passed as void* so the function can be used as a WorkerTask
+ */
+void DrawWallColumns(int columnBegin, int columnEnd, void* wallRenderFrame);
+
+#endif
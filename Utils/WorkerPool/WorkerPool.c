@@ -0,0 +1,140 @@
+#include <stdlib.h>
+#include "WorkerPool.h"
+#include "../ErrorHandler/ErrorHandler.h"
+
+/**
+ * Claims chunks of the current task until all indices are claimed.
+ *
+ * @param pool the worker pool
+ */
+static void RunChunks(WorkerPool* pool)
+{
+	while (1)
+	{
+		int begin = SDL_AtomicAdd(&pool->nextIndex, pool->grainSize);
+		if (begin >= pool->count)
+		{break;}
+		int end = begin + pool->grainSize < pool->count ? begin + pool->grainSize : pool->count;
+		pool->task(begin, end, pool->context);
+	}
+}
+
+/**
+ * Worker thread main loop. Waits for a new task, processes chunks of it and reports completion.
+ *
+ * @param data the worker pool
+ * @return 0
+ */
+static int WorkerMain(void* data)
+{
+	WorkerPool* pool = (WorkerPool*)data;
+	int seenGeneration = 0;
+	while (1)
+	{
+		SDL_LockMutex(pool->mutex);
+		while (pool->generation == seenGeneration && !pool->isShuttingDown)
+		{SDL_CondWait(pool->workAvailable, pool->mutex);}
+		if (pool->isShuttingDown)
+		{
+			SDL_UnlockMutex(pool->mutex);
+			return 0;
+		}
+		seenGeneration = pool->generation;
+		SDL_UnlockMutex(pool->mutex);
+
+		RunChunks(pool);
+
+		SDL_LockMutex(pool->mutex);
+		if (--(pool->activeWorkers) == 0)
+		{SDL_CondSignal(pool->workFinished);}
+		SDL_UnlockMutex(pool->mutex);
+	}
+}
+
+/**
+ * Creates a worker pool and starts its threads.
+ *
+ * @param numWorkers the number of worker threads, excluding the calling thread
+ * @return the worker pool
+ */
+WorkerPool* CreateWorkerPool(int numWorkers)
+{
+	WorkerPool* pool = (WorkerPool*)calloc(1, sizeof(WorkerPool));
+	if (pool == NULL)
+	{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	pool->numWorkers = numWorkers > 0 ? numWorkers : 0;
+	pool->mutex = SDL_CreateMutex();
+	pool->workAvailable = SDL_CreateCond();
+	pool->workFinished = SDL_CreateCond();
+	if (pool->numWorkers > 0)
+	{
+		pool->threads = (SDL_Thread**)calloc(pool->numWorkers, sizeof(SDL_Thread*));
+		if (pool->threads == NULL)
+		{ErrorHandler(MEMORY_ALLOCATION_ERROR);}
+	}
+	for (int i = 0; i < pool->numWorkers; ++i)
+	{pool->threads[i] = SDL_CreateThread(WorkerMain, "RayCastingMazeWorker", pool);}
+	return pool;
+}
+
+/**
+ * Stops the threads of the given worker pool and frees the memory allocated for it.
+ *
+ * @param pool the given worker pool
+ */
+void DestroyWorkerPool(WorkerPool* pool)
+{
+	if (pool == NULL)
+	{return;}
+	SDL_LockMutex(pool->mutex);
+	pool->isShuttingDown = 1;
+	SDL_CondBroadcast(pool->workAvailable);
+	SDL_UnlockMutex(pool->mutex);
+	for (int i = 0; i < pool->numWorkers; ++i)
+	{SDL_WaitThread(pool->threads[i], NULL);}
+	SDL_DestroyCond(pool->workFinished);
+	SDL_DestroyCond(pool->workAvailable);
+	SDL_DestroyMutex(pool->mutex);
+	free(pool->threads);
+	free(pool);
+}
+
+/**
+ * Runs a task over the index range [0, count) in chunks of grainSize indices and returns once every chunk has been
+ * processed. Chunks are claimed dynamically, so uneven chunks are balanced across threads.
+ *
+ * @param pool 		the worker pool, NULL runs the task on the calling thread
+ * @param count 	the number of indices
+ * @param grainSize the number of indices claimed at a time
+ * @param task 		the task
+ * @param context 	the context passed to the task
+ */
+void RunParallelFor(WorkerPool* pool, int count, int grainSize, WorkerTask task, void* context)
+{
+	if (task == NULL)
+	{ErrorHandler(ACCESSING_NULL_POINTER_ERROR);}
+	if (count <= 0)
+	{return;}
+	if (pool == NULL || pool->numWorkers == 0 || count <= grainSize)
+	{
+		task(0, count, context);
+		return;
+	}
+	SDL_LockMutex(pool->mutex);
+	pool->task = task;
+	pool->context = context;
+	pool->count = count;
+	pool->grainSize = grainSize > 0 ? grainSize : 1;
+	SDL_AtomicSet(&pool->nextIndex, 0);
+	pool->activeWorkers = pool->numWorkers;
+	++(pool->generation);
+	SDL_CondBroadcast(pool->workAvailable);
+	SDL_UnlockMutex(pool->mutex);
+
+	RunChunks(pool);
+
+	SDL_LockMutex(pool->mutex);
+	while (pool->activeWorkers > 0)
+	{SDL_CondWait(pool->workFinished, pool->mutex);}
+	SDL_UnlockMutex(pool->mutex);
+}
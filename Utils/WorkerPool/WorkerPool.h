@@ -0,0 +1,59 @@
+#ifndef RAY_CASTING_MAZE_WORKERPOOL_H_
+#define RAY_CASTING_MAZE_WORKERPOOL_H_
+
+#include <SDL.h>
+
+/**
+ * Task executed by the worker pool on the half-open index range [begin, end).
+ */
+typedef void (*WorkerTask)(int begin, int end, void* context);
+
+/**
+ * Pool of persistent worker threads. The thread calling RunParallelFor() participates in the work, so a pool with
+ * zero workers runs every task on the calling thread.
+ */
+typedef struct WorkerPool_struct
+{
+	int numWorkers;
+	SDL_Thread** threads;
+	SDL_mutex* mutex;
+	SDL_cond* workAvailable;
+	SDL_cond* workFinished;
+	int generation;        // incremented each time a new task is dispatched
+	int activeWorkers;     // number of workers that have not finished the current task
+	int isShuttingDown;
+	WorkerTask task;
+	void* context;
+	int count;
+	int grainSize;
+	SDL_atomic_t nextIndex; // next unclaimed index of the current task
+} WorkerPool;
+
+/**
+ * Creates a worker pool and starts its threads.
+ *
+ * @param numWorkers the number of worker threads, excluding the calling thread
+ * @return the worker pool
+ */
+WorkerPool* CreateWorkerPool(int numWorkers);
+
+/**
+ * Stops the threads of the given worker pool and frees the memory allocated for it.
+ *
+ * @param pool the given worker pool
+ */
+void DestroyWorkerPool(WorkerPool* pool);
+
+/**
+ * Runs a task over the index range [0, count) in chunks of grainSize indices and returns once every chunk has been
+ * processed. Chunks are claimed dynamically, so uneven chunks are balanced across threads.
+ *
+ * @param pool 		the worker pool, NULL runs the task on the calling thread
+ * @param count 	the number of indices
+ * @param grainSize the number of indices claimed at a time
+ * @param task 		the task
+ * @param context 	the context passed to the task
+ */
+void RunParallelFor(WorkerPool* pool, int count, int grainSize, WorkerTask task, void* context);
+
+#endif
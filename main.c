@@ -1,18 +1,68 @@
+#include <stdio.h>
 #include <SDL.h>
-#include "Map/Map.h"
-#include "Player/Player.h"
+#include "Engine/Engine.h"
+#include "InputLog/InputLog.h"
+#include "Autopilot/Autopilot.h"
 #include "Utils/RayCaster/RayCaster.h"
+#include "Utils/DynamicResolution/DynamicResolution.h"
+#include "Utils/Config/Config.h"
+#include "Utils/AsyncTask/AsyncTask.h"
+#include "Utils/Assert/Assert.h"
 
 // -------------------------------------- GLOBALS ---------------------------------------
+Config CONFIG;                      // runtime configuration loaded from the configuration file and command line
 const Uint8* KEYBOARD_STATE = NULL; // keyboard state
-const int W_W = 1024;               // SDL window width
-const int W_H = 768;                // SDL window height
+int W_W = 0;                        // SDL window width
+int W_H = 0;                        // SDL window height
 SDL_Window* WINDOW = NULL;          // SDL window
 SDL_Renderer* RENDERER = NULL;      // SDL renderer
+const float R_MIN_SCALE = 0.25f;    // lowest internal render width relative to the maximum, used by dynamic resolution
+const int R_STEP_W = 32;            // change in internal render width per dynamic resolution adjustment
+DynamicResolution* DYNAMIC_RESOLUTION = NULL; // controller adjusting the internal render width to the frame budget
+SDL_Texture* CAMERA_TEXTURES[ENGINE_MAX_CAMERAS] = {NULL}; // streaming textures the camera frame buffers are uploaded to
+WorkerPool* WORKER_POOL = NULL;     // worker threads used to split per-frame work
+TextureAtlas* TEXTURE_ATLAS = NULL; // wall textures and their mip levels
+const char* const WALL_TEXTURE_PATHS[] = {"Assets/Textures/wall0.bmp", "Assets/Textures/wall1.bmp",
+										  "Assets/Textures/wall2.bmp", "Assets/Textures/wall3.bmp"};
+const int WALL_TEXTURE_COUNT = 4;   // number of wall textures
+Engine* ENGINE = NULL;              // the game instance: map, player and cameras
+Camera* MONITOR_CAMERA = NULL;      // camera watching the exit of the maze, shown in the top-right corner
+const Viewport MONITOR_VIEWPORT = {0.7f, 0.02f, 0.28f, 0.28f}; // part of the window the monitor camera is shown in
+const float MONITOR_SWEEP_ANGLE = 0.005f; // angle the monitor camera turns by each frame
+InputLog* INPUT_LOG = NULL;         // input of every tick of the session, only recorded when a record path is configured
+Autopilot* AUTOPILOT = NULL;        // bot walking the player to the exit
+int IS_AUTOPILOT_ON = 0;            // flag representing if the autopilot or the arrow keys move the player
+int SHOW_HINT = 0;                  // flag representing if the shortest path to the exit is drawn on the top-down map
+SDL_Texture* MINIMAP_TEXTURE = NULL; // render target holding the explored part of the maze, one square per cell
+int MINIMAP_CELL_PIXELS = 1;        // side length in pixels of a cell in the minimap texture
+const int MINIMAP_MAX_SIZE = 1024;  // largest side length in pixels of the minimap texture
+const float MINIMAP_OVERLAY_SIZE = 0.3f; // side length of the minimap shown over the first-person view, relative to
+										 // the window height
+int MINIMAP_PLAYER_CELL = -1;       // cell the player was in when the minimap was last updated
+int SHOW_MINIMAP = 1;               // flag representing if the minimap is shown over the first-person view
+int IS_MOUSE_LOOK_ON = 0;           // flag representing if mouse motion turns the player, the mouse is captured while on
 int IS_RUNNING = 1;                 // main loop flag
 int SHOW_MAP = 0;                   // flag representing if the top-down map or the first person view should be rendered
-int HAS_WON = 0;                    // flag representing if the game is won. The game is won if player reaches the
-									// bottom-right cell of the maze
+AsyncTask* RENDER_TASK = NULL;      // thread rendering the next frame while the previous one is presented, only created
+									// when frames are pipelined
+int HAS_PRESENTED_FRAME = 0;        // flag representing if the presented frame buffers hold a first-person frame that can
+									// be submitted
+int PRESENTED_CAMERAS[ENGINE_MAX_CAMERAS] = {0}; // flags representing which cameras were rendered in the presented frame
+Vec3 PRESENTED_PLAYER_POSITION;     // player position of the presented frame, marked on the minimap
+int IS_PRESENTED_CELL_VISITED = 0;  // flag representing if the cell pointed by the crosshair in the presented frame is
+									// visited
+Uint64 FRAME_INPUT_TIME = 0;        // performance counter when the input of the frame being rendered was sampled
+Uint64 PRESENTED_INPUT_TIME = 0;    // performance counter when the input of the presented frame was sampled
+Uint64 SESSION_START = 0;           // performance counter when the main loop started
+int NUM_PRESENTED_FRAMES = 0;       // number of first-person frames presented
+double TOTAL_PRESENT_LATENCY_MS = 0.0; // sum over the presented first-person frames of the time from sampling the input
+									   // to the return of SDL_RenderPresent()
+const double TITLE_UPDATE_INTERVAL_MS = 500.0; // time between updates of the statistics shown in the window title
+Uint64 TITLE_INTERVAL_START = 0;    // performance counter when the statistics of the window title were last reset
+int TITLE_NUM_RENDERED = 0;         // number of frames rendered since the window title was updated
+double TITLE_RENDER_MS = 0.0;       // sum of the render times of those frames
+int TITLE_NUM_PRESENTED = 0;        // number of frames presented since the window title was updated
+double TITLE_LATENCY_MS = 0.0;      // sum of the input to present latencies of those frames
 
 // -------------------------------------- FUNCTIONS ---------------------------------------
 /**
@@ -25,43 +75,233 @@ void ClearBackground()
 }
 
 /**
- * Renders the wall rectangles representing walls.
+ * Draws one cell into the minimap texture, which must be the current render target: walls in gray, darker for low
+ * walls, windows in pale blue, doors in brown getting darker as they open, visited cells in dark red and other open
+ * cells in dark gray. Cells that were never seen stay black.
+ *
+ * @param cell 	  the index of the cell
+ * @param context unused
  */
-void DrawMapWallRectangles()
+void DrawMinimapCell(int cell, void* context)
 {
-	for (int i = 0; i < M_WALL_RECTS_LENGTH; ++i)
+	(void)context;
+	const Map* map = &ENGINE->map;
+	if (IsMapLowWall(map, cell))
 	{
-		SDL_SetRenderDrawColor(RENDERER, 128, 128, 128, SDL_ALPHA_OPAQUE);
-		SDL_RenderFillRectF(RENDERER, &M_WALL_RECTS[i]);
+		Uint8 gray = (Uint8)(64 + 64 * map->wallHeights[cell] / MAP_WALL_HEIGHT_FULL);
+		SDL_SetRenderDrawColor(RENDERER, gray, gray, gray, SDL_ALPHA_OPAQUE);
 	}
+	else if (IsMapWindow(map, cell))
+	{SDL_SetRenderDrawColor(RENDERER, 112, 152, 176, SDL_ALPHA_OPAQUE);}
+	else if (map->cells[cell] == WALL)
+	{SDL_SetRenderDrawColor(RENDERER, 128, 128, 128, SDL_ALPHA_OPAQUE);}
+	else if (IsDoor(map->cells[cell]))
+	{
+		int closed = DOOR_OPENING_MAX - GetDoorOpening(map->cells[cell]);
+		SDL_SetRenderDrawColor(RENDERER, (Uint8)(64 + closed / 3), (Uint8)(40 + closed / 5), (Uint8)(16 + closed / 12),
+				SDL_ALPHA_OPAQUE);
+	}
+	else if (IsMapCellVisited(map, cell))
+	{SDL_SetRenderDrawColor(RENDERER, 112, 24, 24, SDL_ALPHA_OPAQUE);}
+	else
+	{SDL_SetRenderDrawColor(RENDERER, 48, 48, 48, SDL_ALPHA_OPAQUE);}
+	SDL_Rect rect = {(cell % map->size) * MINIMAP_CELL_PIXELS, (cell / map->size) * MINIMAP_CELL_PIXELS,
+					 MINIMAP_CELL_PIXELS, MINIMAP_CELL_PIXELS};
+	SDL_RenderFillRect(RENDERER, &rect);
 }
 
 /**
- * Renders the floor in first-person view.
+ * Draws a cell whose value changed into the minimap texture if the cell was already seen, cells never seen stay black.
+ *
+ * @param cell 	  the index of the cell
+ * @param context unused
  */
-void DrawFloor()
+void RedrawChangedMinimapCell(int cell, void* context)
 {
-	SDL_FRect rect;
-	rect.x = 0.0f;
-	rect.y = (float)W_H / 2;
-	rect.h = (float)W_H / 2;
-	rect.w = (float)W_W;
-	SDL_SetRenderDrawColor(RENDERER, 65, 65, 65, SDL_ALPHA_OPAQUE);
-	SDL_RenderFillRectF(RENDERER, &rect);
+	if (IsMapCellSeen(&ENGINE->map, cell))
+	{DrawMinimapCell(cell, context);}
 }
 
 /**
- * Renders the ceiling in first-person view.
+ * Draws the cells that entered the player's view since the last update into the minimap texture, the seen cells whose
+ * value changed, such as moving doors, and the cell the player walked into, which may now be visited. The rest of the
+ * texture is kept from previous frames.
  */
-void DrawCeiling()
+void UpdateMinimap()
 {
-	SDL_FRect rect;
-	rect.x = 0.0f;
-	rect.y = 0.0f;
-	rect.h = (float)W_H / 2.0f;
-	rect.w = (float)W_W;
-	SDL_SetRenderDrawColor(RENDERER, 95, 95, 95, SDL_ALPHA_OPAQUE);
-	SDL_RenderFillRectF(RENDERER, &rect);
+	const Map* map = &ENGINE->map;
+	SDL_SetRenderTarget(RENDERER, MINIMAP_TEXTURE);
+	RevealEngineView(ENGINE, DrawMinimapCell, NULL);
+	ConsumeEngineCellChanges(ENGINE, RedrawChangedMinimapCell, NULL);
+	int playerCell = GetPlayerCellIndex(&ENGINE->player.position, map->cellSize, map->size);
+	if (playerCell != MINIMAP_PLAYER_CELL)
+	{
+		DrawMinimapCell(playerCell, NULL);
+		MINIMAP_PLAYER_CELL = playerCell;
+	}
+	SDL_SetRenderTarget(RENDERER, NULL);
+}
+
+/**
+ * Draws every seen cell into the minimap texture again, used when the renderer lost the contents of its render targets.
+ */
+void RedrawMinimap()
+{
+	const Map* map = &ENGINE->map;
+	SDL_SetRenderTarget(RENDERER, MINIMAP_TEXTURE);
+	SDL_SetRenderDrawColor(RENDERER, 0, 0, 0, SDL_ALPHA_OPAQUE);
+	SDL_RenderClear(RENDERER);
+	for (int i = 0; i < map->size * map->size; ++i)
+	{
+		if (IsMapCellSeen(map, i))
+		{DrawMinimapCell(i, NULL);}
+	}
+	SDL_SetRenderTarget(RENDERER, NULL);
+}
+
+/**
+ * Copies the minimap texture to a part of the window and marks the player's position on it.
+ *
+ * @param destination 	 the part of the window the whole maze is shown in
+ * @param playerPosition the position of the player to mark
+ */
+void DrawMinimap(const SDL_Rect* destination, Vec3 playerPosition)
+{
+	const Map* map = &ENGINE->map;
+	SDL_RenderCopy(RENDERER, MINIMAP_TEXTURE, NULL, destination);
+	float scale = (float)destination->w / ((float)map->size * map->cellSize);
+	SDL_FRect player = {(float)destination->x + playerPosition.x * scale - 2.0f,
+						(float)destination->y + playerPosition.y * scale - 2.0f, 4.0f, 4.0f};
+	SDL_SetRenderDrawColor(RENDERER, 225, 225, 0, SDL_ALPHA_OPAQUE);
+	SDL_RenderFillRectF(RENDERER, &player);
+}
+
+/**
+ * Uploads the presented frame buffer of each camera rendered in the presented frame to its streaming texture and copies
+ * it to the camera's viewport. Only the part of the texture used at the internal resolution of that frame is uploaded,
+ * SDL scales it up to the viewport.
+ */
+void DrawCameraFrameBuffers()
+{
+	for (int i = 0; i < ENGINE->numCameras; ++i)
+	{
+		const Camera* camera = ENGINE->cameras[i];
+		if (!PRESENTED_CAMERAS[i])
+		{continue;}
+		// Single-buffered cameras present the frame buffer they were just rendered into
+		const FrameBuffer* frameBuffer = camera->presentedFrameBuffer != NULL ? camera->presentedFrameBuffer :
+				camera->frameBuffer;
+		SDL_Rect source;
+		source.x = 0;
+		source.y = 0;
+		source.w = frameBuffer->width;
+		source.h = frameBuffer->height;
+		SDL_Rect destination;
+		destination.x = (int)(camera->viewport.x * (float)W_W);
+		destination.y = (int)(camera->viewport.y * (float)W_H);
+		destination.w = (int)(camera->viewport.w * (float)W_W);
+		destination.h = (int)(camera->viewport.h * (float)W_H);
+		SDL_UpdateTexture(CAMERA_TEXTURES[i], &source, frameBuffer->pixels, frameBuffer->width * (int)sizeof(Uint32));
+		SDL_RenderCopy(RENDERER, CAMERA_TEXTURES[i], &source, &destination);
+	}
+}
+
+/**
+ * Places the monitor camera in the bottom-right cell of the maze, where the game is won, facing the maze.
+ */
+void PlaceMonitorCamera()
+{
+	const Map* map = &ENGINE->map;
+	MONITOR_CAMERA->position = V3(((float)map->size - 1.5f) * map->cellSize, ((float)map->size - 1.5f) * map->cellSize,
+			0.0f);
+	MONITOR_CAMERA->direction = V3Rotate(V3(-1.0f, 0.0f, 0.0f), (float)M_PI / 4);
+}
+
+/**
+ * Switches mouse look on or off. While it is on, the mouse is captured in relative mode, so it keeps reporting motion
+ * at the edges of the window, and its horizontal motion turns the player.
+ *
+ * @param isOn 1 to switch mouse look on, 0 to switch it off
+ */
+void SetMouseLook(int isOn)
+{
+	IS_MOUSE_LOOK_ON = isOn;
+	SDL_SetRelativeMouseMode(isOn ? SDL_TRUE : SDL_FALSE);
+	// Drops the motion accumulated so far, so the view does not jump when mouse look is switched on
+	SDL_GetRelativeMouseState(NULL, NULL);
+}
+
+/**
+ * Handles the press of a key that quits or switches a view or mode. Each press is handled once, the repeats of a held
+ * key are not passed here.
+ *
+ * @param scancode the key pressed
+ */
+void HandleKeyDown(SDL_Scancode scancode)
+{
+	// presses ESCAPE to quit
+	if (scancode == SDL_SCANCODE_ESCAPE)
+	{IS_RUNNING = 0;}
+	// presses SPACE to render top-down map
+	else if (scancode == SDL_SCANCODE_SPACE)
+	{SHOW_MAP = !SHOW_MAP;}
+	// presses V to show or hide the monitor camera
+	else if (scancode == SDL_SCANCODE_V)
+	{MONITOR_CAMERA->isEnabled = !MONITOR_CAMERA->isEnabled;}
+	// presses P to switch the autopilot on or off
+	else if (scancode == SDL_SCANCODE_P)
+	{IS_AUTOPILOT_ON = !IS_AUTOPILOT_ON;}
+	// presses H to show or hide the shortest path to the exit on the top-down map
+	else if (scancode == SDL_SCANCODE_H)
+	{SHOW_HINT = !SHOW_HINT;}
+	// presses M to show or hide the minimap over the first-person view
+	else if (scancode == SDL_SCANCODE_M)
+	{SHOW_MINIMAP = !SHOW_MINIMAP;}
+	// presses L to switch mouse look on or off
+	else if (scancode == SDL_SCANCODE_L)
+	{SetMouseLook(!IS_MOUSE_LOOK_ON);}
+}
+
+/**
+ * Handles the queued events. Only the fields of the event type received are read. Movement is not driven by events,
+ * it is sampled from the keyboard and mouse state by SamplePlayerInput().
+ */
+void ProcessEvents()
+{
+	SDL_Event event;
+	while (SDL_PollEvent(&event))
+	{
+		// clicks on Close to quit
+		if (event.type == SDL_QUIT)
+		{IS_RUNNING = 0;}
+		else if (event.type == SDL_KEYDOWN && !event.key.repeat)
+		{HandleKeyDown(event.key.keysym.scancode);}
+		// the renderer may drop the contents of render targets, e.g. when the device is reset
+		else if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+		{RedrawMinimap();}
+	}
+}
+
+/**
+ * Samples the movements requested by the arrow keys and by mouse look, called right before the game is updated with
+ * them. The event queue is pumped first, so the state includes everything received until now. The horizontal mouse
+ * motion accumulated since the last sample is read and cleared even while mouse look is off, so switching it on does
+ * not turn the player by old motion.
+ *
+ * @return the movements requested for this frame
+ */
+PlayerInput SamplePlayerInput()
+{
+	SDL_PumpEvents();
+	int mouseMotion = 0;
+	SDL_GetRelativeMouseState(&mouseMotion, NULL);
+	PlayerInput input;
+	input.isMovingForward = KEYBOARD_STATE[SDL_SCANCODE_UP] > 0;
+	input.isMovingBackward = KEYBOARD_STATE[SDL_SCANCODE_DOWN] > 0;
+	input.isTurningClockwise = KEYBOARD_STATE[SDL_SCANCODE_RIGHT] > 0;
+	input.isTurningCounterClockwise = KEYBOARD_STATE[SDL_SCANCODE_LEFT] > 0;
+	input.turnAngle = IS_MOUSE_LOOK_ON ? (float)mouseMotion * CONFIG.mouseSensitivity : 0.0f;
+	return input;
 }
 
 /**
@@ -69,15 +309,16 @@ void DrawCeiling()
  */
 void DrawPlayerDirection()
 {
-	Vec3* playerDirectionIntersection = CalculateFinalIntersection(P_POS, P_DIR,
-			M_CELL_SIZE, MAP, M_SIZE);
-	if (playerDirectionIntersection->z == 1.0f) // red line if player direction ray intersects with vertical wall
+	const Player* player = &ENGINE->player;
+	Vec3 playerDirectionIntersection = CastRay(V3XY(player->position), V3XY(player->direction),
+			ENGINE->map.cellSize, ENGINE->map.cells, ENGINE->map.size, NULL, RAY_UNLIMITED_LENGTH, NULL,
+			NULL);
+	if (playerDirectionIntersection.z == 1.0f) // red line if player direction ray intersects with vertical wall
 	{SDL_SetRenderDrawColor(RENDERER, 225, 0, 0, SDL_ALPHA_OPAQUE);}
-	else if (playerDirectionIntersection->z == -1.0f) // blue line if player direction ray intersects with vertical wall
+	else if (playerDirectionIntersection.z == -1.0f) // blue line if player direction ray intersects with vertical wall
 	{SDL_SetRenderDrawColor(RENDERER, 0, 0, 225, SDL_ALPHA_OPAQUE);}
-	SDL_RenderDrawLineF(RENDERER, playerDirectionIntersection->x, playerDirectionIntersection->y, P_POS->x,
-			P_POS->y);
-	free(playerDirectionIntersection);
+	SDL_RenderDrawLineF(RENDERER, playerDirectionIntersection.x, playerDirectionIntersection.y, player->position.x,
+			player->position.y);
 }
 
 /**
@@ -85,14 +326,12 @@ void DrawPlayerDirection()
  */
 void DrawRays()
 {
-	if (P_RAYS != NULL)
-	{free(P_RAYS);}
-	P_RAYS = CalculateIntersections(P_POS, P_DIR, M_CELL_SIZE, MAP, M_SIZE,
-			P_FOV, P_NUM_RAYS);
+	const Player* player = &ENGINE->player;
+	const Camera* camera = ENGINE->cameras[ENGINE_PLAYER_CAMERA];
 	SDL_SetRenderDrawColor(RENDERER, 125, 225, 125, SDL_ALPHA_OPAQUE);
-	for (int i = 0; i < P_NUM_RAYS; ++i)
+	for (int i = 0; i < camera->numRays; ++i)
 	{
-		SDL_RenderDrawLineF(RENDERER, P_RAYS[i].x, P_RAYS[i].y, P_POS->x, P_POS->y);
+		SDL_RenderDrawLineF(RENDERER, camera->rays[i].x, camera->rays[i].y, player->position.x, player->position.y);
 	}
 }
 
@@ -110,112 +349,194 @@ void DrawCrosshair()
 }
 
 /**
- * Renders the first-person view.
+ * Renders the views of the engine, run on the render thread when frames are pipelined.
+ *
+ * @param context the engine
  */
-void DrawFirstPersonView()
+void RenderFrameTask(void* context)
 {
-	DrawCeiling();
-	DrawFloor();
-	if (P_RAYS != NULL)
-	{free(P_RAYS);}
-	P_RAYS = CalculateIntersections(P_POS, P_DIR, M_CELL_SIZE, MAP, M_SIZE,
-			P_FOV, P_NUM_RAYS);
-	if (P_RAY_HEIGHTS != NULL)
-	{free(P_RAY_HEIGHTS);}
-	P_RAY_HEIGHTS = CalculateHeights(P_RAYS, P_POS, P_DIR, P_NUM_RAYS,
-			(float)W_H);
-	float rectWidth = (float)W_W / (float)P_NUM_RAYS;
-	for (int i = 0; i < P_NUM_RAYS; ++i)
-	{
-		if (P_RAYS[i].z == -1)
-		{SDL_SetRenderDrawColor(RENDERER, 155, 155, 155, SDL_ALPHA_OPAQUE);}
-		else
-		{SDL_SetRenderDrawColor(RENDERER, 195, 195, 195, SDL_ALPHA_OPAQUE);}
-		SDL_FRect rect;
-		rect.x = (float)i * rectWidth;
-		rect.y = (float)W_H / 2 - P_RAY_HEIGHTS[i] / 2;
-		rect.h = P_RAY_HEIGHTS[i];
-		rect.w = rectWidth;
-		SDL_RenderFillRectF(RENDERER, &rect);
-	}
-	Vec3* playerDirectionIntersection = CalculateFinalIntersection(P_POS, P_DIR,
-			M_CELL_SIZE, MAP, M_SIZE);
-	// Updates the status of the cell where the player is currently located, changes the status to visited
-	int currentPlayerCellIndex = GetPlayerCellIndex(P_POS, M_CELL_SIZE, M_SIZE);
-	MAP_STATUS[currentPlayerCellIndex] = 2;
+	RenderEngineFrame((Engine*)context);
+}
 
+/**
+ * Completes a first-person frame once its views are rendered: draws the newly seen cells into the minimap and keeps
+ * what the overlays of the frame show, so the frame can be submitted after the game has moved on.
+ */
+void FinishFirstPersonFrame()
+{
+	UpdateMinimap();
+	for (int i = 0; i < ENGINE->numCameras; ++i)
+	{PRESENTED_CAMERAS[i] = ENGINE->cameras[i]->isEnabled;}
+	PRESENTED_PLAYER_POSITION = ENGINE->player.position;
 	// Gets the index of the cell pointed by the cross-hairs
-	int currentPointedCellIndex = GetPointedNonWallCellIndex(playerDirectionIntersection, P_DIR,
-			M_CELL_SIZE, M_SIZE);
-	if (MAP_STATUS[currentPointedCellIndex] == 2)
+	IS_PRESENTED_CELL_VISITED = IsMapCellVisited(&ENGINE->map, GetEnginePointedCellIndex(ENGINE));
+	PRESENTED_INPUT_TIME = FRAME_INPUT_TIME;
+	HAS_PRESENTED_FRAME = 1;
+}
+
+/**
+ * Draws the presented first-person frame: the camera views, the minimap and the crosshair.
+ */
+void SubmitFirstPersonView()
+{
+	DrawCameraFrameBuffers();
+	if (SHOW_MINIMAP)
+	{
+		int size = (int)(MINIMAP_OVERLAY_SIZE * (float)W_H);
+		SDL_Rect destination = {W_H / 50, W_H - size - W_H / 50, size, size};
+		DrawMinimap(&destination, PRESENTED_PLAYER_POSITION);
+	}
+	if (IS_PRESENTED_CELL_VISITED)
 	{SDL_SetRenderDrawColor(RENDERER, 225, 0, 0, SDL_ALPHA_OPAQUE);}
 	else
 	{SDL_SetRenderDrawColor(RENDERER, 0, 225, 0, SDL_ALPHA_OPAQUE);}
 	DrawCrosshair();
 }
 
+/**
+ * Renders the first-person view.
+ */
+void DrawFirstPersonView()
+{
+	RenderEngineFrame(ENGINE);
+	FinishFirstPersonFrame();
+	SubmitFirstPersonView();
+}
+
+/**
+ * Renders the shortest path from the player to the exit. The path is read from the goal distance field of the map, each
+ * cell leads to the neighbor one step closer to the exit.
+ */
+void DrawGoalHint()
+{
+	const Map* map = &ENGINE->map;
+	const int offsets[4] = {-map->size, map->size, -1, 1};
+	int cell = GetPlayerCellIndex(&ENGINE->player.position, map->cellSize, map->size);
+	if (map->goalDistances[cell] < 0)
+	{return;}
+	SDL_SetRenderDrawColor(RENDERER, 225, 225, 0, SDL_ALPHA_OPAQUE);
+	while (map->goalDistances[cell] > 0)
+	{
+		int i = 0;
+		while (i < 4 && map->goalDistances[cell + offsets[i]] != map->goalDistances[cell] - 1)
+		{++i;}
+		// A consistent field always has a neighbor one step closer, the hint stops where it does not
+		RCM_ASSERT(i < 4, UNKNOWN_ERROR);
+		if (i == 4)
+		{return;}
+		int next = cell + offsets[i];
+		SDL_RenderDrawLineF(RENDERER, ((float)(cell % map->size) + 0.5f) * map->cellSize,
+				((float)(cell / map->size) + 0.5f) * map->cellSize, ((float)(next % map->size) + 0.5f) * map->cellSize,
+				((float)(next / map->size) + 0.5f) * map->cellSize);
+		cell = next;
+	}
+}
+
 /**
  * Renders the top-down view.
  */
 void DrawTopDownView()
 {
+	// The top-down view shows the explored part of the maze at world scale, one unit per pixel
+	CastEngineRays(ENGINE, RAY_UNLIMITED_LENGTH);
+	UpdateMinimap();
+	int size = (int)((float)ENGINE->map.size * ENGINE->map.cellSize);
+	SDL_Rect destination = {0, 0, size, size};
+	DrawMinimap(&destination, ENGINE->player.position);
 	DrawRays();
 	DrawPlayerDirection();
+	if (SHOW_HINT)
+	{DrawGoalHint();}
 }
 
 /**
- * Renders top-down view or first-person view based on user input.
+ * Renders top-down view or first-person view based on user input. A pipelined first-person frame is not kept across
+ * the top-down view, the pipeline is filled again when the first-person view returns.
  */
 void Draw()
 {
 	ClearBackground();
-	DrawMapWallRectangles();
-	UpdatePlayerPosition(KEYBOARD_STATE, P_MOVE_FORWARD, P_MOVE_BACKWARD,
-			P_TURN_CW, P_TURN_CCW, P_POS, P_DIR,
-			P_STEP_SCALAR, P_RECT_SIZE, P_ABS_TURNING_ANGLE,
-			M_WALL_RECTS, M_WALL_RECTS_LENGTH);
 	if (SHOW_MAP)
-	{DrawTopDownView();}
+	{
+		DrawTopDownView();
+		HAS_PRESENTED_FRAME = 0;
+	}
 	else
 	{DrawFirstPersonView();}
 }
 
 /**
- * Updates the game status on whether the winning condition is achieved.
+ * Adds the time from sampling the input of the presented frame until now to the latency statistics, called once
+ * SDL_RenderPresent() returned. The session statistics only count first-person frames, the window title counts all.
+ *
+ * @param inputTime 	the performance counter when the input of the presented frame was sampled
+ * @param isFirstPerson 1 if the first-person view was presented, 0 for the top-down view
  */
-void UpdateGameStatus()
+void RecordPresentLatency(Uint64 inputTime, int isFirstPerson)
 {
-	if (GetPlayerCellIndex(P_POS, M_CELL_SIZE, M_SIZE) == M_SIZE * M_SIZE - M_SIZE - 2)
+	double latencyMs = (double)(SDL_GetPerformanceCounter() - inputTime) * 1000.0 /
+			(double)SDL_GetPerformanceFrequency();
+	if (isFirstPerson)
 	{
-		HAS_WON = 1;
+		TOTAL_PRESENT_LATENCY_MS += latencyMs;
+		++NUM_PRESENTED_FRAMES;
 	}
+	TITLE_LATENCY_MS += latencyMs;
+	++TITLE_NUM_PRESENTED;
 }
 
 /**
- * Renders the end state after the winning condition is achieved. The end state rotates the player slowly automatically.
+ * Adds the render time of a frame to the statistics of the window title and shows them every
+ * TITLE_UPDATE_INTERVAL_MS: the frames presented per second, the average render time and the average latency from
+ * sampling the input to presenting.
+ *
+ * @param renderMs the time spent rendering the frame, in milliseconds
  */
-void DrawEndState()
+void UpdateWindowTitle(double renderMs)
 {
-	Rotate3D(P_DIR, 0.01f);
-	ClearBackground();
-	DrawMapWallRectangles();
-	if (SHOW_MAP)
-	{
-		DrawTopDownView();
-	}
-	else
-	{
-		DrawFirstPersonView();
-	}
-	SDL_RenderPresent(RENDERER); // Updates buffer
+	TITLE_RENDER_MS += renderMs;
+	++TITLE_NUM_RENDERED;
+	double elapsedMs = (double)(SDL_GetPerformanceCounter() - TITLE_INTERVAL_START) * 1000.0 /
+			(double)SDL_GetPerformanceFrequency();
+	if (elapsedMs < TITLE_UPDATE_INTERVAL_MS || TITLE_NUM_PRESENTED == 0)
+	{return;}
+	char title[128];
+	snprintf(title, sizeof(title), "RayCastingMaze - %.0f fps, render %.1f ms, input to present %.1f ms%s",
+			(double)TITLE_NUM_PRESENTED * 1000.0 / elapsedMs, TITLE_RENDER_MS / TITLE_NUM_RENDERED,
+			TITLE_LATENCY_MS / TITLE_NUM_PRESENTED, RENDER_TASK != NULL ? " (pipelined)" : "");
+	SDL_SetWindowTitle(WINDOW, title);
+	TITLE_INTERVAL_START = SDL_GetPerformanceCounter();
+	TITLE_NUM_RENDERED = 0;
+	TITLE_RENDER_MS = 0.0;
+	TITLE_NUM_PRESENTED = 0;
+	TITLE_LATENCY_MS = 0.0;
+}
+
+/**
+ * Prints the number of first-person frames presented in the session, their rate and their average latency from
+ * sampling the input to presenting.
+ */
+void PrintFrameStatistics()
+{
+	if (NUM_PRESENTED_FRAMES == 0)
+	{return;}
+	double seconds = (double)(SDL_GetPerformanceCounter() - SESSION_START) / (double)SDL_GetPerformanceFrequency();
+	printf("Presented %d first-person frames, %.1f per second, average input to present latency %.2f ms (%s).\n",
+			NUM_PRESENTED_FRAMES, (double)NUM_PRESENTED_FRAMES / seconds,
+			TOTAL_PRESENT_LATENCY_MS / NUM_PRESENTED_FRAMES, RENDER_TASK != NULL ? "pipelined" : "sequential");
 }
 
 // ------------------------------------------ SDL RENDERING PIPELINE ------------------------------------------
 /**
- * Initializes SDL2 video system and creates SDL window and SDL renderer.
+ * Initializes SDL2 video system and creates SDL window and SDL renderer. Window size, internal resolution, ray count,
+ * field of view, step size and maze size are taken from the runtime configuration.
+ *
+ * @param config the runtime configuration
  */
-void Initialize()
+void Initialize(const Config* config)
 {
+	W_W = config->windowWidth;
+	W_H = config->windowHeight;
 	SDL_Init(SDL_INIT_VIDEO);
 	WINDOW = SDL_CreateWindow("RayCastingMaze",
 			SDL_WINDOWPOS_CENTERED,
@@ -225,14 +546,48 @@ void Initialize()
 			SDL_WINDOW_SHOWN);
 	RENDERER = SDL_CreateRenderer(WINDOW, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
 	KEYBOARD_STATE = SDL_GetKeyboardState(NULL);
-	// Initializes map
-	InitializeMap(&MAP_STATUS, &MAP, &M_SIZE, 23, &M_CELL_SIZE, 32.0f);
-	// Create rectangles representing walls
-	M_WALL_RECTS = CreateMapWallRects(&M_WALL_RECTS_LENGTH, M_CELL_SIZE, MAP, M_SIZE);
-	// Initializes player position vector, player always starts at the top-left cell in the maze
-	P_POS = Vec3D(M_CELL_SIZE + 1.0f, M_CELL_SIZE + 1.0f, 0.0f);
-	// Initializes player direction vector, direction vector is always a unit vector
-	P_DIR = Vec3D(1.0f, 0.0f, 0.0f);
+	// Uses one worker per additional logical core, the main thread takes part in the work as well
+	WORKER_POOL = CreateWorkerPool(SDL_GetCPUCount() - 1);
+	// Loads the wall textures
+	TEXTURE_ATLAS = LoadTextureAtlas(WALL_TEXTURE_PATHS, WALL_TEXTURE_COUNT);
+	// Creates the game instance
+	ENGINE = CreateEngine(config, TEXTURE_ATLAS, WORKER_POOL);
+	printf("Maze seed: %u\n", ENGINE->map.seed);
+	// Pipelined frames are rendered into one frame buffer of each camera while the other one is presented
+	if (config->pipelinedFrames)
+	{
+		EnableEngineDoubleBuffering(ENGINE);
+		RENDER_TASK = CreateAsyncTask();
+	}
+	// Records the input of every tick together with what else the game state depends on
+	if (config->recordPath[0] != '\0')
+	{
+		INPUT_LOG = CreateInputLog(ENGINE->map.seed, ENGINE->map.size, ENGINE->player.stepScalar,
+				ENGINE->player.fieldOfView, ENGINE->doorInterval);
+	}
+	// Adds the monitor camera, hidden until toggled
+	MONITOR_CAMERA = AddEngineCamera(ENGINE, MONITOR_VIEWPORT);
+	MONITOR_CAMERA->isEnabled = 0;
+	PlaceMonitorCamera();
+	AUTOPILOT = CreateAutopilot(ENGINE->map.size);
+	// Creates the textures the camera frame buffers are uploaded to, at their maximum internal resolution. Linear
+	// filtering smooths the upscaling to the viewport size.
+	SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+	for (int i = 0; i < ENGINE->numCameras; ++i)
+	{
+		CAMERA_TEXTURES[i] = SDL_CreateTexture(RENDERER, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+				ENGINE->cameras[i]->maxRays, ENGINE->cameras[i]->frameBuffer->height);
+	}
+	// Creates the minimap texture, drawn into as cells are revealed, which starts out black
+	MINIMAP_CELL_PIXELS = MINIMAP_MAX_SIZE / ENGINE->map.size > 1 ? MINIMAP_MAX_SIZE / ENGINE->map.size : 1;
+	MINIMAP_TEXTURE = SDL_CreateTexture(RENDERER, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+			ENGINE->map.size * MINIMAP_CELL_PIXELS, ENGINE->map.size * MINIMAP_CELL_PIXELS);
+	RedrawMinimap();
+	if (config->dynamicResolution)
+	{
+		DYNAMIC_RESOLUTION = CreateDynamicResolution((int)((float)ENGINE->maxRenderWidth * R_MIN_SCALE),
+				ENGINE->maxRenderWidth, R_STEP_W, config->frameBudgetMs);
+	}
 }
 
 /**
@@ -240,35 +595,58 @@ void Initialize()
  */
 void RunMainLoop()
 {
+	SESSION_START = SDL_GetPerformanceCounter();
+	TITLE_INTERVAL_START = SESSION_START;
 	while (IS_RUNNING)
 	{
-		// Event queue
-		SDL_Event event;
-		// Handles event
-		while (SDL_PollEvent(&event))
+		ProcessEvents();
+		if (!IS_RUNNING)
+		{break;}
+		// Moves the player and updates the winning flag, after the game is won the player turns slowly. The input is
+		// sampled as late as possible, right before the frame it drives is rendered. The autopilot produces the same
+		// input as the arrow keys, so it is recorded and replayed like a human player.
+		PlayerInput input = SamplePlayerInput();
+		Uint64 frameStart = SDL_GetPerformanceCounter();
+		FRAME_INPUT_TIME = frameStart;
+		if (IS_AUTOPILOT_ON)
+		{input = SteerAutopilot(AUTOPILOT, &ENGINE->map, &ENGINE->player);}
+		if (INPUT_LOG != NULL)
+		{RecordInput(INPUT_LOG, &input);}
+		UpdateEngine(ENGINE, &input);
+		MONITOR_CAMERA->direction = V3Rotate(MONITOR_CAMERA->direction, MONITOR_SWEEP_ANGLE);
+		double frameMs;
+		if (RENDER_TASK != NULL && !SHOW_MAP)
 		{
-			// clicks on Close or presses ESCAPE to quit
-			if (event.type == SDL_QUIT || event.key.keysym.scancode == SDL_SCANCODE_ESCAPE)
-			{IS_RUNNING = !IS_RUNNING;}
-			// presses SPACE to render top-down map
-			if (event.type == SDL_KEYDOWN)
+			// Renders this frame on the render thread while the previous one is submitted and presented, the game
+			// state is not touched until the render thread is done. Right after the top-down view there is no
+			// previous frame, this frame is then only rendered and presented in the next iteration.
+			StartAsyncTask(RENDER_TASK, RenderFrameTask, ENGINE);
+			if (HAS_PRESENTED_FRAME)
 			{
-				if (event.key.keysym.scancode == SDL_SCANCODE_SPACE)
-				{SHOW_MAP = !SHOW_MAP;}
+				ClearBackground();
+				SubmitFirstPersonView();
+				SDL_RenderPresent(RENDERER);
+				RecordPresentLatency(PRESENTED_INPUT_TIME, 1);
 			}
+			// The render time alone is compared to the budget, it overlaps the submission and the wait for vsync
+			frameMs = WaitAsyncTask(RENDER_TASK);
+			SwapEngineFrameBuffers(ENGINE);
+			FinishFirstPersonFrame();
 		}
-		// Checks winning status
-		if (HAS_WON)
+		else
 		{
-			DrawEndState();
-			continue;
+			// Draw
+			Draw();
+			// Adjusts the internal render width to the time spent rendering, excluding the wait for vsync
+			frameMs = (double)(SDL_GetPerformanceCounter() - frameStart) * 1000.0 /
+					(double)SDL_GetPerformanceFrequency();
+			// Updates buffer
+			SDL_RenderPresent(RENDERER);
+			RecordPresentLatency(FRAME_INPUT_TIME, !SHOW_MAP);
 		}
-		// Update wining flag
-		UpdateGameStatus();
-		// Draw
-		Draw();
-		// Updates buffer
-		SDL_RenderPresent(RENDERER);
+		UpdateWindowTitle(frameMs);
+		if (DYNAMIC_RESOLUTION != NULL && !ENGINE->hasWon)
+		{SetEngineRenderWidth(ENGINE, UpdateDynamicResolution(DYNAMIC_RESOLUTION, frameMs));}
 	}
 }
 
@@ -277,30 +655,48 @@ void RunMainLoop()
  */
 void CleanUp()
 {
-	if (P_POS != NULL)
-	{free(P_POS);} 					// frees player position vector
-	if (P_DIR != NULL)
-	{free(P_DIR);} 					// frees player direction vector
-	if (P_RAYS != NULL)
-	{free(P_RAYS);} 				// frees the ray array representing rays cast by players
-	if (MAP != NULL)
-	{free(MAP);}					// frees the map array
-	if (MAP_STATUS != NULL)
-	{free(MAP_STATUS);}				// frees the map status array
-	if (M_WALL_RECTS != NULL)
-	{free(M_WALL_RECTS);} 			// frees rectangle array representing walls
+	if (INPUT_LOG != NULL)
+	{
+		if (!SaveInputLog(INPUT_LOG, CONFIG.recordPath))
+		{printf("Input log could not be written to %s.\n", CONFIG.recordPath);}
+		DestroyInputLog(INPUT_LOG); // frees the recorded input
+	}
+	if (IS_MOUSE_LOOK_ON)
+	{SetMouseLook(0);}				// releases the mouse
+	if (RENDER_TASK != NULL)
+	{DestroyAsyncTask(RENDER_TASK);} // stops the render thread
+	if (AUTOPILOT != NULL)
+	{DestroyAutopilot(AUTOPILOT);} // frees the path finder
+	if (ENGINE != NULL)
+	{DestroyEngine(ENGINE);} 		// frees the map and the cameras
+	if (TEXTURE_ATLAS != NULL)
+	{DestroyTextureAtlas(TEXTURE_ATLAS);} // frees the wall textures
+	if (DYNAMIC_RESOLUTION != NULL)
+	{DestroyDynamicResolution(DYNAMIC_RESOLUTION);} // frees the dynamic resolution controller
+	if (WORKER_POOL != NULL)
+	{DestroyWorkerPool(WORKER_POOL);} // stops the worker threads
+	for (int i = 0; i < ENGINE_MAX_CAMERAS; ++i)
+	{
+		if (CAMERA_TEXTURES[i] != NULL)
+		{SDL_DestroyTexture(CAMERA_TEXTURES[i]);} // frees the camera frame buffer textures
+	}
+	if (MINIMAP_TEXTURE != NULL)
+	{SDL_DestroyTexture(MINIMAP_TEXTURE);} // frees the explored maze texture
 	SDL_DestroyWindow(WINDOW); 		// free SDL window
 	SDL_DestroyRenderer(RENDERER); 	// free SDL renderer
 	SDL_Quit();						// quits
 }
 
-int main()
+int main(int argc, char* argv[])
 {
+	// Configuration
+	LoadConfig(&CONFIG, argc, argv);
 	// Initialization
-	Initialize();
+	Initialize(&CONFIG);
 	// Main loop
 	RunMainLoop();
+	PrintFrameStatistics();
 	// Clean up
 	CleanUp();
 	return 0;
-}
\ No newline at end of file
+}